@@ -0,0 +1,104 @@
+/**
+ * @file generate_mesh.cc
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Synthetic mesh generator for the scaling tests of the Bunny Mesh Normals project.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "bunny_mesh/data_io.h"
+#include "bunny_mesh/Generator.h"
+#include "bunny_mesh/parallel.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// Base mesh of the subdivided bunny: input faces file path
+const std::string facesFilePath = "data/bunny_faces.npy";
+// Base mesh of the subdivided bunny: input vertices file path
+const std::string verticesFilePath = "data/bunny_vertices.npy";
+
+/**
+ * @brief Usage of the generator.
+ */
+void help()
+{
+    std::cout
+    << "\n"
+    << "This program writes a synthetic mesh of about the requested number of faces as two numpy files.\n"
+    << "Usage:\n"
+    << "\t <icosphere|terrain|bunny> <number of faces> <output vertices .npy> <output faces .npy> [threads]\n"
+    << "Meshes:\n"
+    << "\t - icosphere: geodesic sphere, 20 * n^2 faces\n"
+    << "\t - terrain: fractal value noise height field, 2 * n^2 faces\n"
+    << "\t - bunny: Loop subdivided '" << verticesFilePath << "', 4^levels times its faces\n"
+    << std::endl;
+}
+
+/**
+ * @brief Main function of the generate_mesh tool
+ */
+int main(int argc, char **argv)
+{
+    if (argc != 5 && argc != 6)
+    {
+        help();
+        return EXIT_FAILURE;
+    }
+    typedef std::chrono::steady_clock Clock;
+    auto seconds = [](Clock::time_point begin) { return std::chrono::duration<double>(Clock::now() - begin).count(); };
+    try
+    {
+        const std::string kind = argv[1];
+        const size_t numFaces = std::stoull(argv[2]);
+        if (argc == 6)
+        {
+            bunny_mesh::parallel::setNumThreads(std::stoi(argv[5]));
+        }
+
+        Clock::time_point begin = Clock::now();
+        std::unique_ptr<bunny_mesh::synthetic::MeshGenerator> generator;
+        if (kind == "icosphere")
+        {
+            const int frequency = bunny_mesh::synthetic::IcosphereGenerator::frequencyForFaces(numFaces);
+            generator.reset(new bunny_mesh::synthetic::IcosphereGenerator(frequency));
+        }
+        else if (kind == "terrain")
+        {
+            generator.reset(
+                new bunny_mesh::synthetic::TerrainGenerator(bunny_mesh::synthetic::TerrainGenerator::withFaces(numFaces)));
+        }
+        else if (kind == "bunny")
+        {
+            const bunny_dataIO::IndexMatrixType faces = bunny_dataIO::readIntNumPyArray(facesFilePath);
+            const bunny_dataIO::Point3DMatrixType vertices = bunny_dataIO::readFloatNumPyArray(verticesFilePath);
+            const int levels = bunny_mesh::synthetic::LoopSubdivisionGenerator::levelsForFaces(faces.rows(), numFaces);
+            generator.reset(new bunny_mesh::synthetic::LoopSubdivisionGenerator(vertices, faces, levels));
+        }
+        else
+        {
+            help();
+            return EXIT_FAILURE;
+        }
+        const double setupTime = seconds(begin);
+
+        begin = Clock::now();
+        bunny_mesh::synthetic::writeNumpy(*generator, argv[3], argv[4]);
+        const double writeTime = seconds(begin);
+        const double bytes = 24.0 * generator->numVertices() + 12.0 * generator->numFaces();
+        std::printf("%s: %zu faces, %zu vertices, setup %.3f s, generated and written in %.3f s (%.0f MB/s, %u threads)\n",
+                    kind.c_str(), generator->numFaces(), generator->numVertices(), setupTime, writeTime,
+                    bytes / writeTime / 1e6, bunny_mesh::parallel::numThreads());
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -9,10 +9,21 @@
  * 
  */
 #include "bunny_mesh/data_io.h"
+#include "bunny_mesh/MemoryBudget.h"
 #include "bunny_mesh/Mesh.h"
+#include "bunny_mesh/MeshSequence.h"
+#include "bunny_mesh/NormalsService.h"
+#include "bunny_mesh/mesh_io.h"
+#include "bunny_mesh/parallel.h"
+#include "bunny_mesh/Partition.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <iostream>
 #include <string>
+#include <vector>
 
 // Input faces file path
 const std::string facesFilePath = "data/bunny_faces.npy";
@@ -37,15 +48,227 @@ void help()
     << "Output files are written to:\n"
     << "\t - '" << normFacesFilePath     << "'\n"
     << "\t - '" << normVerticesFilePath  << "'\n"
+    << "Run as a normals service, keeping meshes resident, with:\n"
+    << "\t --daemon <unix socket path>\n"
+    << "Compute the normals of a PLY, STL or OBJ mesh and write them with the mesh with:\n"
+    << "\t <input mesh path> <output mesh path>\n"
+    << "Report the strong scaling of the partitioned normals, one process per partition, with:\n"
+    << "\t --partitions <max processes> <input mesh path>\n"
+    << "Compute the normals within a peak memory budget, from the files above or the given ones, with:\n"
+    << "\t --memory-budget <megabytes> [<faces.npy> <vertices.npy> <face normals.npy> <vertex normals.npy>]\n"
+    << "Compute the normals of every frame of an animation, vertices of shape (frames, vertices, 3), with:\n"
+    << "\t --sequence <faces.npy> <frames.npy> <face normals.npy> <vertex normals.npy>\n"
     << std::endl;
 }
 
+/**
+ * @brief Serves normals requests on a Unix domain socket until a shutdown request.
+ */
+int runDaemon(const std::string &socketPath)
+{
+    try
+    {
+        bunny_mesh::service::NormalsServer server(socketPath);
+        std::cout << "Serving normals on '" << socketPath << "'" << std::endl;
+        server.run();
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Reads a mesh file, computes its normals and writes them with the mesh, in the format of the output extension.
+ */
+int runMeshFiles(const std::string &inputPath, const std::string &outputPath)
+{
+    try
+    {
+        bunny_dataIO::MeshData data = bunny_dataIO::readMesh(inputPath);
+        bunny_mesh::TriangleMesh mesh(data.vertices, data.faces);
+        mesh.ComputeNormals();
+        bunny_dataIO::writeMesh(outputPath, data.vertices, data.faces, mesh.getVerticeNormals(), mesh.getFaceNormals());
+        std::cout << "Normals of '" << inputPath << "' written to '" << outputPath << "'" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Times the partitioned normals of a mesh for 1, 2, 4, ... up to maxProcesses processes of one thread each.
+ */
+int runPartitionScaling(const std::string &maxProcesses, const std::string &inputPath)
+{
+    typedef std::chrono::steady_clock Clock;
+    auto seconds = [](Clock::time_point begin) { return std::chrono::duration<double>(Clock::now() - begin).count(); };
+    try
+    {
+        const int maxRanks = std::stoi(maxProcesses);
+        bunny_dataIO::MeshData data = bunny_dataIO::readMesh(inputPath);
+        bunny_mesh::parallel::setNumThreads(1);
+        bunny_mesh::TriangleMesh mesh(data.vertices, data.faces);
+        Clock::time_point begin = Clock::now();
+        mesh.ComputeNormals();
+        std::printf("%ld faces, %ld vertices, single process ComputeNormals(): %.4f s\n",
+                    static_cast<long>(data.faces.rows()), static_cast<long>(data.vertices.rows()), seconds(begin));
+        std::printf("%9s %14s %12s %8s %10s %13s %13s\n", "processes", "partition (s)", "normals (s)", "speedup",
+                    "efficiency", "halo vertices", "max deviation");
+
+        std::vector<int> counts;
+        for (int ranks = 1; ranks < maxRanks; ranks *= 2)
+        {
+            counts.push_back(ranks);
+        }
+        counts.push_back(std::max(maxRanks, 1));
+        double reference = 0.0;
+        for (int ranks : counts)
+        {
+            begin = Clock::now();
+            std::vector<bunny_mesh::distributed::MeshPartition> partitions =
+                bunny_mesh::distributed::partitionMesh(data.vertices, data.faces, ranks);
+            const double partitionTime = seconds(begin);
+
+            // best of three runs, forks included
+            bunny_dataIO::Point3DMatrixType faceNormals, verticesNormals;
+            double normalsTime = INFINITY;
+            for (int run = 0; run < 3; run++)
+            {
+                begin = Clock::now();
+                bunny_mesh::distributed::computePartitionedNormals(partitions, data.vertices.rows(), data.faces.rows(),
+                                                                   faceNormals, verticesNormals);
+                normalsTime = std::min(normalsTime, seconds(begin));
+            }
+            if (ranks == 1)
+            {
+                reference = normalsTime;
+            }
+
+            size_t halo = 0;
+            for (const bunny_mesh::distributed::MeshPartition &partition : partitions)
+            {
+                for (const bunny_mesh::distributed::HaloLink &link : partition.boundary)
+                {
+                    halo += link.vertices.size();
+                }
+            }
+            // unreferenced vertices are not a number in both results
+            double deviation = (verticesNormals - mesh.getVerticeNormals()).array().isNaN().select(
+                0.0, (verticesNormals - mesh.getVerticeNormals()).array().abs()).maxCoeff();
+            std::printf("%9d %14.4f %12.4f %8.2f %9.0f%% %13zu %13.2e\n", ranks, partitionTime, normalsTime,
+                        reference / normalsTime, 100.0 * reference / normalsTime / ranks, halo, deviation);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Computes the normals of numpy files with the fastest strategy whose predicted peak memory fits the budget,
+ * and reports the memory of its stages with the predicted and actual peak resident set size.
+ */
+int runMemoryBudget(const std::string &megabytes, const std::vector<std::string> &paths)
+{
+    namespace memory = bunny_mesh::memory;
+    const double megabyte = 1024.0 * 1024.0;
+    try
+    {
+        const size_t budget = static_cast<size_t>(std::stod(megabytes) * megabyte);
+        const size_t baseline = memory::residentBytes();
+        size_t num_faces = 0, num_vertices = 0;
+        {
+            bunny_dataIO::NumpyArrayReader faces(paths[0]), vertices(paths[1]);
+            num_faces = faces.rows();
+            num_vertices = vertices.rows();
+        }
+        const memory::MemoryStrategy strategy = memory::chooseStrategy(budget, baseline, num_vertices, num_faces);
+        const size_t predicted = baseline + memory::predictPeakBytes(strategy, num_vertices, num_faces);
+
+        memory::MemoryAccounting accounting;
+        memory::computeNormalsFiles(strategy, paths[0], paths[1], paths[2], paths[3], accounting);
+        accounting.print(std::cout);
+        const size_t actual = accounting.peakResident();
+        std::printf("%zu faces, %zu vertices, %.1f MB budget: %s strategy, peak resident predicted %.1f MB, "
+                    "actual %.1f MB\n",
+                    num_faces, num_vertices, budget / megabyte, memory::strategyName(strategy), predicted / megabyte,
+                    actual / megabyte);
+        if (actual > budget)
+        {
+            std::cerr << "Peak resident set size over the budget" << std::endl;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Computes the normals of every frame of an animation, and reports the frames per second.
+ */
+int runSequence(const std::vector<std::string> &paths)
+{
+    try
+    {
+        const bunny_mesh::SequenceStats stats =
+            bunny_mesh::computeSequenceFiles(paths[0], paths[1], paths[2], paths[3]);
+        std::printf("%zu frames, %zu in flight, %.4f s: %.1f frames per second\n", stats.frames,
+                    stats.frames_in_flight, stats.seconds, stats.fps());
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
 /**
  * @brief Main function of bunny_mesh_normals project
  */
-int main()
+int main(int argc, char **argv)
 {
     help();
+    if (argc == 3 && std::string(argv[1]) == "--daemon")
+    {
+        return runDaemon(argv[2]);
+    }
+    if (argc == 4 && std::string(argv[1]) == "--partitions")
+    {
+        return runPartitionScaling(argv[2], argv[3]);
+    }
+    if ((argc == 3 || argc == 7) && std::string(argv[1]) == "--memory-budget")
+    {
+        std::vector<std::string> paths = {facesFilePath, verticesFilePath, normFacesFilePath, normVerticesFilePath};
+        if (argc == 7)
+        {
+            paths.assign(argv + 3, argv + 7);
+        }
+        return runMemoryBudget(argv[2], paths);
+    }
+    if (argc == 6 && std::string(argv[1]) == "--sequence")
+    {
+        return runSequence(std::vector<std::string>(argv + 2, argv + 6));
+    }
+    if (argc == 3)
+    {
+        return runMeshFiles(argv[1], argv[2]);
+    }
+    // Memory of each stage, reported at the end
+    bunny_mesh::memory::MemoryAccounting accounting;
+
     // Loads Bunny data into Eigen matrices
     bunny_dataIO::IndexMatrixType faces;    // integer type matrix
     bunny_dataIO::Point3DMatrixType vertices; // floating point type matrix
@@ -53,8 +276,10 @@ int main()
     {
         // Read Faces Matrix
         faces = bunny_dataIO::readIntNumPyArray(facesFilePath);
+        accounting.record("read faces");
         // Read vertices matrix
         vertices = bunny_dataIO::readFloatNumPyArray(verticesFilePath);
+        accounting.record("read vertices");
     }
     catch (const std::exception &e)
     {
@@ -68,6 +293,7 @@ int main()
 
     // Create a bunny mesh object based on vertices and faces information
     bunny_mesh::TriangleMesh bunnyMesh(vertices, faces);
+    accounting.record("copy into the mesh");
 
     // its possible to set an arbitrary orientation to bunnyMesh.
     // the default orientation is z = (0,0,1)
@@ -76,6 +302,7 @@ int main()
 
     // Compute normalized face normals and normalized vertices normals
     bunnyMesh.ComputeNormals();
+    accounting.record("normals");
 
     // Get faces normal
     bunny_dataIO::Point3DMatrixType face_normals = bunnyMesh.getFaceNormals();
@@ -86,12 +313,15 @@ int main()
     bunny_dataIO::Point3DMatrixType verices_normals = bunnyMesh.getVerticeNormals();
     // take a look...
     // bunny_dataIO::printArray(verices_normals);
+    accounting.record("copy out the normals");
 
     // Save matrices as numpy arrays
     bunny_dataIO::saveMatrixToNumpyArray(normFacesFilePath, face_normals);
     bunny_dataIO::saveMatrixToNumpyArray(normVerticesFilePath, verices_normals);
+    accounting.record("write normals");
 
     std::cout << "Normalized normals matrices written with success." << std::endl;
+    accounting.print(std::cout);
 
     return EXIT_SUCCESS;
 }
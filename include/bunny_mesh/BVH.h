@@ -0,0 +1,163 @@
+/**
+ * @file BVH.h
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Bounding volume hierarchy over the faces of a triangle mesh, used for closest point and ray queries.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#ifndef _BUNNY_MESH_BVH_
+#define _BUNNY_MESH_BVH_
+
+#include "data_io.h"
+#include "Mesh.h"
+
+#include <Eigen/Dense>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace bunny_mesh
+{
+/**
+ * @brief Result of a BVH query.
+ *
+ * The normal is the vertex normals interpolated with the barycentric weights, so it is smooth across faces.
+ */
+struct MeshHit
+{
+  // Index of the face hit, -1 if the query did not hit anything
+  int face = -1;
+
+  // Closest point queries: euclidean distance to the point. Ray queries: ray parameter t.
+  double distance = std::numeric_limits<double>::infinity();
+
+  // Position of the hit in world coordinates
+  bunny_dataIO::Point3DType point = bunny_dataIO::Point3DType::Zero();
+
+  // Barycentric weights of the face vertices (v0, v1, v2)
+  bunny_dataIO::Point3DType barycentric = bunny_dataIO::Point3DType::Zero();
+
+  // Normalized interpolated vertex normal
+  bunny_dataIO::Point3DType normal = bunny_dataIO::Point3DType::Zero();
+
+  inline bool valid() const { return face >= 0; }
+};
+
+/**
+ * @brief Bounding volume hierarchy built with the surface area heuristic (SAH) over the faces of a mesh.
+ *
+ * Nodes are stored flattened in depth-first order: the left child of an interior node is the next node in the array
+ * and the right child is given by its offset, so a traversal walks mostly forward in memory.
+ * Each node is 32 bytes, two nodes per cache line. Triangles are stored in leaf order next to each other.
+ *
+ * The hierarchy is built from the world coordinates of the mesh (the same frame as the normals of
+ * TriangleMesh::ComputeNormals()), so the normals must have been computed before building it from a mesh.
+ *
+ * References:
+ *  - Wald, "On fast Construction of SAH-based Bounding Volume Hierarchies", 2007.
+ *  - Ericson, "Real-Time Collision Detection", section 5.1.5.
+ *  - Möller and Trumbore, "Fast, Minimum Storage Ray/Triangle Intersection", 1997.
+ */
+class MeshBVH
+{
+public:
+  /**
+   * @brief Flattened BVH node.
+   *
+   * Interior nodes have count == 0 and offset is the index of the right child.
+   * Leaves have count > 0 and offset is the index of their first triangle.
+   */
+  struct Node
+  {
+    float bounds_min[3];
+    uint32_t offset;
+    float bounds_max[3];
+    uint32_t count;
+  };
+
+  /**
+   * @brief Build the hierarchy over a mesh whose normals were already computed.
+   *
+   * @param mesh : triangle mesh after TriangleMesh::ComputeNormals().
+   */
+  explicit MeshBVH(TriangleMesh &mesh);
+
+  /**
+   * @brief Build the hierarchy over raw mesh arrays.
+   *
+   * @param vertices : vertices in world coordinates, size (num_vertices, 3).
+   * @param faces : faces vertices indexes, size (num_faces, 3).
+   * @param vertexNormals : normalized vertex normals, size (num_vertices, 3).
+   */
+  MeshBVH(const bunny_dataIO::Point3DMatrixType &vertices, const bunny_dataIO::IndexMatrixType &faces,
+          const bunny_dataIO::Point3DMatrixType &vertexNormals);
+
+  /**
+   * @brief Find the closest face to a point.
+   */
+  MeshHit closestPoint(const bunny_dataIO::Point3DType &point) const;
+
+  /**
+   * @brief Find the first face hit by a ray. Both face sides are hit.
+   *
+   * @param origin : ray origin.
+   * @param direction : ray direction, need not be normalized.
+   * @param tMax : maximal ray parameter.
+   */
+  MeshHit intersect(const bunny_dataIO::Point3DType &origin, const bunny_dataIO::Point3DType &direction,
+                    double tMax = std::numeric_limits<double>::infinity()) const;
+
+  /**
+   * @brief Closest point query for each row of points, run in parallel.
+   */
+  std::vector<MeshHit> closestPoints(const bunny_dataIO::Point3DMatrixType &points) const;
+
+  /**
+   * @brief Ray query for each pair of rows of origins and directions, run in parallel.
+   */
+  std::vector<MeshHit> intersectRays(const bunny_dataIO::Point3DMatrixType &origins,
+                                     const bunny_dataIO::Point3DMatrixType &directions) const;
+
+  /**
+   * @brief Get the flattened nodes of the hierarchy, the root is the first one.
+   */
+  inline const std::vector<Node> &getNodes() const { return this->nodes; }
+
+  /**
+   * @brief Number of faces indexed by the hierarchy.
+   */
+  inline size_t numFaces() const { return this->triangles.size(); }
+
+private:
+  // Triangle stored in leaf order
+  struct Triangle
+  {
+    Eigen::Vector3d v0;
+    Eigen::Vector3d v1;
+    Eigen::Vector3d v2;
+    int face;
+  };
+
+  void build(const bunny_dataIO::Point3DMatrixType &vertices);
+
+  // fills the point and normal of a hit given its face and barycentric weights
+  void completeHit(MeshHit &hit) const;
+
+  // Flattened nodes in depth-first order
+  std::vector<Node> nodes;
+
+  // Triangles in leaf order
+  std::vector<Triangle> triangles;
+
+  // Faces of the mesh, used to interpolate vertex normals
+  bunny_dataIO::IndexMatrixType faces;
+
+  // Normalized vertex normals of the mesh
+  bunny_dataIO::Point3DMatrixType vertex_normals;
+};
+} // namespace bunny_mesh
+
+#endif // _BUNNY_MESH_BVH_
@@ -0,0 +1,203 @@
+/**
+ * @file Generator.h
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Parametric synthetic meshes, from a thousand to a billion faces, generated and written by blocks of rows.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#ifndef _BUNNY_MESH_GENERATOR_
+#define _BUNNY_MESH_GENERATOR_
+
+#include "data_io.h"
+#include "Topology.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bunny_mesh
+{
+namespace synthetic
+{
+/**
+ * @brief Mesh whose vertices and faces are computed on demand, by ranges of rows.
+ *
+ * Every row only depends on its index, so ranges are generated in any order and from several threads at once,
+ * and a mesh never needs to be held whole: writeNumpy() streams it to the disk by blocks.
+ */
+class MeshGenerator
+{
+public:
+  virtual ~MeshGenerator() {}
+
+  virtual size_t numVertices() const = 0;
+  virtual size_t numFaces() const = 0;
+
+  /**
+   * @brief Compute the vertices [begin, end), thread safe.
+   *
+   * @param out : row major output, 3 * (end - begin) doubles.
+   */
+  virtual void vertices(size_t begin, size_t end, double *out) const = 0;
+
+  /**
+   * @brief Compute the faces [begin, end), counter clockwise seen from outside, thread safe.
+   *
+   * @param out : row major output, 3 * (end - begin) vertex indexes.
+   */
+  virtual void faces(size_t begin, size_t end, int *out) const = 0;
+};
+
+/**
+ * @brief Geodesic sphere: each face of an icosahedron split in frequency^2 triangles, projected on the sphere.
+ *
+ * A frequency 2^k gives the usual k times subdivided icosphere; any frequency is allowed, so that the number of
+ * faces, 20 * frequency^2, follows a requested size closely. Vertices are numbered corners first, then the points
+ * inside the icosahedron edges, then the points inside its faces, and each is computed from its own lattice
+ * coordinates only, so shared vertices are bitwise identical whatever face reaches them.
+ */
+class IcosphereGenerator : public MeshGenerator
+{
+public:
+  /**
+   * @param frequency : number of segments each icosahedron edge is split in, at least one.
+   * @param radius : sphere radius.
+   */
+  explicit IcosphereGenerator(int frequency, double radius = 1.0);
+
+  /**
+   * @brief Frequency whose number of faces is the closest to a target.
+   */
+  static int frequencyForFaces(size_t numFaces);
+
+  size_t numVertices() const override;
+  size_t numFaces() const override;
+  void vertices(size_t begin, size_t end, double *out) const override;
+  void faces(size_t begin, size_t end, int *out) const override;
+
+private:
+  // Global index of the lattice point (i, j) of an icosahedron face, weights (n - i - j, i, j) of its corners
+  int latticeVertex(int face, int i, int j) const;
+
+  int frequency;
+  double radius;
+  // Icosahedron edges, lowest corner first
+  int edges[30][2];
+  // Edges of each icosahedron face, edge k joins corners k and k + 1, and whether it goes the other way
+  int faceEdges[20][3];
+  bool faceEdgeReversed[20][3];
+};
+
+/**
+ * @brief Height field over a (columns, rows) grid of square cells, two triangles per cell.
+ *
+ * The grid spans 1 along its longest side in x and y, and heights are a fractal sum of value noise octaves:
+ * lattice values hashed from their integer coordinates and the seed, interpolated with a smoothstep, the first
+ * octave 4 lattice cells across the grid, each next one twice finer and half as high.
+ */
+class TerrainGenerator : public MeshGenerator
+{
+public:
+  /**
+   * @param columns : number of cells along x, at least one.
+   * @param rows : number of cells along y, at least one.
+   * @param amplitude : height of the first octave.
+   * @param octaves : number of noise octaves.
+   * @param seed : noise seed, the same seed gives the same terrain.
+   */
+  TerrainGenerator(size_t columns, size_t rows, double amplitude = 0.1, int octaves = 8, uint32_t seed = 0);
+
+  /**
+   * @brief Square grid whose number of faces is the closest to a target.
+   */
+  static TerrainGenerator withFaces(size_t numFaces, double amplitude = 0.1, int octaves = 8, uint32_t seed = 0);
+
+  size_t numVertices() const override;
+  size_t numFaces() const override;
+  void vertices(size_t begin, size_t end, double *out) const override;
+  void faces(size_t begin, size_t end, int *out) const override;
+
+  /**
+   * @brief Terrain height at a point of the grid plane.
+   */
+  double height(double x, double y) const;
+
+private:
+  size_t columns;
+  size_t rows;
+  double spacing;
+  double amplitude;
+  int octaves;
+  uint32_t seed;
+};
+
+/**
+ * @brief Loop subdivision of a base mesh, levels times: each level splits every face in 4.
+ *
+ * The edge table of the base mesh is hashed once, the levels before the last are subdivided in memory with their
+ * topology derived from the level above, and the last one is generated on demand by subdivideVertices() and
+ * subdivideFaces() from the level before it, about a quarter of the output. Open and non manifold meshes such as
+ * the bunny subdivide without holes, their borders following the crease rules of SubdivisionScheme::Loop.
+ */
+class LoopSubdivisionGenerator : public MeshGenerator
+{
+public:
+  /**
+   * @param vertices : base mesh vertices, size (num_vertices, 3).
+   * @param faces : base mesh faces vertices indexes, size (num_faces, 3).
+   * @param levels : number of subdivisions, at least one.
+   */
+  LoopSubdivisionGenerator(const bunny_dataIO::Point3DMatrixType &vertices,
+                           const bunny_dataIO::IndexMatrixType &faces, int levels);
+
+  /**
+   * @brief Number of levels whose number of faces is the closest to a target, at least one.
+   */
+  static int levelsForFaces(size_t baseFaces, size_t numFaces);
+
+  size_t numVertices() const override;
+  size_t numFaces() const override;
+  void vertices(size_t begin, size_t end, double *out) const override;
+  void faces(size_t begin, size_t end, int *out) const override;
+
+private:
+  // Level before the last
+  bunny_dataIO::Point3DMatrixType coarseVertices;
+  bunny_dataIO::IndexMatrixType coarseFaces;
+  // Topology of the level before the last
+  EdgeTable edges;
+  VertexFaceAdjacency adjacency;
+};
+
+/**
+ * @brief Generate a whole mesh in memory, in parallel.
+ *
+ * @param generator : mesh generator.
+ * @param vertices : output vertices, size (num_vertices, 3).
+ * @param faces : output faces, size (num_faces, 3).
+ */
+void generateMesh(const MeshGenerator &generator, bunny_dataIO::Point3DMatrixType &vertices,
+                  bunny_dataIO::IndexMatrixType &faces);
+
+/**
+ * @brief Stream a mesh to a vertices and a faces numpy file, generating and writing blocks of rows in parallel.
+ *
+ * Each thread generates its blocks into its own buffer and writes them at their offset in the files, so the memory
+ * used is numThreads() blocks whatever the mesh size. Files are read back by readFloatNumPyArray() and
+ * readIntNumPyArray().
+ *
+ * @param generator : mesh generator.
+ * @param verticesFile : output vertices numpy file, float64, shape (num_vertices, 3).
+ * @param facesFile : output faces numpy file, int32, shape (num_faces, 3).
+ * @param blockRows : number of rows generated and written at once.
+ */
+void writeNumpy(const MeshGenerator &generator, const std::string &verticesFile, const std::string &facesFile,
+                size_t blockRows = 1 << 16);
+
+} // namespace synthetic
+} // namespace bunny_mesh
+
+#endif // _BUNNY_MESH_GENERATOR_
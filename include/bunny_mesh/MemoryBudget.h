@@ -0,0 +1,172 @@
+/**
+ * @file MemoryBudget.h
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Memory accounting of the normals pipeline, and lower memory strategies chosen to fit a peak memory budget.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#ifndef _BUNNY_MESH_MEMORY_BUDGET_
+#define _BUNNY_MESH_MEMORY_BUDGET_
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace bunny_mesh
+{
+namespace memory
+{
+/**
+ * @brief Resident set size of the process in bytes, 0 where /proc/self/status is not available.
+ */
+size_t residentBytes();
+
+/**
+ * @brief Peak resident set size of the process in bytes, since its start or the last resetPeakResident().
+ */
+size_t peakResidentBytes();
+
+/**
+ * @brief Restart the peak resident set size from the current one, through /proc/self/clear_refs.
+ *
+ * @return bool : false where the peak cannot be reset, it then keeps counting from the start of the process.
+ */
+bool resetPeakResident();
+
+/**
+ * @brief Heap bytes in use, allocated by malloc and not freed yet, 0 where the C library does not tell.
+ */
+size_t heapBytes();
+
+/**
+ * @brief Memory of one stage of a pipeline.
+ */
+struct StageMemory
+{
+  std::string name;
+
+  // Heap bytes allocated by the stage and still in use at its end, negative when it frees more than it allocates
+  int64_t heap_change;
+
+  // Heap bytes in use at the end of the stage
+  size_t heap;
+
+  // Resident set size at the end of the stage
+  size_t resident;
+
+  // Peak resident set size during the stage, buffers allocated and freed within the stage included
+  size_t peak_resident;
+};
+
+/**
+ * @brief Memory used per stage of a pipeline: the first stage starts with the accounting, each record() ends the
+ * current stage and starts the next one.
+ *
+ * Usage:
+ *      MemoryAccounting accounting;
+ *      faces = readIntNumPyArray(facesFile);
+ *      accounting.record("read faces");
+ *      ...
+ *      accounting.print(std::cout);
+ */
+class MemoryAccounting
+{
+public:
+  MemoryAccounting();
+
+  /**
+   * @brief End the current stage.
+   *
+   * @param stage : name of the stage.
+   */
+  void record(const std::string &stage);
+
+  inline const std::vector<StageMemory> &stages() const { return stageList; }
+
+  /**
+   * @brief Peak resident set size over all the stages, 0 when nothing was recorded.
+   */
+  size_t peakResident() const;
+
+  /**
+   * @brief Print a table of the stages, in megabytes.
+   */
+  void print(std::ostream &out) const;
+
+private:
+  std::vector<StageMemory> stageList;
+  size_t stageHeap;
+};
+
+/**
+ * @brief Ways of running the numpy files normals pipeline, from the fastest to the smallest.
+ *
+ * Each strategy keeps the savings of the previous ones:
+ *      - Default: the plain pipeline, the numpy files loaded by cnpy then copied into matrices, the matrices
+ *        copied into a TriangleMesh, and the normals copied out of it before being written;
+ *      - InPlace: matrices read straight from the files, and the normals computed into the matrices written;
+ *      - Streaming: face normals computed, written and dropped by blocks of faces, never held whole;
+ *      - Chunked: faces also read by blocks, only the vertices and their normals stay resident;
+ *      - Float32: vertex normals summed in single precision, and normals written as float32 arrays.
+ *
+ * Default and InPlace run computeMeshNormals(). The other ones compute the face normals of a block in parallel,
+ * then add them to their vertices in face order on one thread: their double precision results are bitwise those
+ * of a single thread ComputeNormals(), at the cost of a serial scatter.
+ */
+enum class MemoryStrategy
+{
+  Default,
+  InPlace,
+  Streaming,
+  Chunked,
+  Float32
+};
+
+/**
+ * @brief Name of a strategy, as printed in reports.
+ */
+const char *strategyName(MemoryStrategy strategy);
+
+/**
+ * @brief Predicted peak of the bytes a strategy allocates, the buffers of its largest stage.
+ *
+ * @param num_vertices : number of vertices of the mesh.
+ * @param num_faces : number of faces of the mesh.
+ * @return size_t : bytes over the resident set size of the process before the pipeline.
+ */
+size_t predictPeakBytes(MemoryStrategy strategy, size_t num_vertices, size_t num_faces);
+
+/**
+ * @brief The fastest strategy whose predicted peak resident set size fits in a budget.
+ *
+ * @param budget : peak resident set size allowed, in bytes.
+ * @param baseline : resident set size of the process before the pipeline, in bytes.
+ * @return MemoryStrategy : throw std::invalid_argument when even the smallest strategy does not fit.
+ */
+MemoryStrategy chooseStrategy(size_t budget, size_t baseline, size_t num_vertices, size_t num_faces);
+
+/**
+ * @brief Read the faces and vertices numpy files, compute the normals and write them to numpy files.
+ *
+ * The stages of the strategy are recorded in the accounting. Normals files are float64 arrays, float32 arrays for
+ * MemoryStrategy::Float32.
+ *
+ * @param facesFile : input faces, int32, shape (num_faces, 3).
+ * @param verticesFile : input vertices, float64, shape (num_vertices, 3).
+ * @param faceNormalsFile : output normalized face normals, shape (num_faces, 3).
+ * @param verticesNormalsFile : output normalized vertices normals, shape (num_vertices, 3).
+ * @param accounting : memory accounting the stages are recorded in.
+ */
+void computeNormalsFiles(MemoryStrategy strategy, const std::string &facesFile, const std::string &verticesFile,
+                         const std::string &faceNormalsFile, const std::string &verticesNormalsFile,
+                         MemoryAccounting &accounting);
+
+} // namespace memory
+} // namespace bunny_mesh
+
+#endif // _BUNNY_MESH_MEMORY_BUDGET_
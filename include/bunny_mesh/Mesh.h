@@ -12,12 +12,137 @@
 #define _BUNNY_MESH_
 
 #include "data_io.h"
+#include "Subdivision.h"
+#include "Topology.h"
 
 #include <Eigen/Geometry> 
 #include <Eigen/Dense>
 
 namespace bunny_mesh
 {
+/**
+ * @brief Rotation taking object coordinates to world coordinates for an object orientation.
+ * 
+ * The rotation is applied to row vectors: world = relative * orientationRotation(orientation).
+ * 
+ * @param orientation : normalized object orientation, the default orientation being (0,0,1).
+ * @return Eigen::Matrix3d rotation matrix.
+ */
+Eigen::Matrix3d orientationRotation(const bunny_dataIO::Point3DType &orientation);
+
+/**
+ * @brief Compute normalized face and vertex normals of raw mesh arrays.
+ * 
+ * This is the kernel behind TriangleMesh::ComputeNormals(), usable on data the mesh does not own.
+ * 
+ * @param verticesWorld : vertices in world coordinates, size (num_vertices, 3).
+ * @param faces : faces vertices indexes, size (num_faces, 3).
+ * @param faceNormals : output face normals, size (num_faces, 3).
+ * @param verticesNormals : output vertices normals, size (num_vertices, 3).
+ */
+void computeMeshNormals(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &verticesWorld,
+                        const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces,
+                        Eigen::Ref<bunny_dataIO::Point3DMatrixType> faceNormals,
+                        Eigen::Ref<bunny_dataIO::Point3DMatrixType> verticesNormals);
+
+/**
+ * @brief Bytes of the private vertex normals buffers computeMeshNormals() allocates, with the current number of
+ * threads: one (num_vertices, 3) buffer per chunk of faces but the first, 128 MB at most.
+ */
+size_t computeMeshNormalsScratchBytes(size_t num_vertices, size_t num_faces);
+
+/**
+ * @brief Optional outputs of the normals kernel, combined as a bit mask template argument of computeMeshNormals().
+ */
+enum FaceAttributeFlags : unsigned
+{
+  NoFaceAttributes = 0,
+  FaceAreas = 1u << 0,
+  FaceCentroids = 1u << 1,
+  SurfaceArea = 1u << 2,
+  BoundingBox = 1u << 3,
+  AllFaceAttributes = FaceAreas | FaceCentroids | SurfaceArea | BoundingBox
+};
+
+/**
+ * @brief Geometric attributes computed by the normals kernel in the same pass over the faces.
+ * 
+ * Only the members selected by the FaceAttributeFlags of the call are written, the others are left untouched.
+ */
+struct FaceAttributes
+{
+  // Area of each face, size (num_faces). FaceAreas.
+  Eigen::VectorXd face_areas;
+
+  // Centroid of each face in world coordinates, size (num_faces, 3). FaceCentroids.
+  bunny_dataIO::Point3DMatrixType face_centroids;
+
+  // Sum of the face areas. SurfaceArea.
+  double surface_area = 0.0;
+
+  // Axis aligned bounding box of the vertices referenced by faces, in world coordinates. BoundingBox.
+  bunny_dataIO::Point3DType bounds_min = bunny_dataIO::Point3DType::Zero();
+  bunny_dataIO::Point3DType bounds_max = bunny_dataIO::Point3DType::Zero();
+};
+
+/**
+ * @brief Compute normalized face and vertex normals, and face attributes in the same pass over the faces.
+ * 
+ * Each face already loads its vertices and computes the cross product, whose length is twice the face area, so
+ * areas, centroids, total area and bounding box come at the cost of a few operations per face instead of extra
+ * passes over the vertices. Attributes is a compile time mask of FaceAttributeFlags: unselected attributes are
+ * removed from the kernel by the compiler.
+ * 
+ * Faces are split in chunks processed in parallel; each chunk accumulates its vertex normals, area and bounds
+ * privately, then chunks are reduced in parallel over the vertices.
+ * 
+ * @tparam Attributes : mask of FaceAttributeFlags.
+ * @param attributes : outputs, face arrays are resized if needed.
+ */
+template <unsigned Attributes>
+void computeMeshNormals(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &verticesWorld,
+                        const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces,
+                        Eigen::Ref<bunny_dataIO::Point3DMatrixType> faceNormals,
+                        Eigen::Ref<bunny_dataIO::Point3DMatrixType> verticesNormals, FaceAttributes &attributes);
+
+/**
+ * @brief Compute normalized face and vertex normals, bitwise identical whatever the number of threads.
+ * 
+ * The fast path sums the face normals of a vertex per chunk of faces, so its rounding depends on the number of
+ * chunks, hence of threads. Here each vertex gathers its face normals through the vertex to face adjacency, in
+ * increasing face order: every vertex normal is the sum of the serial algorithm, and face normals, face areas and
+ * centroids are the serial ones too. The surface area is summed per fixed block of faces, then over the blocks in
+ * order. Meshes too small to ever be split in chunks run the fast path, which is serial for them.
+ * 
+ * Cost, relative to the fast path: the unnormalized face normals make a second pass over the faces memory, and
+ * the gather reads them in a random order through the adjacency (4 bytes per face corner). On a single thread,
+ * normals take about 1.4 times as long once the adjacency is built (4.2M faces: 0.44 s instead of 0.31 s), and
+ * building it costs 0.25 to 0.55 of a fast path computation; TriangleMesh keeps it between calls as the faces do
+ * not change. On several threads the gap narrows, since the gather needs no private normals buffer per chunk nor
+ * any reduction of them.
+ * 
+ * @tparam Attributes : mask of FaceAttributeFlags.
+ * @param adjacency : vertex to face adjacency of faces. When empty, it is built by the first call that needs it.
+ */
+template <unsigned Attributes>
+void computeMeshNormalsDeterministic(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &verticesWorld,
+                                     const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces,
+                                     VertexFaceAdjacency &adjacency,
+                                     Eigen::Ref<bunny_dataIO::Point3DMatrixType> faceNormals,
+                                     Eigen::Ref<bunny_dataIO::Point3DMatrixType> verticesNormals,
+                                     FaceAttributes &attributes);
+
+/**
+ * @brief Compute normalized face and vertex normals, bitwise identical whatever the number of threads.
+ * 
+ * @param adjacency : vertex to face adjacency of faces. When empty, it is built by the first call that needs it.
+ */
+void computeMeshNormalsDeterministic(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &verticesWorld,
+                                     const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces,
+                                     VertexFaceAdjacency &adjacency,
+                                     Eigen::Ref<bunny_dataIO::Point3DMatrixType> faceNormals,
+                                     Eigen::Ref<bunny_dataIO::Point3DMatrixType> verticesNormals);
+
 /**
  * @brief Triangular mesh following the face-vertex representation.
  * 
@@ -69,12 +194,82 @@ public:
      */
   void ComputeNormals();
 
+  /**
+     * @brief Compute the normalized normals and write them into caller owned buffers instead of the mesh members.
+     * 
+     * Buffers may map external memory, such as a shared memory segment, so results are never copied.
+     * 
+     * @param faceNormals : output face normals, size (num_faces, 3).
+     * @param verticesNormals : output vertices normals, size (num_vertices, 3).
+     */
+  void ComputeNormals(Eigen::Ref<bunny_dataIO::Point3DMatrixType> faceNormals,
+                      Eigen::Ref<bunny_dataIO::Point3DMatrixType> verticesNormals);
+
+  /**
+     * @brief Compute the normalized normals and the selected face attributes in a single pass over the faces.
+     * 
+     * Usage:
+     *      FaceAttributes attributes;
+     *      mesh.ComputeNormals<FaceAreas | BoundingBox>(attributes);
+     * 
+     * @tparam Attributes : mask of FaceAttributeFlags.
+     * @param attributes : outputs of the selected attributes.
+     */
+  template <unsigned Attributes>
+  void ComputeNormals(FaceAttributes &attributes)
+  {
+    if (orientation != orientationDefault)
+    {
+      computeNormals<Attributes>(getVerticesIntoWorld(), face_normals, vertices_normals, attributes);
+    }
+    else
+    {
+      computeNormals<Attributes>(vertices, face_normals, vertices_normals, attributes);
+    }
+    normals_valid = true;
+  }
+
+  /**
+     * @brief Select the deterministic normals, bitwise identical whatever the number of threads.
+     * 
+     * See computeMeshNormalsDeterministic() for its cost. The vertex to face adjacency it needs is built by the
+     * first computation and kept until the faces change.
+     * 
+     * @param enabled : true for the deterministic normals, false for the fast path (default).
+     */
+  inline void setDeterministic(bool enabled) { this->deterministic = enabled; }
+
+  /**
+     * @brief Whether normals are computed in deterministic mode.
+     */
+  inline bool isDeterministic() const { return this->deterministic; }
+
+  /**
+     * @brief Subdivide the mesh, splitting every face in 4 per level, with the normals of the finest level.
+     * 
+     * The edge table is hashed once and kept by the mesh; the edges and vertex to face adjacency of each level
+     * are then derived from the level above in closed form, without hashing nor sorting again (see
+     * subdivideEdgeTable()). Levels inherit the orientation and the deterministic mode.
+     * 
+     * Normals come from the parent level where they can:
+     *      - Midpoint: the surface does not move, normals are propagated from the parent normals, which are
+     *        computed first if out of date (see propagateMidpointNormals());
+     *      - Loop: vertices move, so the finest level computes its face normals, and each vertex gathers them
+     *        through the derived adjacency, without the private buffers nor the reduction of the fast path, as
+     *        computeMeshNormalsDeterministic() does. Coarser levels skip their normals.
+     * 
+     * @param scheme : midpoint or Loop subdivision.
+     * @param levels : number of subdivisions, at least one.
+     * @return TriangleMesh : subdivided mesh, with its normals computed.
+     */
+  TriangleMesh Subdivide(SubdivisionScheme scheme, int levels = 1);
+
    /**
     * @brief Computes the angle between object orientation and its default orientation.
     * 
     * @return double radians angle value.
     */
-   inline double objectAngle() 
+   inline double objectAngle() const
    { 
       return acos(orientationDefault.dot(getOrientation())); 
    }
@@ -84,7 +279,7 @@ public:
     * 
     * @return Normalized Array normal to the rotation.
     */
-   inline bunny_dataIO::Point3DType RotationAxis() { return (orientationDefault.cross(getOrientation())).normalized(); }
+   inline bunny_dataIO::Point3DType RotationAxis() const { return (orientationDefault.cross(getOrientation())).normalized(); }
 
    /**
     * @brief Apply a rotation transform in the array to convert from relative coordinates to world coordinates.
@@ -92,66 +287,128 @@ public:
     * @param array : relative position of a point to the object.
     * @return 
     */
-   bunny_dataIO::Point3DType matchObjectOrientation(const bunny_dataIO::Point3DType&);
+   bunny_dataIO::Point3DType matchObjectOrientation(const bunny_dataIO::Point3DType&) const;
 
    /**
     * @brief Returns the object vertices for an arbitrary object orientation.
     * 
     * @return bunny_dataIO::Point3DMatrixType 
     */
-   bunny_dataIO::Point3DMatrixType getVerticesIntoWorld();
+   bunny_dataIO::Point3DMatrixType getVerticesIntoWorld() const;
 
   /**
      * @brief Get the Faces object
      * 
      * @return faces private object 
      */
-  inline bunny_dataIO::IndexMatrixType getFaces() { return this->faces; }
+  inline bunny_dataIO::IndexMatrixType getFaces() const { return this->faces; }
 
   /**
      * @brief Set the Faces object 
      */
-  inline void setFaces(const bunny_dataIO::IndexMatrixType &faces) { this->faces = faces; }
+  inline void setFaces(const bunny_dataIO::IndexMatrixType &faces)
+  {
+    this->faces = faces;
+    this->adjacency = VertexFaceAdjacency();
+    this->edges = EdgeTable();
+    this->normals_valid = false;
+  }
 
   /**
      * @brief Get the Vertices object
      * 
      * @return vertices private object
      */
-  inline bunny_dataIO::Point3DMatrixType getVertices() { return this->vertices; }
+  inline bunny_dataIO::Point3DMatrixType getVertices() const { return this->vertices; }
 
   /**
      * @brief Set the Vertices object 
      */
-  inline void setVertices(const bunny_dataIO::Point3DMatrixType &vertices) { this->vertices = vertices; }
+  inline void setVertices(const bunny_dataIO::Point3DMatrixType &vertices)
+  {
+    this->vertices = vertices;
+    this->normals_valid = false;
+  }
+
+  /**
+     * @brief Overwrite a block of contiguous vertices, keeping the faces and the buffers allocated.
+     * 
+     * @param first : index of the first vertex to overwrite.
+     * @param block : new vertices, size (count, 3).
+     */
+  void setVerticesBlock(size_t first, const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &block);
 
   /**
      * @brief Get the Vertices object
      * 
      * @return vertices private object
      */
-  inline bunny_dataIO::Point3DType getOrientation(){ return this->orientation; };
+  inline bunny_dataIO::Point3DType getOrientation() const { return this->orientation; };
 
   /**
      * @brief Set the Vertices object 
      */
-  inline void setOrientation(const bunny_dataIO::Point3DType &orientation) { this->orientation = orientation.normalized(); }
+  inline void setOrientation(const bunny_dataIO::Point3DType &orientation)
+  {
+    this->orientation = orientation.normalized();
+    this->normals_valid = false;
+  }
 
   /**
      * @brief Get the faces normalized normals object
      * 
      * @return face_normals private object
      */
-  inline bunny_dataIO::Point3DMatrixType getFaceNormals() { return this->face_normals; }
+  inline bunny_dataIO::Point3DMatrixType getFaceNormals() const { return this->face_normals; }
 
   /**
      * @brief Get the vertices normalized normals object
      * 
      * @return vertices_normals private object
      */
-  inline bunny_dataIO::Point3DMatrixType getVerticeNormals() { return this->vertices_normals; }
+  inline bunny_dataIO::Point3DMatrixType getVerticeNormals() const { return this->vertices_normals; }
+
+  /**
+     * @brief Face normalized normals without a copy, valid until the next ComputeNormals() call.
+     * 
+     * @return const reference to the face_normals private object
+     */
+  inline const bunny_dataIO::Point3DMatrixType &faceNormals() const { return this->face_normals; }
+
+  /**
+     * @brief Whether the normals match the current vertices, faces and orientation.
+     * 
+     * @return false before the first ComputeNormals() call and after any change of the mesh.
+     */
+  inline bool hasValidNormals() const { return this->normals_valid; }
 
 private:
+  /**
+     * @brief Subdivide once, the mesh topology being built.
+     * 
+     * @param withNormals : compute the normals of the subdivided mesh, else leave them zero.
+     */
+  TriangleMesh subdivideLevel(SubdivisionScheme scheme, bool withNormals) const;
+
+  /**
+     * @brief Run the normals kernel selected by the deterministic mode.
+     */
+  template <unsigned Attributes>
+  void computeNormals(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &verticesWorld,
+                      Eigen::Ref<bunny_dataIO::Point3DMatrixType> faceNormals,
+                      Eigen::Ref<bunny_dataIO::Point3DMatrixType> verticesNormals, FaceAttributes &attributes)
+  {
+    if (deterministic)
+    {
+      computeMeshNormalsDeterministic<Attributes>(verticesWorld, faces, adjacency, faceNormals, verticesNormals,
+                                                  attributes);
+    }
+    else
+    {
+      computeMeshNormals<Attributes>(verticesWorld, faces, faceNormals, verticesNormals, attributes);
+    }
+  }
+
   // Number of faces
   size_t num_faces;
 
@@ -174,6 +431,18 @@ private:
 
   // Array of normalized vertex normals of size (num_vertices, 3)
   bunny_dataIO::Point3DMatrixType vertices_normals;
+
+  // Deterministic normals mode, false by default
+  bool deterministic = false;
+
+  // Vertex to face adjacency of the deterministic mode and of the subdivision, empty until first needed
+  VertexFaceAdjacency adjacency;
+
+  // Edge table of the subdivision, empty until first needed
+  EdgeTable edges;
+
+  // Whether the normals members match the current vertices, faces and orientation
+  bool normals_valid = false;
 };
 } // namespace bunny_mesh
 
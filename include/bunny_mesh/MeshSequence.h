@@ -0,0 +1,182 @@
+/**
+ * @file MeshSequence.h
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Normals of animated meshes, whose faces stay fixed while the vertices change every frame.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#ifndef _BUNNY_MESH_MESH_SEQUENCE_
+#define _BUNNY_MESH_MESH_SEQUENCE_
+
+#include "data_io.h"
+#include "Topology.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bunny_mesh
+{
+/**
+ * @brief Normalized normals of one frame, in world coordinates.
+ */
+struct FrameNormals
+{
+  // Normalized face normals, size (num_faces, 3)
+  bunny_dataIO::Point3DMatrixType face_normals;
+
+  // Normalized vertex normals, size (num_vertices, 3)
+  bunny_dataIO::Point3DMatrixType vertices_normals;
+};
+
+/**
+ * @brief Throughput of a sequence run.
+ */
+struct SequenceStats
+{
+  // Number of frames computed
+  size_t frames = 0;
+
+  // Frames computed at once, on one thread each, or 1 when each frame runs on every thread
+  size_t frames_in_flight = 0;
+
+  // Wall time of the run, reading and writing the frames included
+  double seconds = 0.0;
+
+  inline double fps() const { return seconds > 0.0 ? frames / seconds : 0.0; }
+};
+
+/**
+ * @brief Normals of a sequence of frames sharing the same faces, such as an animation.
+ *
+ * Constructing a TriangleMesh per frame copies the faces and allocates every buffer again. A sequence keeps its
+ * faces, their vertex to face adjacency, and its vertices and normals buffers from one frame to the next: frames
+ * only write the vertices and read the normals.
+ *
+ * Normals are computed by computeMeshNormalsDeterministic(), so every frame is bitwise identical to a single thread
+ * TriangleMesh::ComputeNormals() of its vertices, whatever the number of threads and of frames in flight.
+ *
+ * Usage, one frame at a time:
+ *      MeshSequence sequence(faces, num_vertices);
+ *      for (...)
+ *      {
+ *          const FrameNormals &normals = sequence.computeFrame(vertices);
+ *          ...
+ *      }
+ */
+class MeshSequence
+{
+public:
+  /**
+   * @brief Fills the vertices of a frame, in object coordinates: source(frame, vertices).
+   */
+  typedef std::function<void(size_t, Eigen::Ref<bunny_dataIO::Point3DMatrixType>)> FrameSource;
+
+  /**
+   * @brief Receives the normals of a frame: sink(frame, normals). The normals are only valid during the call.
+   */
+  typedef std::function<void(size_t, const FrameNormals &)> FrameSink;
+
+  /**
+   * @brief Build the topology of the sequence, kept for all its frames.
+   *
+   * @param faces : faces vertices indexes, size (num_faces, 3).
+   * @param num_vertices : number of vertices of every frame.
+   */
+  MeshSequence(const bunny_dataIO::IndexMatrixType &faces, size_t num_vertices);
+
+  MeshSequence(const MeshSequence &) = delete;
+  MeshSequence &operator=(const MeshSequence &) = delete;
+
+  /**
+   * @brief Compute the normals of a frame into the back buffer, then swap it with the front one.
+   *
+   * The normals of the previous frame stay valid in the other buffer until the next call.
+   *
+   * @param vertices : vertices of the frame in object coordinates, size (num_vertices, 3).
+   * @return const FrameNormals& : the normals of the frame, the front buffer.
+   */
+  const FrameNormals &computeFrame(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &vertices);
+
+  /**
+   * @brief Normals of the last frame computed by computeFrame(), zero before the first one.
+   */
+  inline const FrameNormals &currentFrame() const { return outputs[front]; }
+
+  /**
+   * @brief Compute the normals of numFrames frames, pipelined: while frames are computed, the next ones are read
+   * from the source and the previous ones are given to the sink, on another thread.
+   *
+   * Meshes too small to be split by the normals kernel have several frames computed at once, each on a single
+   * thread (see parallel::SerialRegion); larger ones have each frame computed on every thread. Two sets of buffers are kept for the frames in flight,
+   * one computed while the other one is read and written. The source and the sink are called in frame order, from
+   * one thread at a time. The first exception thrown is rethrown once the frames in flight are done.
+   *
+   * @param numFrames : number of frames of the sequence.
+   * @param source : fills the vertices of each frame.
+   * @param sink : receives the normals of each frame.
+   * @return SequenceStats : frames per second of the run.
+   */
+  SequenceStats run(size_t numFrames, const FrameSource &source, const FrameSink &sink);
+
+  /**
+   * @brief Frames computed at once by run(), with the current number of threads.
+   */
+  size_t framesInFlight() const;
+
+  inline size_t numFaces() const { return faces.rows(); }
+  inline size_t numVertices() const { return num_vertices; }
+
+  inline bunny_dataIO::Point3DType getOrientation() const { return orientation; }
+
+  /**
+   * @brief Set the orientation of every frame, as TriangleMesh::setOrientation() does.
+   */
+  void setOrientation(const bunny_dataIO::Point3DType &orientation);
+
+private:
+  /**
+   * @brief Compute the normals of vertices in object coordinates, rotated into the world buffer when needed.
+   */
+  void computeNormals(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &vertices,
+                      bunny_dataIO::Point3DMatrixType &world, FrameNormals &normals);
+
+  size_t num_vertices;
+
+  // Faces shared by every frame and their vertex to face adjacency
+  bunny_dataIO::IndexMatrixType faces;
+  VertexFaceAdjacency adjacency;
+
+  bunny_dataIO::Point3DType orientation;
+
+  // Double buffered normals of computeFrame(), front being the last frame computed
+  FrameNormals outputs[2];
+  int front;
+
+  // Vertices of computeFrame(), in world coordinates
+  bunny_dataIO::Point3DMatrixType verticesWorld;
+
+  // Vertices, world vertices and normals of the frames in flight of run(), two sets of framesInFlight()
+  std::vector<bunny_dataIO::Point3DMatrixType> frameVertices;
+  std::vector<bunny_dataIO::Point3DMatrixType> frameWorld;
+  std::vector<FrameNormals> frameNormals;
+};
+
+/**
+ * @brief Compute the normals of every frame of a numpy file, and write them to numpy files.
+ *
+ * @param facesFile : faces, int32, shape (num_faces, 3).
+ * @param framesFile : vertices of each frame, float64, shape (num_frames, num_vertices, 3).
+ * @param faceNormalsFile : output normalized face normals, float64, shape (num_frames, num_faces, 3).
+ * @param verticesNormalsFile : output normalized vertex normals, float64, shape (num_frames, num_vertices, 3).
+ * @return SequenceStats : frames per second, reading and writing included.
+ */
+SequenceStats computeSequenceFiles(const std::string &facesFile, const std::string &framesFile,
+                                   const std::string &faceNormalsFile, const std::string &verticesNormalsFile);
+
+} // namespace bunny_mesh
+
+#endif // _BUNNY_MESH_MESH_SEQUENCE_
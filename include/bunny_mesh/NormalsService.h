@@ -0,0 +1,262 @@
+/**
+ * @file NormalsService.h
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Long running normals server, with meshes kept resident, and its client over a local IPC interface.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#ifndef _BUNNY_MESH_NORMALS_SERVICE_
+#define _BUNNY_MESH_NORMALS_SERVICE_
+
+#include "data_io.h"
+#include "Mesh.h"
+
+#include <Eigen/Dense>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace bunny_mesh
+{
+namespace service
+{
+/**
+ * @brief Commands understood by the server.
+ */
+enum Command : uint32_t
+{
+  // load a mesh from numpy files and create its shared memory segment
+  CommandLoad = 1,
+  // compute the normals of a loaded mesh into its shared memory segment
+  CommandCompute = 2,
+  // release a loaded mesh and its shared memory segment
+  CommandUnload = 3,
+  // stop the server
+  CommandShutdown = 4
+};
+
+// Maximal length of the paths and names exchanged with the server
+const size_t kMaxPathLength = 256;
+
+/**
+ * @brief Fixed size request message. Vertices and normals never go through the socket.
+ */
+struct Request
+{
+  uint32_t command;
+  uint32_t mesh_id;
+  // orientation of the mesh for CommandCompute
+  double orientation[3];
+  // block of vertices updated in the shared memory segment since the last request, for CommandCompute
+  uint64_t vertex_offset;
+  uint64_t vertex_count;
+  // numpy files of the mesh for CommandLoad
+  char faces_path[kMaxPathLength];
+  char vertices_path[kMaxPathLength];
+};
+
+/**
+ * @brief Fixed size response message.
+ */
+struct Response
+{
+  // zero on success
+  int32_t status;
+  uint32_t mesh_id;
+  uint64_t num_vertices;
+  uint64_t num_faces;
+  // name of the shared memory segment of the mesh, for CommandLoad
+  char segment[kMaxPathLength];
+  // error description when status is not zero
+  char message[kMaxPathLength];
+};
+
+/**
+ * @brief Layout of the shared memory segment of a mesh.
+ *
+ * The segment starts with this header, followed by three arrays aligned on cache lines:
+ *      - vertices (num_vertices, 3), written by the client;
+ *      - face normals (num_faces, 3), written by the server;
+ *      - vertex normals (num_vertices, 3), written by the server.
+ */
+struct SegmentHeader
+{
+  uint64_t num_vertices;
+  uint64_t num_faces;
+  uint64_t vertices_offset;
+  uint64_t face_normals_offset;
+  uint64_t vertex_normals_offset;
+  uint64_t size;
+
+  /**
+   * @brief Compute the layout of a segment for a mesh size.
+   */
+  static SegmentHeader layout(uint64_t num_vertices, uint64_t num_faces);
+};
+
+/**
+ * @brief Shared memory segment mapped in the current process.
+ */
+class SharedSegment
+{
+public:
+  /**
+   * @brief Create a named segment, server side. It is removed when this object is destroyed.
+   *
+   * @param name : POSIX shared memory name, starting with '/'.
+   * @param layout : layout of the segment, written in its header.
+   */
+  SharedSegment(const std::string &name, const SegmentHeader &layout);
+
+  /**
+   * @brief Open an existing named segment, client side.
+   *
+   * @param name : POSIX shared memory name, starting with '/'.
+   */
+  explicit SharedSegment(const std::string &name);
+  ~SharedSegment();
+
+  SharedSegment(const SharedSegment &) = delete;
+  SharedSegment &operator=(const SharedSegment &) = delete;
+
+  /**
+   * @brief Layout of the segment, copied from its header and checked against the mapping when the segment is created
+   * or opened. The header in shared memory may be rewritten by the other process at any time, so it is never read
+   * again: arrays are mapped from this private copy.
+   */
+  inline const SegmentHeader &header() const { return this->layout; }
+  inline const std::string &getName() const { return this->name; }
+
+  /**
+   * @brief Vertices of the mesh, written by the client before a compute request.
+   */
+  Eigen::Map<bunny_dataIO::Point3DMatrixType> vertices();
+
+  /**
+   * @brief Face normals written by the server.
+   */
+  Eigen::Map<bunny_dataIO::Point3DMatrixType> faceNormals();
+
+  /**
+   * @brief Vertex normals written by the server.
+   */
+  Eigen::Map<bunny_dataIO::Point3DMatrixType> vertexNormals();
+
+private:
+  void map(int fd);
+
+  std::string name;
+  void *address;
+  size_t size;
+  bool owner;
+  SegmentHeader layout;
+};
+
+/**
+ * @brief Normals server listening on a Unix domain socket.
+ *
+ * Each loaded mesh keeps its TriangleMesh resident and owns a shared memory segment. A compute request copies the
+ * updated vertex block from the segment into the mesh and writes the normals straight into the segment, so a request
+ * only costs one small message each way plus the normals computation itself.
+ * Requests are served by a single thread, in the order they arrive.
+ */
+class NormalsServer
+{
+public:
+  /**
+   * @brief Create the server socket.
+   *
+   * @param socketPath : file system path of the Unix domain socket, replaced if it exists.
+   */
+  explicit NormalsServer(const std::string &socketPath);
+  ~NormalsServer();
+
+  NormalsServer(const NormalsServer &) = delete;
+  NormalsServer &operator=(const NormalsServer &) = delete;
+
+  /**
+   * @brief Serve requests until a shutdown request or a call to stop().
+   */
+  void run();
+
+  /**
+   * @brief Ask run() to return, callable from any thread.
+   */
+  void stop();
+
+private:
+  struct ResidentMesh
+  {
+    std::unique_ptr<TriangleMesh> mesh;
+    std::unique_ptr<SharedSegment> segment;
+    // layout of the segment at registration, every bounds check of a request uses it
+    SegmentHeader layout;
+  };
+
+  // returns false when the server must stop
+  bool handle(const Request &request, Response &response);
+
+  std::string socket_path;
+  int listen_fd;
+  int wake_pipe[2];
+  std::map<uint32_t, ResidentMesh> meshes;
+};
+
+/**
+ * @brief Client of a NormalsServer.
+ */
+class NormalsClient
+{
+public:
+  /**
+   * @brief Connect to a server.
+   */
+  explicit NormalsClient(const std::string &socketPath);
+  ~NormalsClient();
+
+  NormalsClient(const NormalsClient &) = delete;
+  NormalsClient &operator=(const NormalsClient &) = delete;
+
+  /**
+   * @brief Load a mesh on the server and map its shared memory segment.
+   *
+   * @return SharedSegment& : segment of the mesh, valid until unload().
+   */
+  SharedSegment &load(uint32_t meshId, const std::string &facesPath, const std::string &verticesPath);
+
+  /**
+   * @brief Compute the normals of a mesh. On return they are available in its segment.
+   *
+   * @param meshId : id given to load().
+   * @param orientation : object orientation.
+   * @param vertexOffset : first vertex written in the segment since the previous request.
+   * @param vertexCount : number of vertices written in the segment since the previous request.
+   */
+  void compute(uint32_t meshId, const bunny_dataIO::Point3DType &orientation, uint64_t vertexOffset = 0,
+               uint64_t vertexCount = 0);
+
+  /**
+   * @brief Release a mesh on the server.
+   */
+  void unload(uint32_t meshId);
+
+  /**
+   * @brief Ask the server to stop.
+   */
+  void shutdown();
+
+private:
+  Response call(const Request &request);
+
+  int fd;
+  std::map<uint32_t, std::unique_ptr<SharedSegment>> segments;
+};
+
+} // namespace service
+} // namespace bunny_mesh
+
+#endif // _BUNNY_MESH_NORMALS_SERVICE_
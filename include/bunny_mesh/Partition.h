@@ -0,0 +1,169 @@
+/**
+ * @file Partition.h
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Spatial partitioning of a mesh and normals computed by one process per partition with a halo exchange.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#ifndef _BUNNY_MESH_PARTITION_
+#define _BUNNY_MESH_PARTITION_
+
+#include "data_io.h"
+#include "Topology.h"
+
+#include <vector>
+
+namespace bunny_mesh
+{
+namespace distributed
+{
+/**
+ * @brief Vertices a partition shares with another rank, and the faces whose normals cross the link.
+ *
+ * The two ends of a link list the same vertices and faces in the same order, by increasing global index, so the
+ * k-th row sent by one rank is the k-th row received by the other one.
+ */
+struct HaloLink
+{
+  // Rank at the other end of the link
+  int rank;
+
+  // Local vertex indexes, size (num_shared)
+  std::vector<int> vertices;
+
+  // Faces around the shared vertices, sent by the non owner rank: local face indexes on the sending end, global
+  // face indexes on the receiving end, size (num_sent_faces)
+  std::vector<int> faces;
+};
+
+/**
+ * @brief Faces of one rank, with their vertices renumbered locally, and the halo it shares with other ranks.
+ *
+ * A vertex referenced by several partitions is owned by the lowest of their ranks. Its other ranks send the
+ * unnormalized normals of their faces around it to the owner, which sums every face of the vertex in global face
+ * order, as the serial algorithm does, and sends the normalized result back.
+ */
+struct MeshPartition
+{
+  // Rank of the partition, between 0 and the number of partitions
+  int rank;
+
+  // Faces with local vertex indexes, size (num_local_faces, 3), by increasing global face index
+  bunny_dataIO::IndexMatrixType faces;
+
+  // Local vertices, size (num_local_vertices, 3)
+  bunny_dataIO::Point3DMatrixType vertices;
+
+  // Global index of each local face, size (num_local_faces)
+  std::vector<int> global_faces;
+
+  // Global index of each local vertex, size (num_local_vertices), increasing
+  std::vector<int> global_vertices;
+
+  // Vertex to face adjacency of the local faces
+  VertexFaceAdjacency adjacency;
+
+  // Vertices owned by another rank, one link per owner by increasing rank: face normals sent,
+  // normals received
+  std::vector<HaloLink> contributions;
+
+  // Owned vertices also referenced by other ranks, one link per rank by increasing rank: face normals received,
+  // normals sent
+  std::vector<HaloLink> boundary;
+
+  // Owned vertices shared with other ranks, by increasing global index
+  std::vector<int> shared_vertices;
+
+  // Offsets of each shared vertex in shared_terms, size (num_shared_vertices + 1)
+  std::vector<int> shared_terms_offsets;
+
+  // Face normals summed by each shared vertex, in increasing global face order: a local face index when positive
+  // or zero, else -(1 + row) where row indexes the rows received from the boundary links, concatenated in order
+  std::vector<int> shared_terms;
+};
+
+/**
+ * @brief Split a mesh into spatially coherent partitions of nearly equal numbers of faces.
+ *
+ * Faces are sorted along the Morton curve of their centroids, quantized on a 2^21 grid per axis of the vertices
+ * bounding box, and the curve is cut in numPartitions contiguous ranges. Neighbour faces mostly land in the same
+ * partition, so the halo stays small compared to the partitions. Vertices referenced by no face belong to no
+ * partition.
+ *
+ * @param vertices : vertices in world coordinates, size (num_vertices, 3).
+ * @param faces : faces vertices indexes, size (num_faces, 3).
+ * @param numPartitions : number of partitions, at least one.
+ * @return std::vector<MeshPartition> : partitions, indexed by rank.
+ */
+std::vector<MeshPartition> partitionMesh(const bunny_dataIO::Point3DMatrixType &vertices,
+                                         const bunny_dataIO::IndexMatrixType &faces, int numPartitions);
+
+/**
+ * @brief Transport of halo rows between ranks, implemented once per process model.
+ *
+ * An MPI implementation maps exchange() on MPI_Neighbor_alltoallv, or on Isend/Irecv pairs, over the link ranks.
+ */
+class HaloExchange
+{
+public:
+  virtual ~HaloExchange() {}
+
+  /**
+   * @brief Collective exchange: every rank calls it the same number of times, in the same order.
+   *
+   * @param sendLinks : ranks to send to.
+   * @param sendRows : rows sent to each link rank, size (num_rows, 3).
+   * @param receiveLinks : ranks to receive from.
+   * @param receiveRows : rows received from each link rank, already sized by the caller.
+   */
+  virtual void exchange(const std::vector<HaloLink> &sendLinks,
+                        const std::vector<bunny_dataIO::Point3DMatrixType> &sendRows,
+                        const std::vector<HaloLink> &receiveLinks,
+                        std::vector<bunny_dataIO::Point3DMatrixType> &receiveRows) = 0;
+};
+
+/**
+ * @brief Compute the normals of one partition, the work of one rank, touching its local arrays only.
+ *
+ * Face normals are computed locally; each vertex then sums its local faces through the adjacency in increasing
+ * global face order. Two exchanges reconcile the halo: face normals around the shared vertices go to their owners,
+ * normalized vertex normals come back. Every vertex sums the same terms in the same order as the serial algorithm,
+ * so results are bitwise identical to TriangleMesh::ComputeNormals() on a single thread, whatever the number of
+ * partitions. Sending faces instead of partial sums costs about three rows per shared vertex instead of one, and
+ * keeps vertices whose face normals nearly cancel out from turning with the partitioning.
+ *
+ * @param partition : partition of the rank.
+ * @param exchange : halo transport, called twice.
+ * @param faceNormals : output local face normals, size (num_local_faces, 3).
+ * @param verticesNormals : output local vertex normals, size (num_local_vertices, 3).
+ */
+void computePartitionNormals(const MeshPartition &partition, HaloExchange &exchange,
+                             bunny_dataIO::Point3DMatrixType &faceNormals,
+                             bunny_dataIO::Point3DMatrixType &verticesNormals);
+
+/**
+ * @brief Compute the normals of a partitioned mesh with one process per partition, the local stand-in for MPI.
+ *
+ * Each rank is a forked process running computePartitionNormals() with numThreads() / partitions threads, at
+ * least one. Halo rows go through per rank pair mailboxes in an anonymous shared memory mapping, synchronized
+ * by a process shared barrier, and each rank writes its faces and owned vertices into shared global outputs.
+ * A failing rank makes the others give up at the next barrier instead of waiting forever, whether it throws or is
+ * killed by a signal. Only the ranks are waited for, other children of the process are left to their owner.
+ *
+ * @param partitions : partitions from partitionMesh(), indexed by rank.
+ * @param num_vertices : number of vertices of the whole mesh.
+ * @param num_faces : number of faces of the whole mesh.
+ * @param faceNormals : output face normals, size (num_faces, 3).
+ * @param verticesNormals : output vertex normals, size (num_vertices, 3), not a number for unreferenced vertices.
+ */
+void computePartitionedNormals(const std::vector<MeshPartition> &partitions, size_t num_vertices, size_t num_faces,
+                               bunny_dataIO::Point3DMatrixType &faceNormals,
+                               bunny_dataIO::Point3DMatrixType &verticesNormals);
+
+} // namespace distributed
+} // namespace bunny_mesh
+
+#endif // _BUNNY_MESH_PARTITION_
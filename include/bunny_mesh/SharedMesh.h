@@ -0,0 +1,121 @@
+/**
+ * @file SharedMesh.h
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Triangle mesh shared between threads through immutable, versioned snapshots.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#ifndef _BUNNY_MESH_SHARED_MESH_
+#define _BUNNY_MESH_SHARED_MESH_
+
+#include "data_io.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace bunny_mesh
+{
+/**
+ * @brief Immutable geometry of a mesh: topology, positions and orientation.
+ *
+ * Faces are shared by every snapshot of a mesh, since only the positions and orientation change between versions.
+ */
+struct GeometrySnapshot
+{
+  // Faces vertices indexes, size (num_faces, 3)
+  std::shared_ptr<const bunny_dataIO::IndexMatrixType> faces;
+
+  // Vertices in object coordinates, size (num_vertices, 3)
+  std::shared_ptr<const bunny_dataIO::Point3DMatrixType> vertices;
+
+  // Normalized object orientation
+  bunny_dataIO::Point3DType orientation;
+
+  // Version of the geometry, incremented by each update
+  uint64_t version;
+};
+
+/**
+ * @brief Immutable normals computed from a geometry snapshot.
+ */
+struct NormalsSnapshot
+{
+  // Geometry the normals were computed from
+  std::shared_ptr<const GeometrySnapshot> geometry;
+
+  // Normalized face normals in world coordinates, size (num_faces, 3)
+  bunny_dataIO::Point3DMatrixType face_normals;
+
+  // Normalized vertex normals in world coordinates, size (num_vertices, 3)
+  bunny_dataIO::Point3DMatrixType vertices_normals;
+};
+
+/**
+ * @brief Triangle mesh read by many threads while a writer updates it.
+ *
+ * Readers take a snapshot and keep using it as long as they hold the pointer: snapshots are never modified.
+ * Writers build new snapshots aside and publish them by swapping a shared pointer with std::atomic_store, so readers
+ * never wait for a recomputation, they only see the previous version until the swap.
+ * Writers are serialized between themselves.
+ *
+ * Usage:
+ *      SharedMesh mesh(vertices, faces);
+ *      mesh.recompute();                      // writer thread
+ *      auto normals = mesh.normals();         // any reader thread
+ *      normals->face_normals ...
+ */
+class SharedMesh
+{
+public:
+  /**
+   * @brief Construct a shared mesh at the default orientation. No normals are published until recompute().
+   */
+  SharedMesh(const bunny_dataIO::Point3DMatrixType &vertices, const bunny_dataIO::IndexMatrixType &faces);
+
+  /**
+   * @brief Latest published geometry, never blocks on writers.
+   */
+  std::shared_ptr<const GeometrySnapshot> geometry() const;
+
+  /**
+   * @brief Latest published normals, null before the first recompute(). Never blocks on writers.
+   */
+  std::shared_ptr<const NormalsSnapshot> normals() const;
+
+  /**
+   * @brief Publish new vertex positions, keeping the faces.
+   *
+   * @return uint64_t : version of the published geometry.
+   */
+  uint64_t setVertices(const bunny_dataIO::Point3DMatrixType &vertices);
+
+  /**
+   * @brief Publish a new orientation, keeping the faces and vertices.
+   *
+   * @return uint64_t : version of the published geometry.
+   */
+  uint64_t setOrientation(const bunny_dataIO::Point3DType &orientation);
+
+  /**
+   * @brief Compute the normals of the latest geometry and publish them.
+   *
+   * @return std::shared_ptr<const NormalsSnapshot> : the published normals.
+   */
+  std::shared_ptr<const NormalsSnapshot> recompute();
+
+private:
+  // publishes a geometry derived from the latest one, writer_mutex must be held
+  uint64_t publish(std::shared_ptr<const bunny_dataIO::Point3DMatrixType> vertices,
+                   const bunny_dataIO::Point3DType &orientation);
+
+  std::shared_ptr<const GeometrySnapshot> current_geometry;
+  std::shared_ptr<const NormalsSnapshot> current_normals;
+  std::mutex writer_mutex;
+};
+} // namespace bunny_mesh
+
+#endif // _BUNNY_MESH_SHARED_MESH_
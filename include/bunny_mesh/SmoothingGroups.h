@@ -0,0 +1,64 @@
+/**
+ * @file SmoothingGroups.h
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Crease aware vertex normals, split by smoothing groups.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#ifndef _BUNNY_MESH_SMOOTHING_GROUPS_
+#define _BUNNY_MESH_SMOOTHING_GROUPS_
+
+#include "data_io.h"
+#include "Mesh.h"
+
+#include <vector>
+
+namespace bunny_mesh
+{
+/**
+ * @brief Vertex normals split along the creases of a mesh.
+ *
+ * Around each vertex, incident faces sharing an edge are put in the same smoothing group when the angle between
+ * their normals is below the crease angle. Each smoothing group of a vertex becomes a split vertex, whose normal is
+ * the normalized sum of the unnormalized normals of its faces (the same weighting as TriangleMesh::ComputeNormals()).
+ *
+ * With a crease angle of pi (or more) every vertex has a single group, even where its faces are not connected by an
+ * edge, and the normals match TriangleMesh::ComputeNormals().
+ */
+struct SmoothingGroups
+{
+  // Normalized normal of each face corner. Row 3 * face + k is the normal of vertex faces(face, k) on this face,
+  // size (3 * num_faces, 3)
+  bunny_dataIO::Point3DMatrixType corner_normals;
+
+  // Faces of the vertex split mesh, indexing split_vertices, size (num_faces, 3)
+  bunny_dataIO::IndexMatrixType split_faces;
+
+  // Vertices of the vertex split mesh, size (num_split_vertices, 3)
+  bunny_dataIO::Point3DMatrixType split_vertices;
+
+  // Normalized normals of the vertex split mesh, size (num_split_vertices, 3)
+  bunny_dataIO::Point3DMatrixType split_normals;
+
+  // Original vertex index of each split vertex, size (num_split_vertices)
+  std::vector<int> split_source;
+};
+
+/**
+ * @brief Compute the crease aware normals of a mesh, in world coordinates.
+ *
+ * Faces are processed in parallel to get their normals, then vertices are processed in parallel: the incident faces
+ * of each vertex, read from the vertex to face adjacency, are clustered with a small union-find.
+ *
+ * @param mesh : triangle mesh, at its current orientation.
+ * @param creaseAngle : radians angle above which an edge is a crease.
+ * @return SmoothingGroups
+ */
+SmoothingGroups computeSmoothingGroups(TriangleMesh &mesh, double creaseAngle);
+
+} // namespace bunny_mesh
+
+#endif // _BUNNY_MESH_SMOOTHING_GROUPS_
@@ -0,0 +1,116 @@
+/**
+ * @file Subdivision.h
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Midpoint and Loop subdivision kernels, with the topology and normals of a level derived from its parent.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#ifndef _BUNNY_MESH_SUBDIVISION_
+#define _BUNNY_MESH_SUBDIVISION_
+
+#include "data_io.h"
+#include "Topology.h"
+
+namespace bunny_mesh
+{
+/**
+ * @brief Rule placing the vertices of a subdivided mesh; both split every face in 4.
+ *
+ *      - Midpoint: parent vertices stay, edge vertices are the edge midpoints, the surface does not change;
+ *      - Loop: parent vertices and edge vertices are weighted averages of their neighbours (Loop, "Smooth
+ *        Subdivision Surfaces Based on Triangles"), converging to a smooth surface. Edges with one face or more
+ *        than two are creases, subdivided as curves; vertices with other than zero or two crease edges stay.
+ */
+enum class SubdivisionScheme
+{
+  Midpoint,
+  Loop
+};
+
+/**
+ * @brief Compute the vertices [begin, end) of the subdivided mesh, thread safe.
+ *
+ * Vertices of the subdivided mesh are the parent vertices, then one vertex per parent edge, by edge index.
+ *
+ * @param vertices : parent vertices, size (num_vertices, 3).
+ * @param faces : parent faces, size (num_faces, 3).
+ * @param edges : edge table of the parent faces.
+ * @param adjacency : vertex to face adjacency of the parent faces, only read by the Loop scheme.
+ * @param out : row major output, 3 * (end - begin) doubles.
+ */
+void subdivideVertices(SubdivisionScheme scheme, const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &vertices,
+                       const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces, const EdgeTable &edges,
+                       const VertexFaceAdjacency &adjacency, size_t begin, size_t end, double *out);
+
+/**
+ * @brief Compute the faces [begin, end) of the subdivided mesh, thread safe.
+ *
+ * Face f of the parent becomes faces 4 f to 4 f + 3: the corner faces of its corners 0, 1 and 2, each keeping its
+ * parent corner at the same position, then the center face joining its edge vertices.
+ *
+ * @param faces : parent faces, size (num_faces, 3).
+ * @param edges : edge table of the parent faces.
+ * @param num_vertices : number of parent vertices.
+ * @param out : row major output, 3 * (end - begin) vertex indexes.
+ */
+void subdivideFaces(const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces, const EdgeTable &edges,
+                    size_t num_vertices, size_t begin, size_t end, int *out);
+
+/**
+ * @brief Edge table of the subdivided mesh, derived from the parent one without hashing.
+ *
+ * Each parent edge splits in two edges, 2 e from its lowest end and 2 e + 1 from the other, and each parent face
+ * adds the three edges of its center face, joining the vertices of its edges k and k + 1, numbered from
+ * 2 num_edges by face and k. Faces repeated over the same three vertices share their center edges, numbered once
+ * for the first of them. All of them, their faces and the edges of the subdivided faces follow from the parent
+ * table, in parallel.
+ *
+ * @param faces : parent faces, size (num_faces, 3).
+ * @param edges : edge table of the parent faces.
+ * @param num_vertices : number of parent vertices.
+ * @return EdgeTable : the same edges as buildEdgeTable() on the subdivided faces, numbered differently.
+ */
+EdgeTable subdivideEdgeTable(const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces, const EdgeTable &edges,
+                             size_t num_vertices);
+
+/**
+ * @brief Vertex to face adjacency of the subdivided mesh, derived from the parent topology.
+ *
+ * @param faces : parent faces, size (num_faces, 3).
+ * @param edges : edge table of the parent faces.
+ * @param adjacency : vertex to face adjacency of the parent faces.
+ * @return VertexFaceAdjacency : identical to buildVertexFaceAdjacency() on the subdivided faces.
+ */
+VertexFaceAdjacency subdivideVertexFaceAdjacency(const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces,
+                                                 const EdgeTable &edges, const VertexFaceAdjacency &adjacency);
+
+/**
+ * @brief Normals of a midpoint subdivided mesh, derived from the parent normals instead of recomputed.
+ *
+ * Midpoint subdivision does not move the surface: every subdivided face has the normal of its parent and a
+ * quarter of its area. So parent vertices keep their normal, and an edge vertex gets the area weighted sum of the
+ * parent faces around its edge. Only the parent face areas are computed, one cross product per parent face where
+ * a recomputation takes one per subdivided face and sums every face of every vertex. Results match
+ * computeMeshNormals() on the subdivided mesh up to rounding.
+ *
+ * @param vertices : parent vertices, size (num_vertices, 3).
+ * @param faces : parent faces, size (num_faces, 3).
+ * @param edges : edge table of the parent faces.
+ * @param faceNormals : parent face normals, size (num_faces, 3).
+ * @param verticesNormals : parent vertices normals, size (num_vertices, 3).
+ * @param subdividedFaceNormals : output face normals, size (4 * num_faces, 3).
+ * @param subdividedVerticesNormals : output vertices normals, size (num_vertices + num_edges, 3).
+ */
+void propagateMidpointNormals(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &vertices,
+                              const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces, const EdgeTable &edges,
+                              const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &faceNormals,
+                              const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &verticesNormals,
+                              Eigen::Ref<bunny_dataIO::Point3DMatrixType> subdividedFaceNormals,
+                              Eigen::Ref<bunny_dataIO::Point3DMatrixType> subdividedVerticesNormals);
+
+} // namespace bunny_mesh
+
+#endif // _BUNNY_MESH_SUBDIVISION_
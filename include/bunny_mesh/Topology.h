@@ -0,0 +1,101 @@
+/**
+ * @file Topology.h
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Connectivity structures derived from the faces of a triangle mesh.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#ifndef _BUNNY_MESH_TOPOLOGY_
+#define _BUNNY_MESH_TOPOLOGY_
+
+#include "data_io.h"
+
+#include <vector>
+
+namespace bunny_mesh
+{
+/**
+ * @brief Vertex to face adjacency in compressed sparse row format.
+ *
+ * A face corner is identified by 3 * face + k, where k is the position of the vertex in the face row.
+ * The corners incident to vertex v are corners[offsets[v]] ... corners[offsets[v + 1] - 1],
+ * sorted by increasing face index.
+ */
+struct VertexFaceAdjacency
+{
+  // Offsets of each vertex in corners, size (num_vertices + 1)
+  std::vector<int> offsets;
+
+  // Incident face corners of each vertex, size (3 * num_faces)
+  std::vector<int> corners;
+
+  /**
+   * @brief Number of faces incident to a vertex.
+   */
+  inline int valence(int vertex) const { return offsets[vertex + 1] - offsets[vertex]; }
+};
+
+/**
+ * @brief Build the vertex to face adjacency of a mesh.
+ *
+ * Built with a parallel counting sort: each thread counts the corners of its chunk of faces,
+ * then writes them at offsets that keep the face order inside each vertex.
+ *
+ * @param faces : faces vertices indexes, size (num_faces, 3).
+ * @param num_vertices : number of vertices of the mesh.
+ * @return VertexFaceAdjacency
+ */
+VertexFaceAdjacency buildVertexFaceAdjacency(const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces,
+                                             size_t num_vertices);
+
+/**
+ * @brief Undirected edges of a triangle mesh, with the faces around each edge in compressed sparse row format.
+ *
+ * Edge k of a face joins its corners k and (k + 1) % 3. The faces of edge e are faces[offsets[e]] ...
+ * faces[offsets[e + 1] - 1], sorted by increasing face index: one face on a border, two inside, more on a non
+ * manifold edge.
+ */
+struct EdgeTable
+{
+  // Edge ends, lowest vertex index first, size (num_edges, 2)
+  Eigen::Matrix<int, Eigen::Dynamic, 2, Eigen::RowMajor> ends;
+
+  // Edges of each face, size (num_faces, 3)
+  bunny_dataIO::IndexMatrixType face_edges;
+
+  // Offsets of each edge in faces, size (num_edges + 1)
+  std::vector<int> offsets;
+
+  // Faces around each edge, size (3 * num_faces)
+  std::vector<int> faces;
+
+  /**
+   * @brief Number of edges.
+   */
+  inline size_t size() const { return ends.rows(); }
+
+  /**
+   * @brief Number of faces around an edge.
+   */
+  inline int valence(int edge) const { return offsets[edge + 1] - offsets[edge]; }
+};
+
+/**
+ * @brief Build the edge table of a mesh.
+ *
+ * Face corners insert their edge in an open addressing hash table of vertex pairs, in parallel with atomic
+ * compare and swap. Each edge is then numbered after the first face corner that references it, so edge indexes
+ * follow the faces order and do not depend on the number of threads.
+ *
+ * @param faces : faces vertices indexes, size (num_faces, 3), without a repeated vertex in a face.
+ * @param num_vertices : number of vertices of the mesh.
+ * @return EdgeTable
+ */
+EdgeTable buildEdgeTable(const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces, size_t num_vertices);
+
+} // namespace bunny_mesh
+
+#endif // _BUNNY_MESH_TOPOLOGY_
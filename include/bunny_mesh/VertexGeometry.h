@@ -0,0 +1,81 @@
+/**
+ * @file VertexGeometry.h
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Per vertex tangent frames and discrete curvatures, computed with the normals in one pass over the faces.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#ifndef _BUNNY_MESH_VERTEX_GEOMETRY_
+#define _BUNNY_MESH_VERTEX_GEOMETRY_
+
+#include "data_io.h"
+#include "Mesh.h"
+
+namespace bunny_mesh
+{
+/**
+ * @brief Differential geometry of the vertices of a triangle mesh, in world coordinates.
+ *
+ * Curvatures follow Meyer et al., "Discrete Differential-Geometry Operators for Triangulated 2-Manifolds":
+ *      - mean curvature from the cotangent Laplacian, H = -(L . n) / (4 A), positive on a sphere with outward normals;
+ *      - Gaussian curvature from the angle defect, K = (2 pi - sum of the corner angles) / A;
+ * where A is the mixed Voronoi area of the vertex. Boundary vertices use the interior formulas.
+ *
+ * The mesh has no texture coordinates, so tangent frames are the continuous orthonormal basis of the vertex normal
+ * of Duff et al., "Building an Orthonormal Basis, Revisited": (tangent, bitangent, normal) is right handed.
+ *
+ * Vertices without faces get not a number values, like their normals in TriangleMesh::ComputeNormals().
+ */
+struct VertexGeometry
+{
+  // Normalized face normals, size (num_faces, 3)
+  bunny_dataIO::Point3DMatrixType face_normals;
+
+  // Normalized vertex normals, size (num_vertices, 3)
+  bunny_dataIO::Point3DMatrixType vertices_normals;
+
+  // Unit tangents, orthogonal to the vertex normals, size (num_vertices, 3)
+  bunny_dataIO::Point3DMatrixType tangents;
+
+  // Unit bitangents, normal x tangent, size (num_vertices, 3)
+  bunny_dataIO::Point3DMatrixType bitangents;
+
+  // Mixed Voronoi area of each vertex, size (num_vertices)
+  Eigen::VectorXd vertex_areas;
+
+  // Signed mean curvature, size (num_vertices)
+  Eigen::VectorXd mean_curvature;
+
+  // Gaussian curvature, size (num_vertices)
+  Eigen::VectorXd gaussian_curvature;
+};
+
+/**
+ * @brief Compute normals, tangent frames and curvatures of raw mesh arrays in a single traversal of the faces.
+ *
+ * Each face computes its edges, cross product, corner cotangents and angles once, and accumulates into the
+ * 8 doubles (one cache line) of each of its vertices: normal sum, cotangent Laplacian, angle sum and area.
+ * Faces are split in chunks processed in parallel with private accumulators, then vertices are reduced and
+ * finalized in parallel, as in computeMeshNormals().
+ *
+ * @param verticesWorld : vertices in world coordinates, size (num_vertices, 3).
+ * @param faces : faces vertices indexes, size (num_faces, 3).
+ * @param geometry : outputs, resized if needed so that repeated calls reuse their buffers.
+ */
+void computeVertexGeometry(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &verticesWorld,
+                           const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces, VertexGeometry &geometry);
+
+/**
+ * @brief Compute normals, tangent frames and curvatures of a mesh at its current orientation.
+ *
+ * @param mesh : triangle mesh.
+ * @return VertexGeometry
+ */
+VertexGeometry computeVertexGeometry(const TriangleMesh &mesh);
+
+} // namespace bunny_mesh
+
+#endif // _BUNNY_MESH_VERTEX_GEOMETRY_
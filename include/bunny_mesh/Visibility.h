@@ -0,0 +1,91 @@
+/**
+ * @file Visibility.h
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Front and back facing classification of the faces of a mesh for batches of view directions.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#ifndef _BUNNY_MESH_VISIBILITY_
+#define _BUNNY_MESH_VISIBILITY_
+
+#include "data_io.h"
+#include "Mesh.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace bunny_mesh
+{
+/**
+ * @brief Front facing faces of each view, packed 64 faces per word.
+ *
+ * Face f of view v is bit f % 64 of words[v * words_per_view + f / 64]. Bits past the last face are zero.
+ */
+struct VisibilityMasks
+{
+  size_t num_faces = 0;
+  size_t num_views = 0;
+
+  // Words of the mask of one view, (num_faces + 63) / 64
+  size_t words_per_view = 0;
+
+  // Masks of the views, one after the other, size (num_views * words_per_view)
+  std::vector<uint64_t> words;
+
+  /**
+   * @brief Whether a face faces a view.
+   */
+  inline bool isFrontFacing(size_t view, size_t face) const
+  {
+    return (words[view * words_per_view + face / 64] >> (face % 64)) & 1u;
+  }
+
+  /**
+   * @brief Mask of a view, words_per_view words.
+   */
+  inline const uint64_t *view(size_t view) const { return words.data() + view * words_per_view; }
+
+  /**
+   * @brief Number of front facing faces of a view.
+   */
+  size_t count(size_t view) const;
+};
+
+/**
+ * @brief Classify the faces of a mesh as front or back facing for each of a batch of view directions.
+ *
+ * A view direction is the direction a distant camera looks along, in world coordinates: a face is front facing when
+ * normal . direction < 0. Faces seen edge on, and faces without a normal (not a number), are back facing.
+ *
+ * The work is the (num_faces, 3) x (3, num_views) product of the normals by the directions, taken by blocks: the
+ * normals of a block of faces are transposed into x, y and z arrays that stay in the L1 cache, then each view
+ * computes the dot products of the block 2 faces at a time with SSE2 and packs their signs with movemask, with a
+ * scalar fallback elsewhere. Normals are read from memory once for all the views, and blocks of faces run in
+ * parallel, each writing its own words of every mask. Dot products are (x * dx + y * dy) + z * dz in both paths,
+ * so the masks do not depend on the instruction set nor on the number of threads.
+ *
+ * @param faceNormals : face normals in world coordinates, size (num_faces, 3). They need not be normalized.
+ * @param viewDirections : view directions in world coordinates, size (num_views, 3). They need not be normalized.
+ * @param masks : output, resized if needed so that repeated calls reuse its buffer.
+ */
+void classifyFrontFaces(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &faceNormals,
+                        const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &viewDirections,
+                        VisibilityMasks &masks);
+
+/**
+ * @brief Classify the faces of a mesh at its current orientation, from the face normals of its last
+ * ComputeNormals(), read without a copy. Throws std::invalid_argument when the normals are not computed, or stale
+ * since a change of the mesh.
+ *
+ * @param viewDirections : view directions in world coordinates, size (num_views, 3).
+ * @return VisibilityMasks
+ */
+VisibilityMasks classifyFrontFaces(const TriangleMesh &mesh,
+                                   const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &viewDirections);
+
+} // namespace bunny_mesh
+
+#endif // _BUNNY_MESH_VISIBILITY_
@@ -0,0 +1,60 @@
+/**
+ * @file Weld.h
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Vertex welding: merge duplicated vertices and rewrite the faces accordingly.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#ifndef _BUNNY_MESH_WELD_
+#define _BUNNY_MESH_WELD_
+
+#include "data_io.h"
+
+#include <vector>
+
+namespace bunny_mesh
+{
+/**
+ * @brief Result of a vertex welding.
+ */
+struct WeldResult
+{
+  // Welded vertices, in order of first occurrence in the input, size (num_welded, 3)
+  bunny_dataIO::Point3DMatrixType vertices;
+
+  // Input faces rewritten with welded vertices indexes, size (num_faces, 3)
+  bunny_dataIO::IndexMatrixType faces;
+
+  // Welded vertex index of each input vertex, size (num_vertices)
+  std::vector<int> remap;
+};
+
+/**
+ * @brief Merge vertices closer than a tolerance, as a preprocessing stage before TriangleMesh::ComputeNormals().
+ *
+ * Duplicated vertices split the vertex normals of scans along seams, since faces on each side only accumulate
+ * into their own copy. Welding them makes the faces share a vertex again.
+ *
+ * Vertices are indexed in a spatial hash of cells a few times the tolerance size, split into shards that are built
+ * in parallel without locks (each shard is owned by one thread). Each vertex is then attached, in parallel, to the
+ * smallest index vertex within the tolerance found in its cell and the neighbour cells it is close to, and clusters
+ * are resolved in index order. The result is deterministic whatever the number of threads, and each welded vertex keeps the position
+ * of its first occurrence.
+ *
+ * With a zero tolerance only vertices at exactly the same position are merged.
+ * Faces are only rewritten: faces whose vertices were merged together become degenerate but are kept.
+ *
+ * @param vertices : input vertices, size (num_vertices, 3).
+ * @param faces : input faces, size (num_faces, 3).
+ * @param tolerance : maximal distance between merged vertices.
+ * @return WeldResult
+ */
+WeldResult weldVertices(const bunny_dataIO::Point3DMatrixType &vertices, const bunny_dataIO::IndexMatrixType &faces,
+                        double tolerance = 0.0);
+
+} // namespace bunny_mesh
+
+#endif // _BUNNY_MESH_WELD_
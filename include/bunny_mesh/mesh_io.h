@@ -0,0 +1,254 @@
+/**
+ * @file mesh_io.h
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Native readers and writers of binary PLY, binary STL and ASCII OBJ triangle meshes.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#ifndef _BUNNY_MESH_IO_
+#define _BUNNY_MESH_IO_
+
+#include "data_io.h"
+
+#include <cstddef>
+#include <string>
+
+namespace bunny_dataIO
+{
+/**
+ * @brief Triangle mesh read from a file.
+ *
+ * Normals are only filled when the file provides them, otherwise they are empty (zero rows).
+ */
+struct MeshData
+{
+  // Vertices, size (num_vertices, 3)
+  Point3DMatrixType vertices;
+
+  // Faces vertices indexes, size (num_faces, 3). Polygons are split in triangle fans.
+  IndexMatrixType faces;
+
+  // Vertex normals, size (num_vertices, 3) or empty
+  Point3DMatrixType vertices_normals;
+
+  // Face normals, size (num_faces, 3) or empty
+  Point3DMatrixType face_normals;
+};
+
+/**
+ * @brief Read a binary (little or big endian) PLY file.
+ *
+ * Vertex properties x, y, z and nx, ny, nz are read whatever their numeric type, other properties and elements
+ * are skipped. Faces are read from the vertex_indices (or vertex_index) list of the face element.
+ * The file is memory mapped and decoded in parallel when faces are all triangles.
+ *
+ * @param filename : path to the PLY file.
+ * @return MeshData : vertices, faces and vertex normals if present.
+ */
+MeshData readPLY(const std::string &filename);
+
+/**
+ * @brief Read a binary STL file.
+ *
+ * STL stores each triangle with its own copy of the vertices, which splits every vertex normal.
+ * Copies are merged back by an exact weld (see bunny_mesh::weldVertices()) unless weld is false.
+ *
+ * @param filename : path to the STL file.
+ * @param weld : merge vertices at exactly the same position.
+ * @return MeshData : vertices, faces and the face normals stored in the file.
+ */
+MeshData readSTL(const std::string &filename, bool weld = true);
+
+/**
+ * @brief Read an ASCII OBJ file.
+ *
+ * Only v, vn and f statements are used. The file is split in chunks of lines parsed in parallel, with a fast
+ * float conversion falling back to strtod() when the fast path would not be exact.
+ * Negative (relative) indexes are supported. Vertex normals are given to the vertices through the normal indexes of
+ * the faces (v//vn or v/vt/vn), whatever the order of the vn statements. They are only kept when no vertex has
+ * different normals in different faces, vertices without a normal index having not a number normals.
+ *
+ * @param filename : path to the OBJ file.
+ * @return MeshData : vertices, faces and vertex normals if present.
+ */
+MeshData readOBJ(const std::string &filename);
+
+/**
+ * @brief Read a mesh in any of the supported formats, chosen by the file extension (.ply, .stl or .obj).
+ *
+ * @param filename : path to the mesh file.
+ * @return MeshData
+ */
+MeshData readMesh(const std::string &filename);
+
+/**
+ * @brief Write a binary PLY file in the host endianness, with double precision vertices.
+ *
+ * @param filename : path to the PLY file.
+ * @param vertices : vertices, size (num_vertices, 3).
+ * @param faces : faces, size (num_faces, 3).
+ * @param verticesNormals : vertex normals, size (num_vertices, 3), or empty to write positions only.
+ */
+void writePLY(const std::string &filename, const Point3DMatrixType &vertices, const IndexMatrixType &faces,
+              const Point3DMatrixType &verticesNormals = Point3DMatrixType());
+
+/**
+ * @brief Write a binary STL file. STL stores single precision floats only.
+ *
+ * @param filename : path to the STL file.
+ * @param vertices : vertices, size (num_vertices, 3).
+ * @param faces : faces, size (num_faces, 3).
+ * @param faceNormals : face normals, size (num_faces, 3), or empty to write the normals of the triangles.
+ */
+void writeSTL(const std::string &filename, const Point3DMatrixType &vertices, const IndexMatrixType &faces,
+              const Point3DMatrixType &faceNormals = Point3DMatrixType());
+
+/**
+ * @brief Write an ASCII OBJ file, with enough digits to read back the same doubles.
+ *
+ * Chunks of lines are formatted in parallel and written in order.
+ *
+ * @param filename : path to the OBJ file.
+ * @param vertices : vertices, size (num_vertices, 3).
+ * @param faces : faces, size (num_faces, 3).
+ * @param verticesNormals : vertex normals, size (num_vertices, 3), or empty to write positions only.
+ */
+void writeOBJ(const std::string &filename, const Point3DMatrixType &vertices, const IndexMatrixType &faces,
+              const Point3DMatrixType &verticesNormals = Point3DMatrixType());
+
+/**
+ * @brief Write a mesh in any of the supported formats, chosen by the file extension (.ply, .stl or .obj).
+ *
+ * @param verticesNormals : vertex normals (PLY and OBJ), or empty.
+ * @param faceNormals : face normals (STL), or empty.
+ */
+void writeMesh(const std::string &filename, const Point3DMatrixType &vertices, const IndexMatrixType &faces,
+               const Point3DMatrixType &verticesNormals = Point3DMatrixType(),
+               const Point3DMatrixType &faceNormals = Point3DMatrixType());
+
+/**
+ * @brief Scalar types of the numpy arrays read by NumpyArrayReader and written by NumpyArrayWriter, in the host
+ * endianness.
+ */
+enum class NumpyType
+{
+  Float64,
+  Int32,
+  Float32
+};
+
+/**
+ * @brief Numpy array file of (rows, cols) scalars written by blocks of rows at explicit offsets.
+ *
+ * The header is written by the constructor, then blocks may be written in any order and from several threads at
+ * once, so arrays larger than the memory are streamed to the disk without ever being held whole. Rows never written
+ * read back as zeros. The files are read back by NumpyArrayReader, and float64 and int32 ones by
+ * readFloatNumPyArray() and readIntNumPyArray().
+ */
+class NumpyArrayWriter
+{
+public:
+  /**
+   * @brief Create (or truncate) the file and write the header of the array.
+   *
+   * @param filename : path to the numpy file. Usual extension: '.npy'
+   * @param type : scalar type of the array.
+   * @param rows : number of rows of the array.
+   * @param cols : number of columns of the array.
+   */
+  NumpyArrayWriter(const std::string &filename, NumpyType type, size_t rows, size_t cols);
+
+  /**
+   * @brief Create (or truncate) the file and write the header of a (frames, rows, cols) array, such as a sequence
+   * of frames of vertices. Its rows are written as frames * rows rows, frame after frame.
+   */
+  NumpyArrayWriter(const std::string &filename, NumpyType type, size_t frames, size_t rows, size_t cols);
+  ~NumpyArrayWriter();
+
+  NumpyArrayWriter(const NumpyArrayWriter &) = delete;
+  NumpyArrayWriter &operator=(const NumpyArrayWriter &) = delete;
+
+  /**
+   * @brief Write count rows from firstRow, thread safe. The scalar type must be the one of the array.
+   *
+   * @param firstRow : index of the first row written.
+   * @param data : row major rows, count * cols scalars.
+   * @param count : number of rows written.
+   */
+  void writeRows(size_t firstRow, const double *data, size_t count) const;
+  void writeRows(size_t firstRow, const int *data, size_t count) const;
+  void writeRows(size_t firstRow, const float *data, size_t count) const;
+
+  inline size_t rows() const { return numRows; }
+
+private:
+  void create(const std::string &filename, const std::string &shape);
+  void writeBytes(size_t firstRow, const void *data, size_t count, NumpyType dataType) const;
+
+  int fd;
+  NumpyType type;
+  size_t numRows;
+  size_t numCols;
+  size_t headerSize;
+};
+
+/**
+ * @brief Numpy array file of (rows, cols) scalars read by blocks of rows, straight into the caller buffers.
+ *
+ * Only the header is read by the constructor. Unlike readFloatNumPyArray() and readIntNumPyArray(), which load the
+ * whole file into a buffer then copy it into the matrix, rows are read where they go, so a matrix is read at the
+ * cost of its own size, and arrays larger than the memory are read by blocks. Reads are thread safe. Arrays must be
+ * in C order and in the host endianness, two dimensional or three dimensional: a (frames, rows, cols) array is read
+ * as frames * rows rows, frame after frame.
+ */
+class NumpyArrayReader
+{
+public:
+  /**
+   * @brief Open the file and read the header of the array.
+   *
+   * @param filename : path to the numpy file. Usual extension: '.npy'
+   */
+  explicit NumpyArrayReader(const std::string &filename);
+  ~NumpyArrayReader();
+
+  NumpyArrayReader(const NumpyArrayReader &) = delete;
+  NumpyArrayReader &operator=(const NumpyArrayReader &) = delete;
+
+  /**
+   * @brief Read count rows from firstRow, thread safe. The scalar type must be the one of the array.
+   *
+   * @param firstRow : index of the first row read.
+   * @param data : row major output, count * cols scalars.
+   * @param count : number of rows read.
+   */
+  void readRows(size_t firstRow, double *data, size_t count) const;
+  void readRows(size_t firstRow, int *data, size_t count) const;
+  void readRows(size_t firstRow, float *data, size_t count) const;
+
+  inline NumpyType type() const { return arrayType; }
+  inline size_t rows() const { return numRows; }
+  inline size_t cols() const { return numCols; }
+
+  /**
+   * @brief First dimension of a three dimensional array, 1 for a two dimensional one.
+   */
+  inline size_t frames() const { return numFrames; }
+
+private:
+  void readBytes(size_t firstRow, void *data, size_t count, NumpyType dataType) const;
+
+  int fd;
+  NumpyType arrayType;
+  size_t numFrames;
+  size_t numRows;
+  size_t numCols;
+  size_t headerSize;
+};
+
+} // namespace bunny_dataIO
+
+#endif // _BUNNY_MESH_IO_
@@ -0,0 +1,188 @@
+/**
+ * @file parallel.h
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Minimal thread helpers shared by the parallel stages of the Bunny Mesh Normals project.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#ifndef _BUNNY_MESH_PARALLEL_
+#define _BUNNY_MESH_PARALLEL_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace bunny_mesh
+{
+namespace parallel
+{
+
+/**
+ * @brief Storage of the user requested number of threads. Zero means "use every hardware thread".
+ */
+inline std::atomic<unsigned> &threadCountSetting()
+{
+    static std::atomic<unsigned> setting(0);
+    return setting;
+}
+
+/**
+ * @brief Set the number of worker threads used by every parallel stage.
+ *
+ * @param threads : number of threads, zero restores the hardware default.
+ */
+inline void setNumThreads(unsigned threads) { threadCountSetting().store(threads); }
+
+/**
+ * @brief Whether the parallel stages started by the calling thread run on that thread only, see SerialRegion.
+ */
+inline bool &serialThread()
+{
+    static thread_local bool serial = false;
+    return serial;
+}
+
+/**
+ * @brief Scope in which the parallel stages started by the calling thread run on that thread only.
+ *
+ * Used by callers already running one task per thread, whose tasks would otherwise each start numThreads() more.
+ */
+class SerialRegion
+{
+public:
+  explicit SerialRegion(bool enabled = true) : previous(serialThread()) { serialThread() = previous || enabled; }
+  ~SerialRegion() { serialThread() = previous; }
+
+  SerialRegion(const SerialRegion &) = delete;
+  SerialRegion &operator=(const SerialRegion &) = delete;
+
+private:
+  bool previous;
+};
+
+/**
+ * @brief Number of worker threads used by every parallel stage, one inside a SerialRegion.
+ *
+ * @return unsigned : always at least one.
+ */
+inline unsigned numThreads()
+{
+    if (serialThread())
+    {
+        return 1;
+    }
+    unsigned threads = threadCountSetting().load();
+    if (threads == 0)
+    {
+        threads = std::thread::hardware_concurrency();
+    }
+    return std::max(threads, 1u);
+}
+
+/**
+ * @brief Number of chunks a range of a given size is split into.
+ *
+ * Ranges are never split in chunks smaller than minChunk elements, so small inputs run on the calling thread only.
+ *
+ * @param size : number of elements of the range.
+ * @param minChunk : minimal number of elements per chunk.
+ * @return size_t : number of chunks, between 1 and numThreads().
+ */
+inline size_t chunkCount(size_t size, size_t minChunk = 1024)
+{
+    size_t chunks = size / std::max<size_t>(minChunk, 1);
+    return std::max<size_t>(1, std::min<size_t>(chunks, numThreads()));
+}
+
+/**
+ * @brief Run fn(chunkBegin, chunkEnd, chunkIndex) over numChunks contiguous chunks of [begin, end).
+ *
+ * Chunk boundaries only depend on the range and on numChunks, so callers may keep one accumulator per chunk.
+ * The last chunk runs on the calling thread, as do the chunks whose thread cannot be started. The first exception
+ * thrown by a chunk is rethrown after all chunks joined.
+ *
+ * @tparam Function : callable as fn(size_t, size_t, size_t).
+ */
+template <typename Function>
+inline void parallelForChunks(size_t begin, size_t end, size_t numChunks, Function fn)
+{
+    if (end <= begin)
+    {
+        return;
+    }
+    numChunks = std::max<size_t>(1, std::min(numChunks, end - begin));
+    if (numChunks == 1)
+    {
+        fn(begin, end, size_t(0));
+        return;
+    }
+    const size_t size = end - begin;
+    std::vector<std::exception_ptr> errors(numChunks);
+    std::vector<std::thread> workers;
+    workers.reserve(numChunks - 1);
+    for (size_t chunk = 0; chunk < numChunks; chunk++)
+    {
+        size_t chunkBegin = begin + size * chunk / numChunks;
+        size_t chunkEnd = begin + size * (chunk + 1) / numChunks;
+        auto task = [&fn, &errors, chunkBegin, chunkEnd, chunk]() {
+            try
+            {
+                fn(chunkBegin, chunkEnd, chunk);
+            }
+            catch (...)
+            {
+                errors[chunk] = std::current_exception();
+            }
+        };
+        if (chunk + 1 < numChunks)
+        {
+            try
+            {
+                workers.emplace_back(task);
+                continue;
+            }
+            catch (...)
+            {
+                // a thread that cannot be started (std::system_error, std::bad_alloc) leaves its chunk to the
+                // calling thread, the started workers are still joined below
+            }
+        }
+        task();
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+    for (auto &error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+/**
+ * @brief Run fn(chunkBegin, chunkEnd) over [begin, end) using up to numThreads() threads.
+ *
+ * @tparam Function : callable as fn(size_t, size_t).
+ * @param minChunk : minimal number of elements per thread.
+ */
+template <typename Function>
+inline void parallelFor(size_t begin, size_t end, Function fn, size_t minChunk = 1024)
+{
+    size_t size = end > begin ? end - begin : 0;
+    parallelForChunks(begin, end, chunkCount(size, minChunk),
+                      [&fn](size_t chunkBegin, size_t chunkEnd, size_t) { fn(chunkBegin, chunkEnd); });
+}
+
+} // namespace parallel
+} // namespace bunny_mesh
+
+#endif // _BUNNY_MESH_PARALLEL_
@@ -0,0 +1,130 @@
+/**
+ * @file bunny_mesh_module.cc
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Python bindings of the Bunny Mesh Normals project, sharing numpy buffers with the C++ kernels.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "bunny_mesh/data_io.h"
+#include "bunny_mesh/Mesh.h"
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include <string>
+
+namespace py = pybind11;
+
+namespace
+{
+using VerticesArray = py::array_t<double, py::array::c_style>;
+using FacesArray = py::array_t<int, py::array::c_style>;
+using VerticesMap = Eigen::Map<const bunny_dataIO::Point3DMatrixType>;
+using FacesMap = Eigen::Map<const bunny_dataIO::IndexMatrixType>;
+using NormalsMap = Eigen::Map<bunny_dataIO::Point3DMatrixType>;
+
+/**
+ * @brief Check that an array can be mapped as a (rows, 3) row major Eigen matrix, without any conversion.
+ *
+ * Converting would silently copy the array, and in place updates of the caller would not be seen by the mesh.
+ */
+template <typename Array>
+Array checkedArray(const py::array &array, const std::string &name, const std::string &dtype)
+{
+    if (!py::isinstance<Array>(array) || array.ndim() != 2 || array.shape(1) != 3)
+    {
+        throw py::value_error("Mesh Error: " + name + " must be a C contiguous " + dtype + " array of shape (N, 3)");
+    }
+    return py::reinterpret_borrow<Array>(array);
+}
+
+/**
+ * @brief Triangle mesh over numpy arrays owned by Python.
+ *
+ * Vertices and faces are the caller arrays themselves, so updating them in place between two ComputeNormals()
+ * calls needs no copy nor any call to the mesh. Normals are stored in numpy arrays owned by the mesh, returned
+ * as they are: they are overwritten in place by each ComputeNormals() call.
+ */
+class PyTriangleMesh
+{
+public:
+    PyTriangleMesh(const py::array &vertices, const py::array &faces)
+        : vertices(checkedArray<VerticesArray>(vertices, "vertices", "float64")),
+          faces(checkedArray<FacesArray>(faces, "faces", "int32")),
+          face_normals(std::vector<py::ssize_t>{faces.shape(0), 3}),
+          vertices_normals(std::vector<py::ssize_t>{vertices.shape(0), 3}),
+          orientation(0, 0, 1)
+    {
+    }
+
+    void ComputeNormals()
+    {
+        VerticesMap verticesMap(vertices.data(), vertices.shape(0), 3);
+        FacesMap facesMap(faces.data(), faces.shape(0), 3);
+        NormalsMap faceNormalsMap(face_normals.mutable_data(), face_normals.shape(0), 3);
+        NormalsMap verticesNormalsMap(vertices_normals.mutable_data(), vertices_normals.shape(0), 3);
+
+        // buffers are referenced by the mesh, they stay alive while the interpreter runs other threads
+        py::gil_scoped_release release;
+        // faces are the caller array, so they may have changed since the construction
+        if (facesMap.size() > 0 && (facesMap.minCoeff() < 0 || facesMap.maxCoeff() >= verticesMap.rows()))
+        {
+            throw py::index_error("Mesh Error: face index out of vertices range");
+        }
+        if (orientation == bunny_dataIO::Point3DType(0, 0, 1))
+        {
+            bunny_mesh::computeMeshNormals(verticesMap, facesMap, faceNormalsMap, verticesNormalsMap);
+        }
+        else
+        {
+            bunny_dataIO::Point3DMatrixType verticesWorld = verticesMap * bunny_mesh::orientationRotation(orientation);
+            bunny_mesh::computeMeshNormals(verticesWorld, facesMap, faceNormalsMap, verticesNormalsMap);
+        }
+    }
+
+    py::tuple getOrientation() const { return py::make_tuple(orientation(0), orientation(1), orientation(2)); }
+
+    void setOrientation(double x, double y, double z) { orientation = bunny_dataIO::Point3DType(x, y, z).normalized(); }
+
+    VerticesArray vertices;
+    FacesArray faces;
+    py::array_t<double> face_normals;
+    py::array_t<double> vertices_normals;
+
+private:
+    bunny_dataIO::Point3DType orientation;
+};
+} // namespace
+
+PYBIND11_MODULE(bunny_mesh, m)
+{
+    m.doc() = "Face and vertex normals of triangle meshes, computed over numpy arrays without copies.";
+
+    py::class_<PyTriangleMesh>(m, "TriangleMesh")
+        .def(py::init<const py::array &, const py::array &>(), py::arg("vertices"), py::arg("faces"),
+             "Build a mesh over a float64 (N, 3) vertices array and an int32 (M, 3) faces array, both C "
+             "contiguous. Arrays are referenced, not copied.")
+        .def("ComputeNormals", &PyTriangleMesh::ComputeNormals,
+             "Compute the normalized face and vertex normals into face_normals and vertices_normals. "
+             "The GIL is released during the computation.")
+        .def_readonly("vertices", &PyTriangleMesh::vertices, "Vertices array given at construction.")
+        .def_readonly("faces", &PyTriangleMesh::faces, "Faces array given at construction.")
+        .def_readonly("face_normals", &PyTriangleMesh::face_normals,
+                      "Face normals (M, 3), overwritten in place by each ComputeNormals() call.")
+        .def_readonly("vertices_normals", &PyTriangleMesh::vertices_normals,
+                      "Vertex normals (N, 3), overwritten in place by each ComputeNormals() call.")
+        .def_property(
+            "orientation", &PyTriangleMesh::getOrientation,
+            [](PyTriangleMesh &mesh, const py::tuple &orientation) {
+                if (orientation.size() != 3)
+                {
+                    throw py::value_error("Mesh Error: orientation must have 3 components");
+                }
+                mesh.setOrientation(orientation[0].cast<double>(), orientation[1].cast<double>(),
+                                    orientation[2].cast<double>());
+            },
+            "Object orientation, (0, 0, 1) by default. Other orientations compute normals from a rotated copy.");
+}
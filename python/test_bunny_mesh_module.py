@@ -0,0 +1,79 @@
+"""Unitest module for the bunny_mesh Python module.
+
+Run by ctest, with the module folder in PYTHONPATH:
+    PYTHONPATH=build/lib python3 python/test_bunny_mesh_module.py
+"""
+import os
+import unittest
+
+import numpy as np
+
+import bunny_mesh
+
+DATA = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'data')
+
+
+def load(name):
+    return np.load(os.path.join(DATA, name))
+
+
+class TriangleMeshTest(unittest.TestCase):
+
+    def setUp(self):
+        self.vertices = load('bunny_vertices.npy')
+        self.faces = load('bunny_faces.npy').astype(np.int32)
+
+    def test_matches_reference_normals(self):
+        mesh = bunny_mesh.TriangleMesh(self.vertices, self.faces)
+        mesh.ComputeNormals()
+        # the reference files are written by the bunny_mesh_normals application
+        np.testing.assert_allclose(mesh.face_normals, load('face_normals.npy'), rtol=0, atol=1e-12)
+        np.testing.assert_allclose(mesh.vertices_normals, load('vertex_normals.npy'), rtol=0, atol=1e-12)
+
+    def test_arrays_are_not_copied(self):
+        mesh = bunny_mesh.TriangleMesh(self.vertices, self.faces)
+        self.assertIs(mesh.vertices, self.vertices)
+        self.assertIs(mesh.faces, self.faces)
+        mesh.ComputeNormals()
+        face_normals = mesh.face_normals
+        vertices_normals = mesh.vertices_normals
+        reference = vertices_normals.copy()
+
+        # a quarter turn around z, in place: the mesh reads the new vertices and overwrites its normals
+        x = self.vertices[:, 0].copy()
+        self.vertices[:, 0] = -self.vertices[:, 1]
+        self.vertices[:, 1] = x
+        mesh.ComputeNormals()
+        self.assertIs(mesh.face_normals, face_normals)
+        self.assertIs(mesh.vertices_normals, vertices_normals)
+        self.assertTrue(np.shares_memory(mesh.vertices_normals, vertices_normals))
+        rotated = np.column_stack((-reference[:, 1], reference[:, 0], reference[:, 2]))
+        np.testing.assert_allclose(vertices_normals, rotated, rtol=0, atol=1e-12)
+
+    def test_rejects_arrays_needing_a_copy(self):
+        with self.assertRaises(ValueError):
+            bunny_mesh.TriangleMesh(self.vertices.astype(np.float32), self.faces)
+        with self.assertRaises(ValueError):
+            bunny_mesh.TriangleMesh(self.vertices, self.faces.astype(np.int64))
+        with self.assertRaises(ValueError):
+            bunny_mesh.TriangleMesh(np.asfortranarray(self.vertices), self.faces)
+        with self.assertRaises(ValueError):
+            bunny_mesh.TriangleMesh(self.vertices[:, :2], self.faces)
+
+    def test_faces_out_of_range(self):
+        mesh = bunny_mesh.TriangleMesh(self.vertices, self.faces)
+        self.faces[0, 0] = len(self.vertices)
+        with self.assertRaises(IndexError):
+            mesh.ComputeNormals()
+
+    def test_orientation(self):
+        mesh = bunny_mesh.TriangleMesh(self.vertices, self.faces)
+        self.assertEqual(mesh.orientation, (0.0, 0.0, 1.0))
+        mesh.orientation = (0.0, 0.0, 2.0)
+        self.assertEqual(mesh.orientation, (0.0, 0.0, 1.0))
+        with self.assertRaises(ValueError):
+            mesh.orientation = (0.0, 1.0)
+
+
+if __name__ == '__main__':
+    unittest.main()
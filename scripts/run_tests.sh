@@ -2,4 +2,9 @@
 
 echo 'Running Bunny Mesh Tests...'
 
-./build/bin/bunny_tests
\ No newline at end of file
+./build/bin/bunny_tests
+
+echo 'Running Bunny Mesh Python Tests...'
+
+# registered only when the Python module was built
+cd build && ctest -R '^python$' --output-on-failure
@@ -0,0 +1,642 @@
+/**
+ * @file BVH.cc
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Source file of BVH.h header file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "bunny_mesh/BVH.h"
+#include "bunny_mesh/parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+namespace bunny_mesh
+{
+namespace
+{
+// Leaves are never split below this number of faces
+const size_t kMinLeafSize = 2;
+// Leaves are always split above this number of faces
+const size_t kMaxLeafSize = 8;
+// Number of SAH bins per axis
+const int kNumBins = 16;
+// Subtrees smaller than this are always built on the current thread
+const size_t kParallelBuildSize = 4096;
+// Beyond this depth SAH splits are replaced by median splits, which bounds the tree depth
+const unsigned kMaxSAHDepth = 64;
+// Maximal traversal stack depth
+const int kStackSize = 128;
+
+// Axis aligned bounding box used during the build
+struct Box
+{
+    Eigen::Vector3d lo = Eigen::Vector3d::Constant(std::numeric_limits<double>::infinity());
+    Eigen::Vector3d hi = Eigen::Vector3d::Constant(-std::numeric_limits<double>::infinity());
+
+    inline void grow(const Eigen::Vector3d &p)
+    {
+        lo = lo.cwiseMin(p);
+        hi = hi.cwiseMax(p);
+    }
+    inline void grow(const Box &b)
+    {
+        lo = lo.cwiseMin(b.lo);
+        hi = hi.cwiseMax(b.hi);
+    }
+    inline double area() const
+    {
+        if (lo(0) > hi(0))
+        {
+            return 0.0;
+        }
+        Eigen::Vector3d d = hi - lo;
+        return 2.0 * (d(0) * d(1) + d(1) * d(2) + d(2) * d(0));
+    }
+};
+
+// Read only data shared by the build recursion
+struct BuildContext
+{
+    const std::vector<Box> &boxes;
+    const std::vector<Eigen::Vector3d> &centroids;
+    std::vector<uint32_t> &order;
+    unsigned parallelDepth;
+};
+
+// rounds a bound outwards so the float box always contains the double box
+inline float roundDown(double value)
+{
+    float f = static_cast<float>(value);
+    return f > value ? std::nextafter(f, -std::numeric_limits<float>::infinity()) : f;
+}
+
+inline float roundUp(double value)
+{
+    float f = static_cast<float>(value);
+    return f < value ? std::nextafter(f, std::numeric_limits<float>::infinity()) : f;
+}
+
+inline MeshBVH::Node makeNode(const Box &box, uint32_t offset, uint32_t count)
+{
+    MeshBVH::Node node;
+    for (int k = 0; k < 3; k++)
+    {
+        node.bounds_min[k] = roundDown(box.lo(k));
+        node.bounds_max[k] = roundUp(box.hi(k));
+    }
+    node.offset = offset;
+    node.count = count;
+    return node;
+}
+
+/**
+ * @brief Builds the subtree of order[begin, end) and appends its nodes, in depth-first order, to out.
+ *
+ * Node offsets are relative to the beginning of out. While depth < parallelDepth the right subtree is built
+ * by another thread in a separate array which is then appended with its offsets shifted.
+ */
+void buildSubtree(BuildContext &ctx, size_t begin, size_t end, unsigned depth, std::vector<MeshBVH::Node> &out)
+{
+    const size_t nodeIndex = out.size();
+    out.push_back(MeshBVH::Node());
+    const size_t count = end - begin;
+
+    Box bounds, centroidBounds;
+    for (size_t i = begin; i < end; i++)
+    {
+        bounds.grow(ctx.boxes[ctx.order[i]]);
+        centroidBounds.grow(ctx.centroids[ctx.order[i]]);
+    }
+
+    if (count <= kMinLeafSize)
+    {
+        out[nodeIndex] = makeNode(bounds, static_cast<uint32_t>(begin), static_cast<uint32_t>(count));
+        return;
+    }
+
+    // binned SAH evaluation over the three axes
+    int bestAxis = -1;
+    int bestBin = 0;
+    double bestCost = std::numeric_limits<double>::infinity();
+    for (int axis = 0; axis < 3; axis++)
+    {
+        const double axisLo = centroidBounds.lo(axis);
+        const double extent = centroidBounds.hi(axis) - axisLo;
+        if (!(extent > 0.0))
+        {
+            continue;
+        }
+        const double scale = kNumBins / extent;
+        Box binBoxes[kNumBins];
+        size_t binCounts[kNumBins] = {0};
+        for (size_t i = begin; i < end; i++)
+        {
+            uint32_t prim = ctx.order[i];
+            int bin = std::min(kNumBins - 1, static_cast<int>((ctx.centroids[prim](axis) - axisLo) * scale));
+            binCounts[bin]++;
+            binBoxes[bin].grow(ctx.boxes[prim]);
+        }
+        // sweep from the right to get the cost of every right side
+        double rightAreas[kNumBins];
+        size_t rightCounts[kNumBins];
+        Box accumulated;
+        size_t accumulatedCount = 0;
+        for (int bin = kNumBins - 1; bin > 0; bin--)
+        {
+            accumulated.grow(binBoxes[bin]);
+            accumulatedCount += binCounts[bin];
+            rightAreas[bin] = accumulated.area();
+            rightCounts[bin] = accumulatedCount;
+        }
+        // then from the left, splitting after each bin
+        accumulated = Box();
+        accumulatedCount = 0;
+        for (int bin = 0; bin < kNumBins - 1; bin++)
+        {
+            accumulated.grow(binBoxes[bin]);
+            accumulatedCount += binCounts[bin];
+            if (accumulatedCount == 0 || rightCounts[bin + 1] == 0)
+            {
+                continue;
+            }
+            double cost = accumulated.area() * accumulatedCount + rightAreas[bin + 1] * rightCounts[bin + 1];
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestAxis = axis;
+                bestBin = bin;
+            }
+        }
+    }
+
+    // traversal cost is taken as one triangle test
+    const double leafCost = bounds.area() * count;
+    const double splitCost = bounds.area() + bestCost;
+    if (count <= kMaxLeafSize && (bestAxis < 0 || splitCost >= leafCost))
+    {
+        out[nodeIndex] = makeNode(bounds, static_cast<uint32_t>(begin), static_cast<uint32_t>(count));
+        return;
+    }
+
+    auto first = ctx.order.begin() + begin;
+    auto last = ctx.order.begin() + end;
+    size_t mid;
+    if (depth >= kMaxSAHDepth)
+    {
+        // degenerate distributions: fall back to a median split along the largest extent
+        Eigen::Vector3d extent = centroidBounds.hi - centroidBounds.lo;
+        int axis;
+        extent.maxCoeff(&axis);
+        const std::vector<Eigen::Vector3d> &centroids = ctx.centroids;
+        mid = begin + count / 2;
+        std::nth_element(first, ctx.order.begin() + mid, last,
+                         [&](uint32_t a, uint32_t b) { return centroids[a](axis) < centroids[b](axis); });
+    }
+    else if (bestAxis >= 0)
+    {
+        const double axisLo = centroidBounds.lo(bestAxis);
+        const double scale = kNumBins / (centroidBounds.hi(bestAxis) - axisLo);
+        const std::vector<Eigen::Vector3d> &centroids = ctx.centroids;
+        const int axis = bestAxis;
+        const int splitBin = bestBin;
+        mid = std::partition(first, last, [&](uint32_t prim) {
+                  int bin = std::min(kNumBins - 1, static_cast<int>((centroids[prim](axis) - axisLo) * scale));
+                  return bin <= splitBin;
+              }) - ctx.order.begin();
+    }
+    else
+    {
+        // every centroid is identical, split the range in half
+        mid = begin + count / 2;
+    }
+
+    if (depth < ctx.parallelDepth && count >= kParallelBuildSize)
+    {
+        std::vector<MeshBVH::Node> rightNodes;
+        std::exception_ptr rightError;
+        std::thread rightBuilder([&ctx, &rightNodes, &rightError, mid, end, depth]() {
+            try
+            {
+                buildSubtree(ctx, mid, end, depth + 1, rightNodes);
+            }
+            catch (...)
+            {
+                rightError = std::current_exception();
+            }
+        });
+        buildSubtree(ctx, begin, mid, depth + 1, out);
+        rightBuilder.join();
+        if (rightError)
+        {
+            std::rethrow_exception(rightError);
+        }
+        const uint32_t shift = static_cast<uint32_t>(out.size());
+        for (auto &node : rightNodes)
+        {
+            if (node.count == 0)
+            {
+                node.offset += shift;
+            }
+        }
+        out.insert(out.end(), rightNodes.begin(), rightNodes.end());
+        out[nodeIndex] = makeNode(bounds, shift, 0);
+    }
+    else
+    {
+        buildSubtree(ctx, begin, mid, depth + 1, out);
+        const uint32_t rightIndex = static_cast<uint32_t>(out.size());
+        buildSubtree(ctx, mid, end, depth + 1, out);
+        out[nodeIndex] = makeNode(bounds, rightIndex, 0);
+    }
+}
+
+// squared distance between a point and a node box
+inline double boxDistance2(const MeshBVH::Node &node, const Eigen::Vector3d &p)
+{
+    double d2 = 0.0;
+    for (int k = 0; k < 3; k++)
+    {
+        double d = std::max(std::max(node.bounds_min[k] - p(k), p(k) - node.bounds_max[k]), 0.0);
+        d2 += d * d;
+    }
+    return d2;
+}
+
+// entry parameter of a ray in a node box, infinity if the box is missed
+inline double boxEntry(const MeshBVH::Node &node, const Eigen::Vector3d &origin, const Eigen::Vector3d &invDirection,
+                       double tMax)
+{
+    double tNear = 0.0;
+    double tFar = tMax;
+    for (int k = 0; k < 3; k++)
+    {
+        double t0 = (node.bounds_min[k] - origin(k)) * invDirection(k);
+        double t1 = (node.bounds_max[k] - origin(k)) * invDirection(k);
+        if (t0 > t1)
+        {
+            std::swap(t0, t1);
+        }
+        // written so that NaN (0 * inf) keeps the current interval
+        tNear = t0 > tNear ? t0 : tNear;
+        tFar = t1 < tFar ? t1 : tFar;
+    }
+    return tNear <= tFar ? tNear : std::numeric_limits<double>::infinity();
+}
+
+/**
+ * @brief Closest point of triangle (a, b, c) to p, returned as barycentric weights.
+ *
+ * Voronoi region classification from Ericson, "Real-Time Collision Detection".
+ */
+inline Eigen::Vector3d closestBarycentric(const Eigen::Vector3d &p, const Eigen::Vector3d &a, const Eigen::Vector3d &b,
+                                          const Eigen::Vector3d &c)
+{
+    const Eigen::Vector3d ab = b - a;
+    const Eigen::Vector3d ac = c - a;
+    const Eigen::Vector3d ap = p - a;
+    const double d1 = ab.dot(ap);
+    const double d2 = ac.dot(ap);
+    if (d1 <= 0.0 && d2 <= 0.0)
+    {
+        return Eigen::Vector3d(1.0, 0.0, 0.0);
+    }
+    const Eigen::Vector3d bp = p - b;
+    const double d3 = ab.dot(bp);
+    const double d4 = ac.dot(bp);
+    if (d3 >= 0.0 && d4 <= d3)
+    {
+        return Eigen::Vector3d(0.0, 1.0, 0.0);
+    }
+    const double vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+    {
+        const double v = d1 / (d1 - d3);
+        return Eigen::Vector3d(1.0 - v, v, 0.0);
+    }
+    const Eigen::Vector3d cp = p - c;
+    const double d5 = ab.dot(cp);
+    const double d6 = ac.dot(cp);
+    if (d6 >= 0.0 && d5 <= d6)
+    {
+        return Eigen::Vector3d(0.0, 0.0, 1.0);
+    }
+    const double vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+    {
+        const double w = d2 / (d2 - d6);
+        return Eigen::Vector3d(1.0 - w, 0.0, w);
+    }
+    const double va = d3 * d6 - d5 * d4;
+    if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+    {
+        const double w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        return Eigen::Vector3d(0.0, 1.0 - w, w);
+    }
+    const double sum = va + vb + vc;
+    if (!(sum > 0.0))
+    {
+        // degenerate triangle
+        return Eigen::Vector3d(1.0, 0.0, 0.0);
+    }
+    const double v = vb / sum;
+    const double w = vc / sum;
+    return Eigen::Vector3d(1.0 - v - w, v, w);
+}
+} // namespace
+
+MeshBVH::MeshBVH(TriangleMesh &mesh)
+    : faces(mesh.getFaces()), vertex_normals(mesh.getVerticeNormals())
+{
+    build(mesh.getVerticesIntoWorld());
+}
+
+MeshBVH::MeshBVH(const bunny_dataIO::Point3DMatrixType &vertices, const bunny_dataIO::IndexMatrixType &faces,
+                 const bunny_dataIO::Point3DMatrixType &vertexNormals)
+    : faces(faces), vertex_normals(vertexNormals)
+{
+    build(vertices);
+}
+
+/**
+ * @brief Builds the hierarchy.
+ *
+ * Face boxes and centroids are computed in parallel, then the top levels of the tree are split between threads:
+ * up to 2^parallelDepth subtrees are built concurrently.
+ */
+void MeshBVH::build(const bunny_dataIO::Point3DMatrixType &vertices)
+{
+    const size_t num_faces = faces.rows();
+    if (num_faces == 0)
+    {
+        throw std::invalid_argument("BVH Error: mesh has no faces");
+    }
+    if (vertex_normals.rows() != vertices.rows())
+    {
+        throw std::invalid_argument("BVH Error: vertex normals and vertices sizes differ");
+    }
+
+    std::vector<Box> boxes(num_faces);
+    std::vector<Eigen::Vector3d> centroids(num_faces);
+    std::vector<uint32_t> order(num_faces);
+    parallel::parallelFor(0, num_faces, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            Box box;
+            for (int k = 0; k < 3; k++)
+            {
+                box.grow(Eigen::Vector3d(vertices.row(faces(i, k)).transpose()));
+            }
+            boxes[i] = box;
+            centroids[i] = 0.5 * (box.lo + box.hi);
+            order[i] = static_cast<uint32_t>(i);
+        }
+    });
+
+    unsigned parallelDepth = 0;
+    while ((1u << parallelDepth) < parallel::numThreads())
+    {
+        parallelDepth++;
+    }
+    BuildContext ctx{boxes, centroids, order, parallelDepth};
+    nodes.clear();
+    nodes.reserve(2 * num_faces / kMinLeafSize);
+    buildSubtree(ctx, 0, num_faces, 0, nodes);
+    nodes.shrink_to_fit();
+
+    triangles.resize(num_faces);
+    parallel::parallelFor(0, num_faces, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            const int face = static_cast<int>(order[i]);
+            triangles[i].v0 = vertices.row(faces(face, 0)).transpose();
+            triangles[i].v1 = vertices.row(faces(face, 1)).transpose();
+            triangles[i].v2 = vertices.row(faces(face, 2)).transpose();
+            triangles[i].face = face;
+        }
+    });
+}
+
+void MeshBVH::completeHit(MeshHit &hit) const
+{
+    if (!hit.valid())
+    {
+        return;
+    }
+    bunny_dataIO::Point3DType normal = bunny_dataIO::Point3DType::Zero();
+    for (int k = 0; k < 3; k++)
+    {
+        normal += hit.barycentric(k) * vertex_normals.row(faces(hit.face, k));
+    }
+    hit.normal = normal.normalized();
+}
+
+MeshHit MeshBVH::closestPoint(const bunny_dataIO::Point3DType &point) const
+{
+    const Eigen::Vector3d p = point.transpose();
+    MeshHit hit;
+    double best2 = std::numeric_limits<double>::infinity();
+    const Triangle *bestTriangle = nullptr;
+    Eigen::Vector3d bestBarycentric = Eigen::Vector3d::Zero();
+
+    struct Entry
+    {
+        uint32_t node;
+        double distance2;
+    };
+    Entry stack[kStackSize];
+    int top = 0;
+    stack[top++] = {0, boxDistance2(nodes[0], p)};
+    while (top > 0)
+    {
+        const Entry entry = stack[--top];
+        if (entry.distance2 >= best2)
+        {
+            continue;
+        }
+        const Node &node = nodes[entry.node];
+        if (node.count > 0)
+        {
+            for (uint32_t i = node.offset; i < node.offset + node.count; i++)
+            {
+                const Triangle &tri = triangles[i];
+                Eigen::Vector3d weights = closestBarycentric(p, tri.v0, tri.v1, tri.v2);
+                Eigen::Vector3d closest = weights(0) * tri.v0 + weights(1) * tri.v1 + weights(2) * tri.v2;
+                double d2 = (closest - p).squaredNorm();
+                if (d2 < best2)
+                {
+                    best2 = d2;
+                    bestTriangle = &tri;
+                    bestBarycentric = weights;
+                }
+            }
+            continue;
+        }
+        // push the farthest child first so the nearest one is visited next
+        uint32_t left = entry.node + 1;
+        uint32_t right = node.offset;
+        double dLeft = boxDistance2(nodes[left], p);
+        double dRight = boxDistance2(nodes[right], p);
+        if (dLeft > dRight)
+        {
+            std::swap(left, right);
+            std::swap(dLeft, dRight);
+        }
+        if (dRight < best2)
+        {
+            stack[top++] = {right, dRight};
+        }
+        if (dLeft < best2)
+        {
+            stack[top++] = {left, dLeft};
+        }
+    }
+
+    if (bestTriangle != nullptr)
+    {
+        hit.face = bestTriangle->face;
+        hit.distance = std::sqrt(best2);
+        hit.barycentric = bestBarycentric.transpose();
+        hit.point = (bestBarycentric(0) * bestTriangle->v0 + bestBarycentric(1) * bestTriangle->v1 +
+                     bestBarycentric(2) * bestTriangle->v2)
+                        .transpose();
+        completeHit(hit);
+    }
+    return hit;
+}
+
+MeshHit MeshBVH::intersect(const bunny_dataIO::Point3DType &origin, const bunny_dataIO::Point3DType &direction,
+                           double tMax) const
+{
+    const Eigen::Vector3d o = origin.transpose();
+    const Eigen::Vector3d d = direction.transpose();
+    const Eigen::Vector3d invDirection = d.cwiseInverse();
+    MeshHit hit;
+    double bestT = tMax;
+    const Triangle *bestTriangle = nullptr;
+    double bestU = 0.0, bestV = 0.0;
+
+    struct Entry
+    {
+        uint32_t node;
+        double entry;
+    };
+    Entry stack[kStackSize];
+    int top = 0;
+    double rootEntry = boxEntry(nodes[0], o, invDirection, bestT);
+    if (rootEntry != std::numeric_limits<double>::infinity())
+    {
+        stack[top++] = {0, rootEntry};
+    }
+    while (top > 0)
+    {
+        const Entry entry = stack[--top];
+        if (entry.entry > bestT)
+        {
+            continue;
+        }
+        const Node &node = nodes[entry.node];
+        if (node.count > 0)
+        {
+            for (uint32_t i = node.offset; i < node.offset + node.count; i++)
+            {
+                // Möller-Trumbore ray/triangle intersection
+                const Triangle &tri = triangles[i];
+                const Eigen::Vector3d e1 = tri.v1 - tri.v0;
+                const Eigen::Vector3d e2 = tri.v2 - tri.v0;
+                const Eigen::Vector3d pvec = d.cross(e2);
+                const double det = e1.dot(pvec);
+                if (det == 0.0)
+                {
+                    continue;
+                }
+                const double invDet = 1.0 / det;
+                const Eigen::Vector3d tvec = o - tri.v0;
+                const double u = tvec.dot(pvec) * invDet;
+                if (u < 0.0 || u > 1.0)
+                {
+                    continue;
+                }
+                const Eigen::Vector3d qvec = tvec.cross(e1);
+                const double v = d.dot(qvec) * invDet;
+                if (v < 0.0 || u + v > 1.0)
+                {
+                    continue;
+                }
+                const double t = e2.dot(qvec) * invDet;
+                if (t >= 0.0 && t < bestT)
+                {
+                    bestT = t;
+                    bestTriangle = &tri;
+                    bestU = u;
+                    bestV = v;
+                }
+            }
+            continue;
+        }
+        uint32_t left = entry.node + 1;
+        uint32_t right = node.offset;
+        double tLeft = boxEntry(nodes[left], o, invDirection, bestT);
+        double tRight = boxEntry(nodes[right], o, invDirection, bestT);
+        if (tLeft > tRight)
+        {
+            std::swap(left, right);
+            std::swap(tLeft, tRight);
+        }
+        if (tRight <= bestT)
+        {
+            stack[top++] = {right, tRight};
+        }
+        if (tLeft <= bestT)
+        {
+            stack[top++] = {left, tLeft};
+        }
+    }
+
+    if (bestTriangle != nullptr)
+    {
+        hit.face = bestTriangle->face;
+        hit.distance = bestT;
+        hit.barycentric << 1.0 - bestU - bestV, bestU, bestV;
+        hit.point = (o + bestT * d).transpose();
+        completeHit(hit);
+    }
+    return hit;
+}
+
+std::vector<MeshHit> MeshBVH::closestPoints(const bunny_dataIO::Point3DMatrixType &points) const
+{
+    std::vector<MeshHit> hits(points.rows());
+    parallel::parallelFor(0, hits.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            hits[i] = closestPoint(points.row(i));
+        }
+    }, 256);
+    return hits;
+}
+
+std::vector<MeshHit> MeshBVH::intersectRays(const bunny_dataIO::Point3DMatrixType &origins,
+                                            const bunny_dataIO::Point3DMatrixType &directions) const
+{
+    if (origins.rows() != directions.rows())
+    {
+        throw std::invalid_argument("BVH Error: origins and directions sizes differ");
+    }
+    std::vector<MeshHit> hits(origins.rows());
+    parallel::parallelFor(0, hits.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            hits[i] = intersect(origins.row(i), directions.row(i));
+        }
+    }, 256);
+    return hits;
+}
+
+} // namespace bunny_mesh
@@ -0,0 +1,437 @@
+/**
+ * @file Generator.cc
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Source file of Generator.h header file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "bunny_mesh/Generator.h"
+#include "bunny_mesh/Subdivision.h"
+#include "bunny_mesh/mesh_io.h"
+#include "bunny_mesh/parallel.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace bunny_mesh
+{
+namespace synthetic
+{
+namespace
+{
+// Minimal number of rows generated by one thread
+const size_t kMinRowsPerChunk = 4096;
+
+// Icosahedron of circumradius sqrt(1 + phi^2), faces counter clockwise seen from outside
+const double kPhi = 1.6180339887498948482;
+const double kIcosahedronVertices[12][3] = {{-1, kPhi, 0}, {1, kPhi, 0}, {-1, -kPhi, 0}, {1, -kPhi, 0},
+                                            {0, -1, kPhi}, {0, 1, kPhi}, {0, -1, -kPhi}, {0, 1, -kPhi},
+                                            {kPhi, 0, -1}, {kPhi, 0, 1}, {-kPhi, 0, -1}, {-kPhi, 0, 1}};
+const int kIcosahedronFaces[20][3] = {{0, 11, 5}, {0, 5, 1},  {0, 1, 7},   {0, 7, 10}, {0, 10, 11},
+                                      {1, 5, 9},  {5, 11, 4}, {11, 10, 2}, {10, 7, 6}, {7, 1, 8},
+                                      {3, 9, 4},  {3, 4, 2},  {3, 2, 6},   {3, 6, 8},  {3, 8, 9},
+                                      {4, 9, 5},  {2, 4, 11}, {6, 2, 10},  {8, 6, 7},  {9, 8, 1}};
+
+/**
+ * @brief Largest u such that start(u) <= value, for an increasing start, from an estimate off by a few.
+ */
+template <typename Start>
+inline int64_t rowOf(int64_t value, double estimate, Start start)
+{
+    int64_t u = std::max<int64_t>(0, static_cast<int64_t>(estimate));
+    while (u > 0 && start(u) > value)
+    {
+        u--;
+    }
+    while (start(u + 1) <= value)
+    {
+        u++;
+    }
+    return u;
+}
+
+/**
+ * @brief Store a point projected on the sphere of the given radius.
+ */
+inline void storeOnSphere(double x, double y, double z, double radius, double *out)
+{
+    const double scale = radius / std::sqrt(x * x + y * y + z * z);
+    out[0] = x * scale;
+    out[1] = y * scale;
+    out[2] = z * scale;
+}
+
+/**
+ * @brief Hash of a noise lattice point to [-1, 1], the splitmix64 finalizer over the mixed coordinates.
+ */
+inline double latticeValue(int64_t x, int64_t y, uint64_t seed)
+{
+    uint64_t h = static_cast<uint64_t>(x) * 0x9E3779B97F4A7C15ull ^ static_cast<uint64_t>(y) * 0xC2B2AE3D27D4EB4Full ^
+                 seed * 0x165667B19E3779F9ull;
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ull;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBull;
+    h ^= h >> 31;
+    return static_cast<double>(h >> 11) * (2.0 / 9007199254740992.0) - 1.0;
+}
+
+inline double smoothstep(double t) { return t * t * (3.0 - 2.0 * t); }
+
+/**
+ * @brief Value noise: lattice values interpolated with a smoothstep.
+ */
+inline double valueNoise(double x, double y, uint64_t seed)
+{
+    const double fx = std::floor(x), fy = std::floor(y);
+    const int64_t ix = static_cast<int64_t>(fx), iy = static_cast<int64_t>(fy);
+    const double tx = smoothstep(x - fx), ty = smoothstep(y - fy);
+    const double bottom = latticeValue(ix, iy, seed) + tx * (latticeValue(ix + 1, iy, seed) - latticeValue(ix, iy, seed));
+    const double top =
+        latticeValue(ix, iy + 1, seed) + tx * (latticeValue(ix + 1, iy + 1, seed) - latticeValue(ix, iy + 1, seed));
+    return bottom + ty * (top - bottom);
+}
+} // namespace
+
+// ------------------------------------------------------------------------------------------------------------------
+// Icosphere
+
+IcosphereGenerator::IcosphereGenerator(int frequency, double radius) : frequency(frequency), radius(radius)
+{
+    if (frequency < 1)
+    {
+        throw std::invalid_argument("Generator Error: icosphere frequency must be at least one");
+    }
+    if (10 * static_cast<int64_t>(frequency) * frequency + 2 > INT_MAX)
+    {
+        throw std::invalid_argument("Generator Error: icosphere vertices exceed the index range");
+    }
+    int numEdges = 0;
+    for (int f = 0; f < 20; f++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            const int a = kIcosahedronFaces[f][k], b = kIcosahedronFaces[f][(k + 1) % 3];
+            const int lo = std::min(a, b), hi = std::max(a, b);
+            int e = 0;
+            while (e < numEdges && (edges[e][0] != lo || edges[e][1] != hi))
+            {
+                e++;
+            }
+            if (e == numEdges)
+            {
+                edges[numEdges][0] = lo;
+                edges[numEdges][1] = hi;
+                numEdges++;
+            }
+            faceEdges[f][k] = e;
+            faceEdgeReversed[f][k] = a != lo;
+        }
+    }
+}
+
+int IcosphereGenerator::frequencyForFaces(size_t numFaces)
+{
+    return std::max(1, static_cast<int>(std::lround(std::sqrt(numFaces / 20.0))));
+}
+
+size_t IcosphereGenerator::numVertices() const { return 10 * static_cast<size_t>(frequency) * frequency + 2; }
+
+size_t IcosphereGenerator::numFaces() const { return 20 * static_cast<size_t>(frequency) * frequency; }
+
+int IcosphereGenerator::latticeVertex(int face, int i, int j) const
+{
+    const int n = frequency;
+    const int *corners = kIcosahedronFaces[face];
+    if (i == 0 && j == 0)
+    {
+        return corners[0];
+    }
+    if (i == n)
+    {
+        return corners[1];
+    }
+    if (j == n)
+    {
+        return corners[2];
+    }
+
+    // points on a face edge: position along the edge from its corner k
+    int k = -1, t = 0;
+    if (j == 0)
+    {
+        k = 0, t = i;
+    }
+    else if (i + j == n)
+    {
+        k = 1, t = j;
+    }
+    else if (i == 0)
+    {
+        k = 2, t = n - j;
+    }
+    if (k >= 0)
+    {
+        if (faceEdgeReversed[face][k])
+        {
+            t = n - t;
+        }
+        return 12 + faceEdges[face][k] * (n - 1) + (t - 1);
+    }
+
+    // interior points, by rows of increasing j, (n - 1 - j) points per row
+    const int64_t rowStart = static_cast<int64_t>(j - 1) * (n - 1) - static_cast<int64_t>(j - 1) * j / 2;
+    const int64_t perFace = static_cast<int64_t>(n - 1) * (n - 2) / 2;
+    return static_cast<int>(12 + 30 * static_cast<int64_t>(n - 1) + face * perFace + rowStart + (i - 1));
+}
+
+void IcosphereGenerator::vertices(size_t begin, size_t end, double *out) const
+{
+    const int64_t n = frequency;
+    const int64_t edgeBase = 12, faceBase = 12 + 30 * (n - 1);
+    const int64_t perFace = (n - 1) * (n - 2) / 2;
+    // start of interior row u + 1, (n - 1 - j) points per row j
+    auto interiorStart = [n](int64_t u) { return u * (2 * n - 3 - u) / 2; };
+
+    for (size_t v = begin; v < end; v++, out += 3)
+    {
+        const int64_t index = static_cast<int64_t>(v);
+        if (index < edgeBase)
+        {
+            const double *p = kIcosahedronVertices[index];
+            storeOnSphere(p[0], p[1], p[2], radius, out);
+        }
+        else if (index < faceBase)
+        {
+            const int64_t e = (index - edgeBase) / (n - 1), t = (index - edgeBase) % (n - 1) + 1;
+            const double *a = kIcosahedronVertices[edges[e][0]], *b = kIcosahedronVertices[edges[e][1]];
+            const double wa = static_cast<double>(n - t), wb = static_cast<double>(t);
+            storeOnSphere(wa * a[0] + wb * b[0], wa * a[1] + wb * b[1], wa * a[2] + wb * b[2], radius, out);
+        }
+        else
+        {
+            const int64_t face = (index - faceBase) / perFace, local = (index - faceBase) % perFace;
+            const double b = static_cast<double>(2 * n - 3);
+            const int64_t u = rowOf(local, 0.5 * (b - std::sqrt(std::max(0.0, b * b - 8.0 * local))), interiorStart);
+            const int64_t j = u + 1, i = local - interiorStart(u) + 1;
+            const int *corners = kIcosahedronFaces[face];
+            const double *pa = kIcosahedronVertices[corners[0]], *pb = kIcosahedronVertices[corners[1]],
+                         *pc = kIcosahedronVertices[corners[2]];
+            const double wa = static_cast<double>(n - i - j), wb = static_cast<double>(i), wc = static_cast<double>(j);
+            storeOnSphere(wa * pa[0] + wb * pb[0] + wc * pc[0], wa * pa[1] + wb * pb[1] + wc * pc[1],
+                          wa * pa[2] + wb * pb[2] + wc * pc[2], radius, out);
+        }
+    }
+}
+
+void IcosphereGenerator::faces(size_t begin, size_t end, int *out) const
+{
+    const int64_t n = frequency;
+    const int64_t perFace = n * n;
+    // start of row j, 2 (n - j) - 1 triangles per row: n - j pointing up, then n - j - 1 pointing down
+    auto rowStart = [n](int64_t j) { return 2 * n * j - j * j; };
+
+    for (size_t t = begin; t < end; t++, out += 3)
+    {
+        const int face = static_cast<int>(static_cast<int64_t>(t) / perFace);
+        const int64_t local = static_cast<int64_t>(t) % perFace;
+        const int64_t j = rowOf(local, n - std::sqrt(static_cast<double>(perFace - local)), rowStart);
+        const int64_t r = local - rowStart(j);
+        const int row = static_cast<int>(j);
+        if (r < n - j)
+        {
+            const int i = static_cast<int>(r);
+            out[0] = latticeVertex(face, i, row);
+            out[1] = latticeVertex(face, i + 1, row);
+            out[2] = latticeVertex(face, i, row + 1);
+        }
+        else
+        {
+            const int i = static_cast<int>(r - (n - j));
+            out[0] = latticeVertex(face, i + 1, row);
+            out[1] = latticeVertex(face, i + 1, row + 1);
+            out[2] = latticeVertex(face, i, row + 1);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------------------------
+// Terrain
+
+TerrainGenerator::TerrainGenerator(size_t columns, size_t rows, double amplitude, int octaves, uint32_t seed)
+    : columns(columns), rows(rows), amplitude(amplitude), octaves(octaves), seed(seed)
+{
+    if (columns < 1 || rows < 1)
+    {
+        throw std::invalid_argument("Generator Error: terrain needs at least one cell per side");
+    }
+    if ((columns + 1) > INT_MAX / (rows + 1))
+    {
+        throw std::invalid_argument("Generator Error: terrain vertices exceed the index range");
+    }
+    spacing = 1.0 / static_cast<double>(std::max(columns, rows));
+}
+
+TerrainGenerator TerrainGenerator::withFaces(size_t numFaces, double amplitude, int octaves, uint32_t seed)
+{
+    const size_t side = std::max<long>(1, std::lround(std::sqrt(numFaces / 2.0)));
+    return TerrainGenerator(side, side, amplitude, octaves, seed);
+}
+
+size_t TerrainGenerator::numVertices() const { return (columns + 1) * (rows + 1); }
+
+size_t TerrainGenerator::numFaces() const { return 2 * columns * rows; }
+
+double TerrainGenerator::height(double x, double y) const
+{
+    double z = 0.0, frequency = 4.0, octaveAmplitude = amplitude;
+    for (int o = 0; o < octaves; o++)
+    {
+        z += octaveAmplitude * valueNoise(x * frequency, y * frequency, static_cast<uint64_t>(seed) * 64 + o);
+        frequency *= 2.0;
+        octaveAmplitude *= 0.5;
+    }
+    return z;
+}
+
+void TerrainGenerator::vertices(size_t begin, size_t end, double *out) const
+{
+    for (size_t v = begin; v < end; v++, out += 3)
+    {
+        const size_t i = v % (columns + 1), j = v / (columns + 1);
+        out[0] = static_cast<double>(i) * spacing;
+        out[1] = static_cast<double>(j) * spacing;
+        out[2] = height(out[0], out[1]);
+    }
+}
+
+void TerrainGenerator::faces(size_t begin, size_t end, int *out) const
+{
+    for (size_t t = begin; t < end; t++, out += 3)
+    {
+        const size_t cell = t / 2, i = cell % columns, j = cell / columns;
+        const int v00 = static_cast<int>(j * (columns + 1) + i), v10 = v00 + 1;
+        const int v01 = v00 + static_cast<int>(columns + 1), v11 = v01 + 1;
+        if (t % 2 == 0)
+        {
+            out[0] = v00, out[1] = v10, out[2] = v11;
+        }
+        else
+        {
+            out[0] = v00, out[1] = v11, out[2] = v01;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------------------------
+// Loop subdivision
+
+LoopSubdivisionGenerator::LoopSubdivisionGenerator(const bunny_dataIO::Point3DMatrixType &vertices,
+                                                   const bunny_dataIO::IndexMatrixType &faces, int levels)
+    : coarseVertices(vertices), coarseFaces(faces)
+{
+    if (levels < 1)
+    {
+        throw std::invalid_argument("Generator Error: subdivision needs at least one level");
+    }
+    edges = buildEdgeTable(coarseFaces, coarseVertices.rows());
+    adjacency = buildVertexFaceAdjacency(coarseFaces, coarseVertices.rows());
+    for (int level = 1; level < levels; level++)
+    {
+        bunny_dataIO::Point3DMatrixType finerVertices;
+        bunny_dataIO::IndexMatrixType finerFaces;
+        generateMesh(*this, finerVertices, finerFaces);
+        EdgeTable finerEdges = subdivideEdgeTable(coarseFaces, edges, coarseVertices.rows());
+        VertexFaceAdjacency finerAdjacency = subdivideVertexFaceAdjacency(coarseFaces, edges, adjacency);
+        coarseVertices.swap(finerVertices);
+        coarseFaces.swap(finerFaces);
+        std::swap(edges, finerEdges);
+        std::swap(adjacency, finerAdjacency);
+    }
+    if (numVertices() > static_cast<size_t>(INT_MAX))
+    {
+        throw std::invalid_argument("Generator Error: subdivided vertices exceed the index range");
+    }
+}
+
+int LoopSubdivisionGenerator::levelsForFaces(size_t baseFaces, size_t numFaces)
+{
+    int levels = 1;
+    // next level when the target is closer to it in log scale, above twice the current number of faces
+    for (double faces = 4.0 * baseFaces; faces * 2.0 < numFaces; faces *= 4.0)
+    {
+        levels++;
+    }
+    return levels;
+}
+
+size_t LoopSubdivisionGenerator::numVertices() const { return coarseVertices.rows() + edges.size(); }
+
+size_t LoopSubdivisionGenerator::numFaces() const { return 4 * static_cast<size_t>(coarseFaces.rows()); }
+
+void LoopSubdivisionGenerator::vertices(size_t begin, size_t end, double *out) const
+{
+    subdivideVertices(SubdivisionScheme::Loop, coarseVertices, coarseFaces, edges, adjacency, begin, end, out);
+}
+
+void LoopSubdivisionGenerator::faces(size_t begin, size_t end, int *out) const
+{
+    subdivideFaces(coarseFaces, edges, coarseVertices.rows(), begin, end, out);
+}
+
+// ------------------------------------------------------------------------------------------------------------------
+// Outputs
+
+void generateMesh(const MeshGenerator &generator, bunny_dataIO::Point3DMatrixType &vertices,
+                  bunny_dataIO::IndexMatrixType &faces)
+{
+    vertices.resize(generator.numVertices(), 3);
+    faces.resize(generator.numFaces(), 3);
+    parallel::parallelFor(0, generator.numVertices(), [&](size_t begin, size_t end) {
+        generator.vertices(begin, end, vertices.data() + 3 * begin);
+    }, kMinRowsPerChunk);
+    parallel::parallelFor(0, generator.numFaces(), [&](size_t begin, size_t end) {
+        generator.faces(begin, end, faces.data() + 3 * begin);
+    }, kMinRowsPerChunk);
+}
+
+void writeNumpy(const MeshGenerator &generator, const std::string &verticesFile, const std::string &facesFile,
+                size_t blockRows)
+{
+    if (blockRows == 0)
+    {
+        throw std::invalid_argument("Generator Error: blocks need at least one row");
+    }
+    const bunny_dataIO::NumpyArrayWriter verticesWriter(verticesFile, bunny_dataIO::NumpyType::Float64,
+                                                        generator.numVertices(), 3);
+    const bunny_dataIO::NumpyArrayWriter facesWriter(facesFile, bunny_dataIO::NumpyType::Int32,
+                                                     generator.numFaces(), 3);
+
+    parallel::parallelFor(0, generator.numVertices(), [&](size_t begin, size_t end) {
+        std::vector<double> block(3 * std::min(blockRows, end - begin));
+        for (size_t first = begin; first < end; first += blockRows)
+        {
+            const size_t last = std::min(end, first + blockRows);
+            generator.vertices(first, last, block.data());
+            verticesWriter.writeRows(first, block.data(), last - first);
+        }
+    }, blockRows);
+    parallel::parallelFor(0, generator.numFaces(), [&](size_t begin, size_t end) {
+        std::vector<int> block(3 * std::min(blockRows, end - begin));
+        for (size_t first = begin; first < end; first += blockRows)
+        {
+            const size_t last = std::min(end, first + blockRows);
+            generator.faces(first, last, block.data());
+            facesWriter.writeRows(first, block.data(), last - first);
+        }
+    }, blockRows);
+}
+
+} // namespace synthetic
+} // namespace bunny_mesh
@@ -0,0 +1,373 @@
+/**
+ * @file MemoryBudget.cc
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Source file of MemoryBudget.h header file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "bunny_mesh/MemoryBudget.h"
+#include "bunny_mesh/Mesh.h"
+#include "bunny_mesh/mesh_io.h"
+#include "bunny_mesh/parallel.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace bunny_mesh
+{
+namespace memory
+{
+namespace
+{
+// Number of faces computed, written and dropped at once by the streaming strategies
+const size_t kBlockRows = 1 << 16;
+
+// Minimal number of rows per chunk of the parallel passes over a block
+const size_t kMinRowsPerChunk = 4096;
+
+const double kMegabyte = 1024.0 * 1024.0;
+
+template <typename Scalar>
+using NormalsMatrixType = Eigen::Matrix<Scalar, Eigen::Dynamic, 3, Eigen::RowMajor>;
+
+/**
+ * @brief Value in kilobytes of a /proc/self/status field, in bytes, 0 when missing.
+ */
+size_t statusBytes(const std::string &field)
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, field.size(), field) == 0 && line.size() > field.size() && line[field.size()] == ':')
+        {
+            return std::stoull(line.substr(field.size() + 1)) * 1024;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Open a numpy input file, checking it holds (rows, 3) scalars of the expected type.
+ */
+void checkInput(const bunny_dataIO::NumpyArrayReader &reader, bunny_dataIO::NumpyType type, const std::string &name)
+{
+    if (reader.type() != type || reader.cols() != 3)
+    {
+        throw std::invalid_argument("Memory Error: " + name + " must be a (rows, 3) " +
+                                    (type == bunny_dataIO::NumpyType::Int32 ? "int32" : "float64") + " array");
+    }
+}
+
+void checkFaces(const int *faces, size_t count, size_t num_vertices)
+{
+    for (size_t i = 0; i < 3 * count; i++)
+    {
+        if (faces[i] < 0 || static_cast<size_t>(faces[i]) >= num_vertices)
+        {
+            throw std::out_of_range("Memory Error: face index out of vertices range");
+        }
+    }
+}
+
+inline bunny_dataIO::NumpyType numpyType(double) { return bunny_dataIO::NumpyType::Float64; }
+inline bunny_dataIO::NumpyType numpyType(float) { return bunny_dataIO::NumpyType::Float32; }
+
+/**
+ * @brief Rows of a block of normals in the scalar type of the output, the block itself in double precision.
+ */
+inline const double *outputRows(const bunny_dataIO::Point3DMatrixType &normals, const NormalsMatrixType<double> &)
+{
+    return normals.data();
+}
+
+inline const float *outputRows(const bunny_dataIO::Point3DMatrixType &, const NormalsMatrixType<float> &output)
+{
+    return output.data();
+}
+
+/**
+ * @brief Face normals computed, written and dropped by blocks of faces, summed into the vertex normals.
+ *
+ * Faces are read by blocks from the file when faces is null. Every value is computed with the same expressions as
+ * the normals kernel, and added to its vertices in face order, so the sums are those of a single thread.
+ */
+template <typename Scalar>
+void streamNormals(const bunny_dataIO::NumpyArrayReader &facesReader, const bunny_dataIO::IndexMatrixType *faces,
+                   const bunny_dataIO::Point3DMatrixType &vertices, const std::string &faceNormalsFile,
+                   NormalsMatrixType<Scalar> &verticesNormals, MemoryAccounting &accounting)
+{
+    const size_t num_faces = facesReader.rows();
+    const size_t num_vertices = vertices.rows();
+    const size_t blockRows = std::min(kBlockRows, num_faces);
+    const bool narrow = !std::is_same<Scalar, double>::value;
+
+    bunny_dataIO::NumpyArrayWriter writer(faceNormalsFile, numpyType(Scalar()), num_faces, 3);
+    bunny_dataIO::IndexMatrixType blockFaces(faces ? 0 : blockRows, 3);
+    bunny_dataIO::Point3DMatrixType blockNormals(blockRows, 3);
+    NormalsMatrixType<Scalar> blockOutput(narrow ? blockRows : 0, 3);
+    verticesNormals.setZero(num_vertices, 3);
+    for (size_t first = 0; first < num_faces; first += blockRows)
+    {
+        const size_t count = std::min(blockRows, num_faces - first);
+        const int *rows = faces ? faces->data() + 3 * first : blockFaces.data();
+        if (!faces)
+        {
+            facesReader.readRows(first, blockFaces.data(), count);
+        }
+        checkFaces(rows, count, num_vertices);
+
+        parallel::parallelFor(0, count, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+            {
+                const bunny_dataIO::Point3DType v0 = vertices.row(rows[3 * i]);
+                const bunny_dataIO::Point3DType v1 = vertices.row(rows[3 * i + 1]);
+                const bunny_dataIO::Point3DType v2 = vertices.row(rows[3 * i + 2]);
+                blockNormals.row(i) = (v1 - v0).cross(v2 - v1);
+            }
+        }, kMinRowsPerChunk);
+        for (size_t i = 0; i < count; i++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                verticesNormals.row(rows[3 * i + k]) += blockNormals.row(i).template cast<Scalar>();
+            }
+        }
+        parallel::parallelFor(0, count, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+            {
+                bunny_dataIO::Point3DType faceNormal = blockNormals.row(i);
+                faceNormal.normalize();
+                blockNormals.row(i) = faceNormal;
+                if (narrow)
+                {
+                    blockOutput.row(i) = faceNormal.template cast<Scalar>();
+                }
+            }
+        }, kMinRowsPerChunk);
+        writer.writeRows(first, outputRows(blockNormals, blockOutput), count);
+    }
+    accounting.record("face normals");
+
+    // a vertex without faces is left as not a number, as in the normals kernel
+    parallel::parallelFor(0, num_vertices, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; v++)
+        {
+            verticesNormals.row(v) /= verticesNormals.row(v).norm();
+        }
+    });
+}
+} // namespace
+
+size_t residentBytes() { return statusBytes("VmRSS"); }
+
+size_t peakResidentBytes() { return statusBytes("VmHWM"); }
+
+bool resetPeakResident()
+{
+    // writing 5 to clear_refs resets the peak resident set size of the process, since Linux 4.0
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+    clearRefs.close();
+    return clearRefs.good();
+}
+
+size_t heapBytes()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    // heap chunks in use and mapped chunks, which malloc maps on their own above a size
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+MemoryAccounting::MemoryAccounting()
+{
+    resetPeakResident();
+    stageHeap = heapBytes();
+}
+
+void MemoryAccounting::record(const std::string &stage)
+{
+    StageMemory memory;
+    memory.name = stage;
+    memory.peak_resident = peakResidentBytes();
+    memory.heap = heapBytes();
+    memory.heap_change = static_cast<int64_t>(memory.heap) - static_cast<int64_t>(stageHeap);
+    memory.resident = residentBytes();
+    stageList.push_back(memory);
+    resetPeakResident();
+    stageHeap = heapBytes();
+}
+
+size_t MemoryAccounting::peakResident() const
+{
+    size_t peak = 0;
+    for (const StageMemory &stage : stageList)
+    {
+        peak = std::max(peak, stage.peak_resident);
+    }
+    return peak;
+}
+
+void MemoryAccounting::print(std::ostream &out) const
+{
+    char line[128];
+    std::snprintf(line, sizeof(line), "%-22s %16s %10s %15s %19s\n", "stage", "heap change (MB)", "heap (MB)",
+                  "resident (MB)", "peak resident (MB)");
+    out << line;
+    for (const StageMemory &stage : stageList)
+    {
+        std::snprintf(line, sizeof(line), "%-22s %+16.1f %10.1f %15.1f %19.1f\n", stage.name.c_str(),
+                      stage.heap_change / kMegabyte, stage.heap / kMegabyte, stage.resident / kMegabyte,
+                      stage.peak_resident / kMegabyte);
+        out << line;
+    }
+}
+
+const char *strategyName(MemoryStrategy strategy)
+{
+    switch (strategy)
+    {
+    case MemoryStrategy::Default:
+        return "default";
+    case MemoryStrategy::InPlace:
+        return "in-place";
+    case MemoryStrategy::Streaming:
+        return "streaming";
+    case MemoryStrategy::Chunked:
+        return "chunked";
+    case MemoryStrategy::Float32:
+        return "float32";
+    }
+    return "unknown";
+}
+
+size_t predictPeakBytes(MemoryStrategy strategy, size_t num_vertices, size_t num_faces)
+{
+    const size_t faces = 3 * sizeof(int) * num_faces;
+    const size_t vertices = 3 * sizeof(double) * num_vertices;
+    const size_t faceNormals = 3 * sizeof(double) * num_faces;
+    const size_t scratch = computeMeshNormalsScratchBytes(num_vertices, num_faces);
+    const size_t block = std::min(kBlockRows, num_faces);
+    switch (strategy)
+    {
+    case MemoryStrategy::Default:
+        // loaded file next to its copy, then the mesh copies with its normals, then the normals copied out
+        return std::max({faces + 2 * vertices, 2 * faces + 3 * vertices + faceNormals + scratch,
+                         2 * faces + 4 * vertices + 2 * faceNormals});
+    case MemoryStrategy::InPlace:
+        return faces + 2 * vertices + faceNormals + scratch;
+    case MemoryStrategy::Streaming:
+        return faces + 2 * vertices + block * 3 * sizeof(double);
+    case MemoryStrategy::Chunked:
+        return 2 * vertices + block * 3 * (sizeof(int) + sizeof(double));
+    case MemoryStrategy::Float32:
+        return vertices + 3 * sizeof(float) * num_vertices + block * 3 * (sizeof(int) + sizeof(double) + sizeof(float));
+    }
+    return 0;
+}
+
+MemoryStrategy chooseStrategy(size_t budget, size_t baseline, size_t num_vertices, size_t num_faces)
+{
+    const MemoryStrategy strategies[] = {MemoryStrategy::Default, MemoryStrategy::InPlace, MemoryStrategy::Streaming,
+                                         MemoryStrategy::Chunked, MemoryStrategy::Float32};
+    for (MemoryStrategy strategy : strategies)
+    {
+        if (baseline + predictPeakBytes(strategy, num_vertices, num_faces) <= budget)
+        {
+            return strategy;
+        }
+    }
+    char message[160];
+    std::snprintf(message, sizeof(message), "Memory Error: the smallest strategy needs %.1f MB, over the %.1f MB budget",
+                  (baseline + predictPeakBytes(MemoryStrategy::Float32, num_vertices, num_faces)) / kMegabyte,
+                  budget / kMegabyte);
+    throw std::invalid_argument(message);
+}
+
+void computeNormalsFiles(MemoryStrategy strategy, const std::string &facesFile, const std::string &verticesFile,
+                         const std::string &faceNormalsFile, const std::string &verticesNormalsFile,
+                         MemoryAccounting &accounting)
+{
+    if (strategy == MemoryStrategy::Default)
+    {
+        bunny_dataIO::IndexMatrixType faces = bunny_dataIO::readIntNumPyArray(facesFile);
+        accounting.record("read faces");
+        bunny_dataIO::Point3DMatrixType vertices = bunny_dataIO::readFloatNumPyArray(verticesFile);
+        accounting.record("read vertices");
+        TriangleMesh mesh(vertices, faces);
+        accounting.record("copy into the mesh");
+        mesh.ComputeNormals();
+        accounting.record("normals");
+        bunny_dataIO::Point3DMatrixType faceNormals = mesh.getFaceNormals();
+        bunny_dataIO::Point3DMatrixType verticesNormals = mesh.getVerticeNormals();
+        accounting.record("copy out the normals");
+        bunny_dataIO::saveMatrixToNumpyArray(faceNormalsFile, faceNormals);
+        bunny_dataIO::saveMatrixToNumpyArray(verticesNormalsFile, verticesNormals);
+        accounting.record("write normals");
+        return;
+    }
+
+    bunny_dataIO::NumpyArrayReader facesReader(facesFile), verticesReader(verticesFile);
+    checkInput(facesReader, bunny_dataIO::NumpyType::Int32, "faces");
+    checkInput(verticesReader, bunny_dataIO::NumpyType::Float64, "vertices");
+    const size_t num_faces = facesReader.rows();
+    const size_t num_vertices = verticesReader.rows();
+
+    bunny_dataIO::IndexMatrixType faces;
+    if (strategy == MemoryStrategy::InPlace || strategy == MemoryStrategy::Streaming)
+    {
+        faces.resize(num_faces, 3);
+        facesReader.readRows(0, faces.data(), num_faces);
+        checkFaces(faces.data(), num_faces, num_vertices);
+        accounting.record("read faces");
+    }
+    bunny_dataIO::Point3DMatrixType vertices(num_vertices, 3);
+    verticesReader.readRows(0, vertices.data(), num_vertices);
+    accounting.record("read vertices");
+
+    if (strategy == MemoryStrategy::InPlace)
+    {
+        bunny_dataIO::Point3DMatrixType faceNormals(num_faces, 3), verticesNormals(num_vertices, 3);
+        computeMeshNormals(vertices, faces, faceNormals, verticesNormals);
+        accounting.record("normals");
+        bunny_dataIO::NumpyArrayWriter(faceNormalsFile, bunny_dataIO::NumpyType::Float64, num_faces, 3)
+            .writeRows(0, faceNormals.data(), num_faces);
+        bunny_dataIO::NumpyArrayWriter(verticesNormalsFile, bunny_dataIO::NumpyType::Float64, num_vertices, 3)
+            .writeRows(0, verticesNormals.data(), num_vertices);
+        accounting.record("write normals");
+    }
+    else if (strategy == MemoryStrategy::Float32)
+    {
+        NormalsMatrixType<float> verticesNormals;
+        streamNormals<float>(facesReader, nullptr, vertices, faceNormalsFile, verticesNormals, accounting);
+        bunny_dataIO::NumpyArrayWriter(verticesNormalsFile, bunny_dataIO::NumpyType::Float32, num_vertices, 3)
+            .writeRows(0, verticesNormals.data(), num_vertices);
+        accounting.record("vertex normals");
+    }
+    else
+    {
+        NormalsMatrixType<double> verticesNormals;
+        streamNormals<double>(facesReader, strategy == MemoryStrategy::Streaming ? &faces : nullptr, vertices,
+                              faceNormalsFile, verticesNormals, accounting);
+        bunny_dataIO::NumpyArrayWriter(verticesNormalsFile, bunny_dataIO::NumpyType::Float64, num_vertices, 3)
+            .writeRows(0, verticesNormals.data(), num_vertices);
+        accounting.record("vertex normals");
+    }
+}
+
+} // namespace memory
+} // namespace bunny_mesh
@@ -9,11 +9,34 @@
  * 
  */
 #include "bunny_mesh/Mesh.h"
+#include "bunny_mesh/parallel.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <stdexcept>
+#include <vector>
 
 namespace bunny_mesh
 {
+/**
+ * @brief Rotation taking object coordinates to world coordinates for an object orientation.
+ * 
+ * Same convention as TriangleMesh::matchObjectOrientation(), including its inverted rotation axis.
+ */
+Eigen::Matrix3d orientationRotation(const bunny_dataIO::Point3DType &orientation)
+{
+    const bunny_dataIO::Point3DType orientationDefault(0, 0, 1);
+    if (orientation == orientationDefault)
+    {
+        return Eigen::Matrix3d::Identity();
+    }
+    double angle = acos(orientationDefault.dot(orientation));
+    bunny_dataIO::Point3DType axis = (orientationDefault.cross(orientation)).normalized();
+    Eigen::Affine3d affineRotation(Eigen::AngleAxisd(angle, -axis.transpose()));
+    return affineRotation.rotation();
+}
+
 /**
     * @brief Apply a rotation transform in the array to convert from relative coordinates to world coordinates.
     * 
@@ -22,7 +45,7 @@ namespace bunny_mesh
     * @param array : relative position of a point to the object.
     * @return 
     */
-bunny_dataIO::Point3DType TriangleMesh::matchObjectOrientation(const bunny_dataIO::Point3DType &point)
+bunny_dataIO::Point3DType TriangleMesh::matchObjectOrientation(const bunny_dataIO::Point3DType &point) const
 {
     Eigen::Affine3d affineRotation(Eigen::AngleAxisd(objectAngle(), -RotationAxis()));
     bunny_dataIO::Point3DType newPoint = point * affineRotation.rotation();
@@ -34,7 +57,7 @@ bunny_dataIO::Point3DType TriangleMesh::matchObjectOrientation(const bunny_dataI
  * 
  * @return bunny_dataIO::Point3DMatrixType 
  */
-bunny_dataIO::Point3DMatrixType TriangleMesh::getVerticesIntoWorld()
+bunny_dataIO::Point3DMatrixType TriangleMesh::getVerticesIntoWorld() const
 {
     // If the default orientation is set, verticesWorld is just a copy of vertices
     if (orientation == orientationDefault)
@@ -43,35 +66,88 @@ bunny_dataIO::Point3DMatrixType TriangleMesh::getVerticesIntoWorld()
     }
     else
     {
-        bunny_dataIO::Point3DMatrixType verticesWorld;
-        verticesWorld = bunny_dataIO::Point3DMatrixType::Zero(vertices.rows(), vertices.cols());
-        // we must transform each relative vertex into a world equivalent
-        for (size_t i = 0; i < num_vertices; i++)
+        // we must transform each relative vertex into a world equivalent,
+        // the rotation is the same for every vertex so it is built only once
+        bunny_dataIO::Point3DMatrixType verticesWorld = vertices * orientationRotation(orientation);
+        return verticesWorld;
+    }
+}
+
+/**
+ * @brief Overwrite a block of contiguous vertices, keeping the faces and the buffers allocated.
+ * 
+ * @param first : index of the first vertex to overwrite.
+ * @param block : new vertices, size (count, 3).
+ */
+void TriangleMesh::setVerticesBlock(size_t first, const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &block)
+{
+    if (first + block.rows() > num_vertices)
+    {
+        throw std::out_of_range("Mesh Error: vertices block out of vertices range");
+    }
+    vertices.middleRows(first, block.rows()) = block;
+    normals_valid = false;
+}
+
+namespace
+{
+// Minimal number of faces per chunk: each chunk but the first costs a private vertex normals buffer
+const size_t kMinFacesPerChunk = 16384;
+
+// Bound of the private vertex normals buffers of a computeMeshNormals() call
+const size_t kMaxScratchBytes = size_t(128) << 20;
+
+/**
+ * @brief Chunks of faces of computeMeshNormals(): one per thread, fewer when their private buffers would pass
+ * kMaxScratchBytes.
+ */
+inline size_t normalsChunkCount(size_t num_vertices, size_t num_faces)
+{
+    const size_t bufferBytes = std::max<size_t>(1, num_vertices * 3 * sizeof(double));
+    return std::min(parallel::chunkCount(num_faces, kMinFacesPerChunk), 1 + kMaxScratchBytes / bufferBytes);
+}
+
+/**
+ * @brief Write the selected attributes of face i, and add it to the area and bounds of its chunk.
+ */
+template <unsigned Attributes>
+inline void faceAttributes(size_t i, const bunny_dataIO::Point3DType &v0, const bunny_dataIO::Point3DType &v1,
+                           const bunny_dataIO::Point3DType &v2, const bunny_dataIO::Point3DType &faceNormal,
+                           FaceAttributes &attributes, double &area, bunny_dataIO::Point3DType &bounds_min,
+                           bunny_dataIO::Point3DType &bounds_max)
+{
+    // the cross product length is twice the face area
+    if (Attributes & (FaceAreas | SurfaceArea))
+    {
+        double faceArea = 0.5 * faceNormal.norm();
+        if (Attributes & FaceAreas)
         {
-            bunny_dataIO::Point3DType vertice = vertices.row(i);
-            verticesWorld.row(i) = matchObjectOrientation(vertice);
+            attributes.face_areas(i) = faceArea;
         }
-        return verticesWorld;
+        area += faceArea;
+    }
+    if (Attributes & FaceCentroids)
+    {
+        attributes.face_centroids.row(i) = (v0 + v1 + v2) / 3.0;
+    }
+    if (Attributes & BoundingBox)
+    {
+        bounds_min = bounds_min.cwiseMin(v0).cwiseMin(v1).cwiseMin(v2);
+        bounds_max = bounds_max.cwiseMax(v0).cwiseMax(v1).cwiseMax(v2);
     }
 }
 
 /**
-     * @brief Given the faces and vertices arrays, compute the normalized normal matrix to each face and vertex.
-     * 
-     * A face normal for a triangle mesh can be calculated as the cross product between two of its sides.
-     * 
-     *      Face_Normal = normalized((v1 - v0).cross(v2 - v1))
-     * 
-     * A vertex normal is the sum of the unnormalized face normals connected to each vertice.
-     * If a given vertice is not connected to any faces, the vertices_normal row will have not a number.
-     * 
-     * Its assumed that the vertices are defined in a counter-clockwise direction.
-     */
-void TriangleMesh::ComputeNormals()
+ * @brief Accumulate the faces [begin, end) of a chunk into its private outputs.
+ */
+template <unsigned Attributes>
+void accumulateFaces(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &verticesWorld,
+                     const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces, size_t begin, size_t end,
+                     Eigen::Ref<bunny_dataIO::Point3DMatrixType> face_normals,
+                     Eigen::Ref<bunny_dataIO::Point3DMatrixType> vertices_normals, FaceAttributes &attributes,
+                     double &area, bunny_dataIO::Point3DType &bounds_min, bunny_dataIO::Point3DType &bounds_max)
 {
-    bunny_dataIO::Point3DMatrixType verticesWorld = getVerticesIntoWorld();
-    // iterates through each row of the faces matrix
-    for (size_t i = 0; i < num_faces; i++)
+    for (size_t i = begin; i < end; i++)
     {
         // acquire vertex indexes information from faces ith row
         bunny_dataIO::Index3DType vertices_idx = faces.row(i);
@@ -89,15 +165,401 @@ void TriangleMesh::ComputeNormals()
         vertices_normals.row(vertices_idx(1)) += faceNormal;
         vertices_normals.row(vertices_idx(2)) += faceNormal;
 
+        faceAttributes<Attributes>(i, v0, v1, v2, faceNormal, attributes, area, bounds_min, bounds_max);
+
         // normalization of faces vector
         faceNormal.normalize();
 
         // assign to face_normal matrix, on the given row
         face_normals.row(i) = faceNormal;
     }
-    // lastly normalize each row (vertice) of vertices_normals matrix
-    vertices_normals.rowwise().normalize();
-    return;
+}
+/**
+ * @brief Resize the selected face attributes arrays to the number of faces.
+ */
+template <unsigned Attributes>
+void resizeFaceAttributes(FaceAttributes &attributes, Eigen::Index num_faces)
+{
+    if ((Attributes & FaceAreas) && attributes.face_areas.size() != num_faces)
+    {
+        attributes.face_areas.resize(num_faces);
+    }
+    if ((Attributes & FaceCentroids) && attributes.face_centroids.rows() != num_faces)
+    {
+        attributes.face_centroids.resize(num_faces, 3);
+    }
+}
+
+/**
+ * @brief Reduce the surface areas and bounding boxes of the chunks, in chunk order.
+ */
+template <unsigned Attributes>
+void reduceFaceAttributes(const std::vector<double> &areas, const std::vector<bunny_dataIO::Point3DType> &bounds_min,
+                          const std::vector<bunny_dataIO::Point3DType> &bounds_max, size_t num_faces,
+                          FaceAttributes &attributes)
+{
+    if (Attributes & SurfaceArea)
+    {
+        attributes.surface_area = 0.0;
+        for (double area : areas)
+        {
+            attributes.surface_area += area;
+        }
+    }
+    if (Attributes & BoundingBox)
+    {
+        attributes.bounds_min = bunny_dataIO::Point3DType::Zero();
+        attributes.bounds_max = bunny_dataIO::Point3DType::Zero();
+        if (num_faces > 0)
+        {
+            attributes.bounds_min = bounds_min[0];
+            attributes.bounds_max = bounds_max[0];
+            for (size_t chunk = 1; chunk < bounds_min.size(); chunk++)
+            {
+                attributes.bounds_min = attributes.bounds_min.cwiseMin(bounds_min[chunk]);
+                attributes.bounds_max = attributes.bounds_max.cwiseMax(bounds_max[chunk]);
+            }
+        }
+    }
+}
+} // namespace
+
+/**
+ * @brief Compute normalized face and vertex normals, and face attributes in the same pass over the faces.
+ * 
+ * The first chunk accumulates directly into the output vertex normals, so a single chunk runs exactly the
+ * serial algorithm. Other chunks accumulate into private buffers added to the output in the reduction, which
+ * also normalizes the vertex normals. Meshes with many vertices use fewer chunks than threads, so that the private
+ * buffers stay under kMaxScratchBytes.
+ */
+template <unsigned Attributes>
+void computeMeshNormals(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &verticesWorld,
+                        const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces,
+                        Eigen::Ref<bunny_dataIO::Point3DMatrixType> face_normals,
+                        Eigen::Ref<bunny_dataIO::Point3DMatrixType> vertices_normals, FaceAttributes &attributes)
+{
+    const size_t num_faces = faces.rows();
+    const size_t num_vertices = verticesWorld.rows();
+    if (face_normals.rows() != faces.rows() || vertices_normals.rows() != verticesWorld.rows())
+    {
+        throw std::invalid_argument("Mesh Error: normals buffers do not match the mesh size");
+    }
+    resizeFaceAttributes<Attributes>(attributes, faces.rows());
+
+    const size_t numChunks = normalsChunkCount(num_vertices, num_faces);
+    std::vector<bunny_dataIO::Point3DMatrixType> partialNormals(numChunks - 1);
+    std::vector<double> areas(numChunks, 0.0);
+    std::vector<bunny_dataIO::Point3DType> bounds_min(numChunks, bunny_dataIO::Point3DType::Constant(INFINITY));
+    std::vector<bunny_dataIO::Point3DType> bounds_max(numChunks, bunny_dataIO::Point3DType::Constant(-INFINITY));
+
+    // normals are accumulated, so previous results must be cleared
+    vertices_normals.setZero();
+    parallel::parallelForChunks(0, num_faces, numChunks, [&](size_t begin, size_t end, size_t chunk) {
+        if (chunk == 0)
+        {
+            accumulateFaces<Attributes>(verticesWorld, faces, begin, end, face_normals, vertices_normals, attributes,
+                                        areas[chunk], bounds_min[chunk], bounds_max[chunk]);
+        }
+        else
+        {
+            partialNormals[chunk - 1].setZero(num_vertices, 3);
+            accumulateFaces<Attributes>(verticesWorld, faces, begin, end, face_normals, partialNormals[chunk - 1],
+                                        attributes, areas[chunk], bounds_min[chunk], bounds_max[chunk]);
+        }
+    });
+
+    // lastly sum the chunks and normalize each row (vertice) of vertices_normals matrix
+    parallel::parallelFor(0, num_vertices, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; v++)
+        {
+            for (const bunny_dataIO::Point3DMatrixType &partial : partialNormals)
+            {
+                vertices_normals.row(v) += partial.row(v);
+            }
+            // a vertex without faces is left as not a number, as rowwise().normalize() does
+            vertices_normals.row(v) /= vertices_normals.row(v).norm();
+        }
+    });
+
+    reduceFaceAttributes<Attributes>(areas, bounds_min, bounds_max, num_faces, attributes);
+}
+
+size_t computeMeshNormalsScratchBytes(size_t num_vertices, size_t num_faces)
+{
+    return (normalsChunkCount(num_vertices, num_faces) - 1) * num_vertices * 3 * sizeof(double);
+}
+
+/**
+ * @brief Compute normalized face and vertex normals, bitwise identical whatever the number of threads.
+ * 
+ * Three parallel passes: unnormalized face normals and attributes per fixed block of faces, then the gather of
+ * each vertex through the adjacency, then the normalization of the face normals, which the gather still reads.
+ * Each value is computed with the same expressions as accumulateFaces(), so results match the serial fast path.
+ */
+template <unsigned Attributes>
+void computeMeshNormalsDeterministic(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &verticesWorld,
+                                     const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces,
+                                     VertexFaceAdjacency &adjacency,
+                                     Eigen::Ref<bunny_dataIO::Point3DMatrixType> face_normals,
+                                     Eigen::Ref<bunny_dataIO::Point3DMatrixType> vertices_normals,
+                                     FaceAttributes &attributes)
+{
+    const size_t num_faces = faces.rows();
+    const size_t num_vertices = verticesWorld.rows();
+    // never split in chunks by the fast path, whatever the number of threads: it is the serial algorithm
+    if (num_faces < 2 * kMinFacesPerChunk)
+    {
+        computeMeshNormals<Attributes>(verticesWorld, faces, face_normals, vertices_normals, attributes);
+        return;
+    }
+    if (face_normals.rows() != faces.rows() || vertices_normals.rows() != verticesWorld.rows())
+    {
+        throw std::invalid_argument("Mesh Error: normals buffers do not match the mesh size");
+    }
+    if (adjacency.offsets.empty())
+    {
+        adjacency = buildVertexFaceAdjacency(faces, num_vertices);
+    }
+    if (adjacency.offsets.size() != num_vertices + 1 || adjacency.corners.size() != 3 * num_faces)
+    {
+        throw std::invalid_argument("Mesh Error: vertex face adjacency does not match the mesh size");
+    }
+    resizeFaceAttributes<Attributes>(attributes, faces.rows());
+
+    // blocks of faces do not depend on the number of threads, so neither do their partial surface areas
+    const size_t numBlocks = (num_faces + kMinFacesPerChunk - 1) / kMinFacesPerChunk;
+    std::vector<double> areas(numBlocks, 0.0);
+    std::vector<bunny_dataIO::Point3DType> bounds_min(numBlocks, bunny_dataIO::Point3DType::Constant(INFINITY));
+    std::vector<bunny_dataIO::Point3DType> bounds_max(numBlocks, bunny_dataIO::Point3DType::Constant(-INFINITY));
+    parallel::parallelFor(0, numBlocks, [&](size_t beginBlock, size_t endBlock) {
+        for (size_t block = beginBlock; block < endBlock; block++)
+        {
+            const size_t end = std::min(num_faces, (block + 1) * kMinFacesPerChunk);
+            for (size_t i = block * kMinFacesPerChunk; i < end; i++)
+            {
+                bunny_dataIO::Index3DType vertices_idx = faces.row(i);
+                bunny_dataIO::Point3DType v0 = verticesWorld.row(vertices_idx(0));
+                bunny_dataIO::Point3DType v1 = verticesWorld.row(vertices_idx(1));
+                bunny_dataIO::Point3DType v2 = verticesWorld.row(vertices_idx(2));
+                bunny_dataIO::Point3DType faceNormal = (v1 - v0).cross(v2 - v1);
+                faceAttributes<Attributes>(i, v0, v1, v2, faceNormal, attributes, areas[block], bounds_min[block],
+                                           bounds_max[block]);
+                // kept unnormalized until the vertices gathered it
+                face_normals.row(i) = faceNormal;
+            }
+        }
+    }, 1);
+
+    // each vertex sums its faces in increasing face order, as the serial algorithm does
+    parallel::parallelFor(0, num_vertices, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; v++)
+        {
+            vertices_normals.row(v).setZero();
+            for (int corner = adjacency.offsets[v]; corner < adjacency.offsets[v + 1]; corner++)
+            {
+                vertices_normals.row(v) += face_normals.row(adjacency.corners[corner] / 3);
+            }
+            // a vertex without faces is left as not a number, as rowwise().normalize() does
+            vertices_normals.row(v) /= vertices_normals.row(v).norm();
+        }
+    });
+
+    parallel::parallelFor(0, num_faces, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            bunny_dataIO::Point3DType faceNormal = face_normals.row(i);
+            faceNormal.normalize();
+            face_normals.row(i) = faceNormal;
+        }
+    });
+
+    reduceFaceAttributes<Attributes>(areas, bounds_min, bounds_max, num_faces, attributes);
+}
+
+// every combination of attributes is available to the callers of the header
+#define BUNNY_MESH_INSTANTIATE_NORMALS(Attributes)                                                                  \
+    template void computeMeshNormals<Attributes>(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &,        \
+                                                 const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &,          \
+                                                 Eigen::Ref<bunny_dataIO::Point3DMatrixType>,                      \
+                                                 Eigen::Ref<bunny_dataIO::Point3DMatrixType>, FaceAttributes &);   \
+    template void computeMeshNormalsDeterministic<Attributes>(                                                     \
+        const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &, const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &, \
+        VertexFaceAdjacency &, Eigen::Ref<bunny_dataIO::Point3DMatrixType>, Eigen::Ref<bunny_dataIO::Point3DMatrixType>, \
+        FaceAttributes &);
+BUNNY_MESH_INSTANTIATE_NORMALS(0)
+BUNNY_MESH_INSTANTIATE_NORMALS(1)
+BUNNY_MESH_INSTANTIATE_NORMALS(2)
+BUNNY_MESH_INSTANTIATE_NORMALS(3)
+BUNNY_MESH_INSTANTIATE_NORMALS(4)
+BUNNY_MESH_INSTANTIATE_NORMALS(5)
+BUNNY_MESH_INSTANTIATE_NORMALS(6)
+BUNNY_MESH_INSTANTIATE_NORMALS(7)
+BUNNY_MESH_INSTANTIATE_NORMALS(8)
+BUNNY_MESH_INSTANTIATE_NORMALS(9)
+BUNNY_MESH_INSTANTIATE_NORMALS(10)
+BUNNY_MESH_INSTANTIATE_NORMALS(11)
+BUNNY_MESH_INSTANTIATE_NORMALS(12)
+BUNNY_MESH_INSTANTIATE_NORMALS(13)
+BUNNY_MESH_INSTANTIATE_NORMALS(14)
+BUNNY_MESH_INSTANTIATE_NORMALS(15)
+#undef BUNNY_MESH_INSTANTIATE_NORMALS
+
+/**
+ * @brief Compute normalized face and vertex normals of raw mesh arrays.
+ * 
+ * @param verticesWorld : vertices in world coordinates.
+ * @param faces : faces vertices indexes.
+ * @param face_normals : output face normals.
+ * @param vertices_normals : output vertices normals.
+ */
+void computeMeshNormals(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &verticesWorld,
+                        const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces,
+                        Eigen::Ref<bunny_dataIO::Point3DMatrixType> face_normals,
+                        Eigen::Ref<bunny_dataIO::Point3DMatrixType> vertices_normals)
+{
+    FaceAttributes unused;
+    computeMeshNormals<NoFaceAttributes>(verticesWorld, faces, face_normals, vertices_normals, unused);
+}
+
+/**
+ * @brief Compute normalized face and vertex normals, bitwise identical whatever the number of threads.
+ * 
+ * @param adjacency : vertex to face adjacency of faces, built when empty.
+ */
+void computeMeshNormalsDeterministic(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &verticesWorld,
+                                     const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces,
+                                     VertexFaceAdjacency &adjacency,
+                                     Eigen::Ref<bunny_dataIO::Point3DMatrixType> face_normals,
+                                     Eigen::Ref<bunny_dataIO::Point3DMatrixType> vertices_normals)
+{
+    FaceAttributes unused;
+    computeMeshNormalsDeterministic<NoFaceAttributes>(verticesWorld, faces, adjacency, face_normals,
+                                                      vertices_normals, unused);
+}
+
+/**
+     * @brief Given the faces and vertices arrays, compute the normalized normal matrix to each face and vertex.
+     * 
+     * A face normal for a triangle mesh can be calculated as the cross product between two of its sides.
+     * 
+     *      Face_Normal = normalized((v1 - v0).cross(v2 - v1))
+     * 
+     * A vertex normal is the sum of the unnormalized face normals connected to each vertice.
+     * If a given vertice is not connected to any faces, the vertices_normal row will have not a number.
+     * 
+     * Its assumed that the vertices are defined in a counter-clockwise direction.
+     */
+void TriangleMesh::ComputeNormals()
+{
+    ComputeNormals(face_normals, vertices_normals);
+    normals_valid = true;
+}
+
+/**
+ * @brief Compute the normalized normals and write them into caller owned buffers instead of the mesh members.
+ * 
+ * At the default orientation the vertices are used as they are, without a world copy.
+ */
+void TriangleMesh::ComputeNormals(Eigen::Ref<bunny_dataIO::Point3DMatrixType> faceNormals,
+                                  Eigen::Ref<bunny_dataIO::Point3DMatrixType> verticesNormals)
+{
+    FaceAttributes unused;
+    if (orientation == orientationDefault)
+    {
+        computeNormals<NoFaceAttributes>(vertices, faceNormals, verticesNormals, unused);
+    }
+    else
+    {
+        computeNormals<NoFaceAttributes>(getVerticesIntoWorld(), faceNormals, verticesNormals, unused);
+    }
+}
+
+/**
+ * @brief Subdivide the mesh, splitting every face in 4 per level, with the normals of the finest level.
+ * 
+ * The topology of the mesh is built here once, each level then derives the topology of the next one.
+ */
+TriangleMesh TriangleMesh::Subdivide(SubdivisionScheme scheme, int levels)
+{
+    if (levels < 1)
+    {
+        throw std::invalid_argument("Mesh Error: subdivision needs at least one level");
+    }
+    if (edges.offsets.empty())
+    {
+        edges = buildEdgeTable(faces, num_vertices);
+    }
+    if (adjacency.offsets.empty())
+    {
+        adjacency = buildVertexFaceAdjacency(faces, num_vertices);
+    }
+    // midpoint normals of every level are propagated from the level above, Loop ones only computed at the end
+    const bool propagate = scheme == SubdivisionScheme::Midpoint;
+    if (propagate && !normals_valid)
+    {
+        ComputeNormals();
+    }
+    if (levels == 1)
+    {
+        return subdivideLevel(scheme, true);
+    }
+    return subdivideLevel(scheme, propagate).Subdivide(scheme, levels - 1);
+}
+
+/**
+ * @brief Subdivide once: vertices, faces and topology of the subdivided mesh in parallel, then its normals.
+ */
+TriangleMesh TriangleMesh::subdivideLevel(SubdivisionScheme scheme, bool withNormals) const
+{
+    const size_t subdivided_vertices = num_vertices + edges.size();
+    const size_t subdivided_faces = 4 * num_faces;
+
+    TriangleMesh subdivided((bunny_dataIO::Point3DMatrixType()), bunny_dataIO::IndexMatrixType());
+    subdivided.edges = subdivideEdgeTable(faces, edges, num_vertices);
+    subdivided.adjacency = subdivideVertexFaceAdjacency(faces, edges, adjacency);
+    subdivided.vertices.resize(subdivided_vertices, 3);
+    subdivided.faces.resize(subdivided_faces, 3);
+    parallel::parallelFor(0, subdivided_vertices, [&](size_t begin, size_t end) {
+        subdivideVertices(scheme, vertices, faces, edges, adjacency, begin, end,
+                          subdivided.vertices.data() + 3 * begin);
+    }, 4096);
+    parallel::parallelFor(0, subdivided_faces, [&](size_t begin, size_t end) {
+        subdivideFaces(faces, edges, num_vertices, begin, end, subdivided.faces.data() + 3 * begin);
+    }, 4096);
+    subdivided.num_vertices = subdivided_vertices;
+    subdivided.num_faces = subdivided_faces;
+    subdivided.orientation = orientation;
+    subdivided.deterministic = deterministic;
+    subdivided.face_normals = bunny_dataIO::Point3DMatrixType::Zero(subdivided_faces, 3);
+    subdivided.vertices_normals = bunny_dataIO::Point3DMatrixType::Zero(subdivided_vertices, 3);
+
+    if (withNormals)
+    {
+        if (scheme == SubdivisionScheme::Midpoint)
+        {
+            propagateMidpointNormals(vertices, faces, edges, face_normals, vertices_normals, subdivided.face_normals,
+                                     subdivided.vertices_normals);
+        }
+        else
+        {
+            // the derived adjacency makes the deterministic gather the cheapest path
+            FaceAttributes unused;
+            if (orientation == orientationDefault)
+            {
+                computeMeshNormalsDeterministic<NoFaceAttributes>(subdivided.vertices, subdivided.faces,
+                                                                  subdivided.adjacency, subdivided.face_normals,
+                                                                  subdivided.vertices_normals, unused);
+            }
+            else
+            {
+                computeMeshNormalsDeterministic<NoFaceAttributes>(subdivided.getVerticesIntoWorld(), subdivided.faces,
+                                                                  subdivided.adjacency, subdivided.face_normals,
+                                                                  subdivided.vertices_normals, unused);
+            }
+        }
+        subdivided.normals_valid = true;
+    }
+    return subdivided;
 }
 
-} // namespace bunny_mesh
\ No newline at end of file
+} // namespace bunny_mesh
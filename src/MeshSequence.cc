@@ -0,0 +1,227 @@
+/**
+ * @file MeshSequence.cc
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Source file of MeshSequence.h header file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "bunny_mesh/MeshSequence.h"
+#include "bunny_mesh/Mesh.h"
+#include "bunny_mesh/mesh_io.h"
+#include "bunny_mesh/parallel.h"
+
+#include <chrono>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+namespace bunny_mesh
+{
+namespace
+{
+// Minimal number of faces per chunk of the normals kernel: smaller meshes are computed on the calling thread
+const size_t kMinFacesPerChunk = 16384;
+} // namespace
+
+MeshSequence::MeshSequence(const bunny_dataIO::IndexMatrixType &faces, size_t num_vertices)
+    : num_vertices(num_vertices), faces(faces), orientation(0, 0, 1), front(0)
+{
+    // checks the faces, and lets frames run the normals kernel at once without building it
+    adjacency = buildVertexFaceAdjacency(this->faces, num_vertices);
+    for (FrameNormals &output : outputs)
+    {
+        output.face_normals = bunny_dataIO::Point3DMatrixType::Zero(faces.rows(), 3);
+        output.vertices_normals = bunny_dataIO::Point3DMatrixType::Zero(num_vertices, 3);
+    }
+}
+
+void MeshSequence::setOrientation(const bunny_dataIO::Point3DType &orientation)
+{
+    this->orientation = orientation.normalized();
+}
+
+size_t MeshSequence::framesInFlight() const
+{
+    // the kernel splits larger meshes in chunks on every thread already
+    return static_cast<size_t>(faces.rows()) < 2 * kMinFacesPerChunk ? parallel::numThreads() : 1;
+}
+
+/**
+ * @brief Compute the normals of vertices in object coordinates.
+ *
+ * At the default orientation the vertices are used as they are, else they are rotated into the world buffer, with
+ * the same product as TriangleMesh::ComputeNormals().
+ */
+void MeshSequence::computeNormals(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &vertices,
+                                  bunny_dataIO::Point3DMatrixType &world, FrameNormals &normals)
+{
+    if (orientation == bunny_dataIO::Point3DType(0, 0, 1))
+    {
+        computeMeshNormalsDeterministic(vertices, faces, adjacency, normals.face_normals, normals.vertices_normals);
+    }
+    else
+    {
+        world.resize(num_vertices, 3);
+        world.noalias() = vertices * orientationRotation(orientation);
+        computeMeshNormalsDeterministic(world, faces, adjacency, normals.face_normals, normals.vertices_normals);
+    }
+}
+
+const FrameNormals &MeshSequence::computeFrame(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &vertices)
+{
+    if (static_cast<size_t>(vertices.rows()) != num_vertices)
+    {
+        throw std::invalid_argument("Sequence Error: frame vertices do not match the number of vertices");
+    }
+    computeNormals(vertices, verticesWorld, outputs[1 - front]);
+    front = 1 - front;
+    return outputs[front];
+}
+
+/**
+ * @brief Frames go by batches of framesInFlight(), batch b in the buffers of set b % 2: while a batch is computed,
+ * the I/O thread gives the previous batch to the sink then reads the next one into the same set.
+ */
+SequenceStats MeshSequence::run(size_t numFrames, const FrameSource &source, const FrameSink &sink)
+{
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point begin = Clock::now();
+    const size_t inFlight = framesInFlight();
+    const size_t numBuffers = 2 * std::min(inFlight, std::max<size_t>(numFrames, 1));
+    if (frameVertices.size() < numBuffers)
+    {
+        frameVertices.resize(numBuffers);
+        frameWorld.resize(numBuffers);
+        frameNormals.resize(numBuffers);
+    }
+    for (size_t i = 0; i < numBuffers; i++)
+    {
+        // allocated by the first run only
+        frameVertices[i].resize(num_vertices, 3);
+        frameNormals[i].face_normals.resize(faces.rows(), 3);
+        frameNormals[i].vertices_normals.resize(num_vertices, 3);
+    }
+
+    const size_t numBatches = (numFrames + inFlight - 1) / inFlight;
+    auto buffer = [&](size_t frame) { return (frame / inFlight) % 2 * inFlight + frame % inFlight; };
+    auto firstFrame = [&](size_t batch) { return batch * inFlight; };
+    auto lastFrame = [&](size_t batch) { return std::min(numFrames, (batch + 1) * inFlight); };
+    auto readBatch = [&](size_t batch) {
+        for (size_t frame = firstFrame(batch); frame < lastFrame(batch); frame++)
+        {
+            source(frame, frameVertices[buffer(frame)]);
+        }
+    };
+    auto writeBatch = [&](size_t batch) {
+        for (size_t frame = firstFrame(batch); frame < lastFrame(batch); frame++)
+        {
+            sink(frame, frameNormals[buffer(frame)]);
+        }
+    };
+
+    if (numBatches > 0)
+    {
+        readBatch(0);
+    }
+    for (size_t batch = 0; batch < numBatches; batch++)
+    {
+        std::exception_ptr ioError;
+        std::thread io([&, batch]() {
+            try
+            {
+                if (batch > 0)
+                {
+                    writeBatch(batch - 1);
+                }
+                if (batch + 1 < numBatches)
+                {
+                    readBatch(batch + 1);
+                }
+            }
+            catch (...)
+            {
+                ioError = std::current_exception();
+            }
+        });
+        std::exception_ptr computeError;
+        try
+        {
+            const size_t first = firstFrame(batch), last = lastFrame(batch);
+            parallel::parallelForChunks(first, last, last - first, [&](size_t beginFrame, size_t endFrame, size_t) {
+                // with a frame per thread, the kernel of each frame stays on its thread
+                parallel::SerialRegion serial(inFlight > 1);
+                for (size_t frame = beginFrame; frame < endFrame; frame++)
+                {
+                    computeNormals(frameVertices[buffer(frame)], frameWorld[buffer(frame)],
+                                   frameNormals[buffer(frame)]);
+                }
+            });
+        }
+        catch (...)
+        {
+            computeError = std::current_exception();
+        }
+        io.join();
+        if (computeError)
+        {
+            std::rethrow_exception(computeError);
+        }
+        if (ioError)
+        {
+            std::rethrow_exception(ioError);
+        }
+    }
+    if (numBatches > 0)
+    {
+        writeBatch(numBatches - 1);
+    }
+
+    SequenceStats stats;
+    stats.frames = numFrames;
+    stats.frames_in_flight = inFlight;
+    stats.seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+    return stats;
+}
+
+SequenceStats computeSequenceFiles(const std::string &facesFile, const std::string &framesFile,
+                                   const std::string &faceNormalsFile, const std::string &verticesNormalsFile)
+{
+    const bunny_dataIO::NumpyArrayReader facesReader(facesFile), framesReader(framesFile);
+    if (facesReader.type() != bunny_dataIO::NumpyType::Int32 || facesReader.cols() != 3 ||
+        facesReader.frames() != 1)
+    {
+        throw std::invalid_argument("Sequence Error: faces are not an int32 (num_faces, 3) array");
+    }
+    if (framesReader.type() != bunny_dataIO::NumpyType::Float64 || framesReader.cols() != 3)
+    {
+        throw std::invalid_argument("Sequence Error: frames are not a float64 (num_frames, num_vertices, 3) array");
+    }
+    bunny_dataIO::IndexMatrixType faces(facesReader.rows(), 3);
+    facesReader.readRows(0, faces.data(), facesReader.rows());
+
+    const size_t numFrames = framesReader.frames();
+    if (numFrames == 0)
+    {
+        throw std::invalid_argument("Sequence Error: no frames in '" + framesFile + "'");
+    }
+    const size_t num_vertices = framesReader.rows() / numFrames;
+    MeshSequence sequence(faces, num_vertices);
+    const bunny_dataIO::NumpyArrayWriter faceNormalsWriter(faceNormalsFile, bunny_dataIO::NumpyType::Float64,
+                                                           numFrames, faces.rows(), 3);
+    const bunny_dataIO::NumpyArrayWriter verticesNormalsWriter(verticesNormalsFile, bunny_dataIO::NumpyType::Float64,
+                                                               numFrames, num_vertices, 3);
+    return sequence.run(
+        numFrames,
+        [&](size_t frame, Eigen::Ref<bunny_dataIO::Point3DMatrixType> vertices) {
+            framesReader.readRows(frame * num_vertices, vertices.data(), num_vertices);
+        },
+        [&](size_t frame, const FrameNormals &normals) {
+            faceNormalsWriter.writeRows(frame * faces.rows(), normals.face_normals.data(), faces.rows());
+            verticesNormalsWriter.writeRows(frame * num_vertices, normals.vertices_normals.data(), num_vertices);
+        });
+}
+
+} // namespace bunny_mesh
@@ -0,0 +1,485 @@
+/**
+ * @file NormalsService.cc
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Source file of NormalsService.h header file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "bunny_mesh/NormalsService.h"
+
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace bunny_mesh
+{
+namespace service
+{
+namespace
+{
+// arrays of a segment start on cache lines
+const uint64_t kSegmentAlignment = 64;
+
+inline uint64_t alignUp(uint64_t value) { return (value + kSegmentAlignment - 1) / kSegmentAlignment * kSegmentAlignment; }
+
+inline std::runtime_error systemError(const std::string &what)
+{
+    return std::runtime_error("Service Error: " + what + ": " + std::strerror(errno));
+}
+
+// copies a string into a fixed size message field, always null terminated
+inline void copyField(char *field, const std::string &value)
+{
+    std::strncpy(field, value.c_str(), kMaxPathLength - 1);
+    field[kMaxPathLength - 1] = '\0';
+}
+
+inline sockaddr_un socketAddress(const std::string &socketPath)
+{
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        throw std::invalid_argument("Service Error: socket path is too long");
+    }
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    return address;
+}
+/**
+ * @brief Check that a segment layout is the one of its mesh size, and that it fits in the mapping.
+ */
+void checkLayout(const SegmentHeader &layout, size_t mappedSize)
+{
+    const uint64_t rowSize = 3 * sizeof(double);
+    // bounded first, so that the expected layout computation cannot overflow
+    bool valid = layout.num_vertices <= mappedSize / rowSize && layout.num_faces <= mappedSize / rowSize;
+    if (valid)
+    {
+        const SegmentHeader expected = SegmentHeader::layout(layout.num_vertices, layout.num_faces);
+        valid = layout.vertices_offset == expected.vertices_offset &&
+                layout.face_normals_offset == expected.face_normals_offset &&
+                layout.vertex_normals_offset == expected.vertex_normals_offset && layout.size == expected.size &&
+                expected.size <= mappedSize;
+    }
+    if (!valid)
+    {
+        throw std::invalid_argument("Service Error: shared memory segment header does not match the segment");
+    }
+}
+} // namespace
+
+SegmentHeader SegmentHeader::layout(uint64_t num_vertices, uint64_t num_faces)
+{
+    SegmentHeader header;
+    header.num_vertices = num_vertices;
+    header.num_faces = num_faces;
+    header.vertices_offset = alignUp(sizeof(SegmentHeader));
+    header.face_normals_offset = alignUp(header.vertices_offset + 3 * sizeof(double) * num_vertices);
+    header.vertex_normals_offset = alignUp(header.face_normals_offset + 3 * sizeof(double) * num_faces);
+    header.size = alignUp(header.vertex_normals_offset + 3 * sizeof(double) * num_vertices);
+    return header;
+}
+
+SharedSegment::SharedSegment(const std::string &name, const SegmentHeader &layout)
+    : name(name), address(nullptr), size(layout.size), owner(true), layout(layout)
+{
+    checkLayout(layout, size);
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+    {
+        throw systemError("cannot create shared memory segment " + name);
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        close(fd);
+        shm_unlink(name.c_str());
+        throw systemError("cannot size shared memory segment " + name);
+    }
+    map(fd);
+    std::memcpy(address, &layout, sizeof(layout));
+}
+
+SharedSegment::SharedSegment(const std::string &name) : name(name), address(nullptr), size(0), owner(false)
+{
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+    {
+        throw systemError("cannot open shared memory segment " + name);
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0)
+    {
+        close(fd);
+        throw systemError("cannot stat shared memory segment " + name);
+    }
+    size = static_cast<size_t>(status.st_size);
+    if (size < sizeof(SegmentHeader))
+    {
+        close(fd);
+        throw std::invalid_argument("Service Error: shared memory segment " + name + " is too small");
+    }
+    map(fd);
+    std::memcpy(&layout, address, sizeof(layout));
+    try
+    {
+        checkLayout(layout, size);
+    }
+    catch (...)
+    {
+        munmap(address, size);
+        throw;
+    }
+}
+
+void SharedSegment::map(int fd)
+{
+    address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED)
+    {
+        if (owner)
+        {
+            shm_unlink(name.c_str());
+        }
+        throw systemError("cannot map shared memory segment " + name);
+    }
+}
+
+SharedSegment::~SharedSegment()
+{
+    munmap(address, size);
+    if (owner)
+    {
+        shm_unlink(name.c_str());
+    }
+}
+
+Eigen::Map<bunny_dataIO::Point3DMatrixType> SharedSegment::vertices()
+{
+    double *data = reinterpret_cast<double *>(static_cast<char *>(address) + layout.vertices_offset);
+    return Eigen::Map<bunny_dataIO::Point3DMatrixType>(data, layout.num_vertices, 3);
+}
+
+Eigen::Map<bunny_dataIO::Point3DMatrixType> SharedSegment::faceNormals()
+{
+    double *data = reinterpret_cast<double *>(static_cast<char *>(address) + layout.face_normals_offset);
+    return Eigen::Map<bunny_dataIO::Point3DMatrixType>(data, layout.num_faces, 3);
+}
+
+Eigen::Map<bunny_dataIO::Point3DMatrixType> SharedSegment::vertexNormals()
+{
+    double *data = reinterpret_cast<double *>(static_cast<char *>(address) + layout.vertex_normals_offset);
+    return Eigen::Map<bunny_dataIO::Point3DMatrixType>(data, layout.num_vertices, 3);
+}
+
+NormalsServer::NormalsServer(const std::string &socketPath) : socket_path(socketPath), listen_fd(-1)
+{
+    sockaddr_un address = socketAddress(socketPath);
+    if (pipe(wake_pipe) != 0)
+    {
+        throw systemError("cannot create wake pipe");
+    }
+    // message boundaries are kept by SOCK_SEQPACKET, so a request is always read in one call
+    listen_fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    if (listen_fd < 0)
+    {
+        throw systemError("cannot create socket");
+    }
+    unlink(socketPath.c_str());
+    if (bind(listen_fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || listen(listen_fd, 16) != 0)
+    {
+        close(listen_fd);
+        close(wake_pipe[0]);
+        close(wake_pipe[1]);
+        throw systemError("cannot listen on " + socketPath);
+    }
+}
+
+NormalsServer::~NormalsServer()
+{
+    close(listen_fd);
+    close(wake_pipe[0]);
+    close(wake_pipe[1]);
+    unlink(socket_path.c_str());
+}
+
+void NormalsServer::stop()
+{
+    char byte = 0;
+    ssize_t written = write(wake_pipe[1], &byte, 1);
+    (void)written;
+}
+
+void NormalsServer::run()
+{
+    std::vector<pollfd> fds;
+    fds.push_back({listen_fd, POLLIN, 0});
+    fds.push_back({wake_pipe[0], POLLIN, 0});
+    bool running = true;
+    while (running)
+    {
+        if (poll(fds.data(), fds.size(), -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw systemError("poll failed");
+        }
+        if (fds[1].revents != 0)
+        {
+            break;
+        }
+        if (fds[0].revents & POLLIN)
+        {
+            int client = accept(listen_fd, nullptr, nullptr);
+            if (client >= 0)
+            {
+                fds.push_back({client, POLLIN, 0});
+            }
+        }
+        for (size_t i = 2; i < fds.size() && running; i++)
+        {
+            if (fds[i].revents == 0)
+            {
+                continue;
+            }
+            Request request;
+            ssize_t received = recv(fds[i].fd, &request, sizeof(request), 0);
+            if (received <= 0)
+            {
+                // client disconnected
+                close(fds[i].fd);
+                fds[i].fd = -1;
+                continue;
+            }
+            Response response;
+            std::memset(&response, 0, sizeof(response));
+            if (received != sizeof(request))
+            {
+                response.status = -1;
+                copyField(response.message, "malformed request");
+            }
+            else
+            {
+                running = handle(request, response);
+            }
+            if (send(fds[i].fd, &response, sizeof(response), MSG_NOSIGNAL) != sizeof(response))
+            {
+                close(fds[i].fd);
+                fds[i].fd = -1;
+            }
+        }
+        // forget disconnected clients
+        size_t kept = 2;
+        for (size_t i = 2; i < fds.size(); i++)
+        {
+            if (fds[i].fd >= 0)
+            {
+                fds[kept++] = fds[i];
+            }
+        }
+        fds.resize(kept);
+    }
+    for (size_t i = 2; i < fds.size(); i++)
+    {
+        close(fds[i].fd);
+    }
+}
+
+/**
+ * @brief Serve one request.
+ *
+ * Errors are reported in the response, a bad request never stops the server.
+ */
+bool NormalsServer::handle(const Request &request, Response &response)
+{
+    response.mesh_id = request.mesh_id;
+    try
+    {
+        switch (request.command)
+        {
+        case CommandLoad:
+        {
+            if (meshes.count(request.mesh_id) != 0)
+            {
+                throw std::invalid_argument("Service Error: mesh id already loaded");
+            }
+            std::string facesPath(request.faces_path, strnlen(request.faces_path, kMaxPathLength));
+            std::string verticesPath(request.vertices_path, strnlen(request.vertices_path, kMaxPathLength));
+            bunny_dataIO::IndexMatrixType faces = bunny_dataIO::readIntNumPyArray(facesPath);
+            bunny_dataIO::Point3DMatrixType vertices = bunny_dataIO::readFloatNumPyArray(verticesPath);
+            // faces come from a client file, every later compute indexes the vertices with them
+            if (faces.size() > 0 && (faces.minCoeff() < 0 || faces.maxCoeff() >= vertices.rows()))
+            {
+                throw std::out_of_range("Service Error: face index out of vertices range");
+            }
+
+            ResidentMesh resident;
+            resident.mesh.reset(new TriangleMesh(vertices, faces));
+            SegmentHeader layout = SegmentHeader::layout(vertices.rows(), faces.rows());
+            std::string name = "/bunny_mesh." + std::to_string(getpid()) + "." + std::to_string(request.mesh_id);
+            resident.segment.reset(new SharedSegment(name, layout));
+            resident.layout = resident.segment->header();
+            resident.segment->vertices() = vertices;
+
+            response.num_vertices = layout.num_vertices;
+            response.num_faces = layout.num_faces;
+            copyField(response.segment, name);
+            meshes[request.mesh_id] = std::move(resident);
+            break;
+        }
+        case CommandCompute:
+        {
+            auto found = meshes.find(request.mesh_id);
+            if (found == meshes.end())
+            {
+                throw std::invalid_argument("Service Error: unknown mesh id");
+            }
+            TriangleMesh &mesh = *found->second.mesh;
+            SharedSegment &segment = *found->second.segment;
+            const SegmentHeader &layout = found->second.layout;
+            // client supplied values, compared without a sum that could wrap around
+            if (request.vertex_offset > layout.num_vertices ||
+                request.vertex_count > layout.num_vertices - request.vertex_offset)
+            {
+                throw std::out_of_range("Service Error: vertices block out of vertices range");
+            }
+            if (request.vertex_count > 0)
+            {
+                mesh.setVerticesBlock(request.vertex_offset,
+                                      segment.vertices().middleRows(request.vertex_offset, request.vertex_count));
+            }
+            const bunny_dataIO::Point3DType orientation(request.orientation[0], request.orientation[1],
+                                                        request.orientation[2]);
+            // a zero or non finite orientation would make every normal not a number
+            const double norm = orientation.stableNorm();
+            if (!(norm > 0.0) || !std::isfinite(norm))
+            {
+                throw std::invalid_argument("Service Error: orientation must be a finite non zero vector");
+            }
+            mesh.setOrientation(orientation / norm);
+            mesh.ComputeNormals(segment.faceNormals(), segment.vertexNormals());
+            response.num_vertices = layout.num_vertices;
+            response.num_faces = layout.num_faces;
+            break;
+        }
+        case CommandUnload:
+            meshes.erase(request.mesh_id);
+            break;
+        case CommandShutdown:
+            return false;
+        default:
+            throw std::invalid_argument("Service Error: unknown command");
+        }
+    }
+    catch (const std::exception &e)
+    {
+        response.status = -1;
+        copyField(response.message, e.what());
+    }
+    return true;
+}
+
+NormalsClient::NormalsClient(const std::string &socketPath)
+{
+    sockaddr_un address = socketAddress(socketPath);
+    fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    if (fd < 0)
+    {
+        throw systemError("cannot create socket");
+    }
+    if (connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        throw systemError("cannot connect to " + socketPath);
+    }
+}
+
+NormalsClient::~NormalsClient()
+{
+    segments.clear();
+    close(fd);
+}
+
+Response NormalsClient::call(const Request &request)
+{
+    if (send(fd, &request, sizeof(request), MSG_NOSIGNAL) != sizeof(request))
+    {
+        throw systemError("cannot send request");
+    }
+    Response response;
+    if (recv(fd, &response, sizeof(response), 0) != sizeof(response))
+    {
+        throw systemError("cannot receive response");
+    }
+    if (response.status != 0)
+    {
+        throw std::runtime_error(std::string(response.message, strnlen(response.message, kMaxPathLength)));
+    }
+    return response;
+}
+
+SharedSegment &NormalsClient::load(uint32_t meshId, const std::string &facesPath, const std::string &verticesPath)
+{
+    Request request;
+    std::memset(&request, 0, sizeof(request));
+    request.command = CommandLoad;
+    request.mesh_id = meshId;
+    copyField(request.faces_path, facesPath);
+    copyField(request.vertices_path, verticesPath);
+    Response response = call(request);
+    std::unique_ptr<SharedSegment> &segment = segments[meshId];
+    segment.reset(new SharedSegment(std::string(response.segment, strnlen(response.segment, kMaxPathLength))));
+    return *segment;
+}
+
+void NormalsClient::compute(uint32_t meshId, const bunny_dataIO::Point3DType &orientation, uint64_t vertexOffset,
+                            uint64_t vertexCount)
+{
+    Request request;
+    std::memset(&request, 0, sizeof(request));
+    request.command = CommandCompute;
+    request.mesh_id = meshId;
+    request.orientation[0] = orientation(0);
+    request.orientation[1] = orientation(1);
+    request.orientation[2] = orientation(2);
+    request.vertex_offset = vertexOffset;
+    request.vertex_count = vertexCount;
+    call(request);
+}
+
+void NormalsClient::unload(uint32_t meshId)
+{
+    segments.erase(meshId);
+    Request request;
+    std::memset(&request, 0, sizeof(request));
+    request.command = CommandUnload;
+    request.mesh_id = meshId;
+    call(request);
+}
+
+void NormalsClient::shutdown()
+{
+    Request request;
+    std::memset(&request, 0, sizeof(request));
+    request.command = CommandShutdown;
+    call(request);
+}
+
+} // namespace service
+} // namespace bunny_mesh
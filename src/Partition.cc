@@ -0,0 +1,723 @@
+/**
+ * @file Partition.cc
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Source file of Partition.h header file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "bunny_mesh/Partition.h"
+#include "bunny_mesh/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace bunny_mesh
+{
+namespace distributed
+{
+namespace
+{
+// Morton keys interleave 21 bits per axis
+const double kMortonGridMax = double((1u << 21) - 1);
+
+// arrays of the shared mapping start on cache lines
+const size_t kAlignment = 64;
+
+// Maximal length of the error message of a failed rank
+const size_t kMaxMessageLength = 256;
+
+// Pause between two polls of the running ranks
+const long kWaitPollNanoseconds = 1000000;
+
+inline size_t alignUp(size_t value) { return (value + kAlignment - 1) / kAlignment * kAlignment; }
+
+/**
+ * @brief Spread the 21 low bits of a value to every third bit.
+ */
+inline uint64_t expandBits(uint64_t x)
+{
+    x &= 0x1fffff;
+    x = (x | x << 32) & 0x1f00000000ffffull;
+    x = (x | x << 16) & 0x1f0000ff0000ffull;
+    x = (x | x << 8) & 0x100f00f00f00f00full;
+    x = (x | x << 4) & 0x10c30c30c30c30c3ull;
+    x = (x | x << 2) & 0x1249249249249249ull;
+    return x;
+}
+
+/**
+ * @brief Grid cell of a coordinate along one axis, not a number going to the first cell.
+ */
+inline uint64_t gridCell(double value, double lo, double scale)
+{
+    double cell = (value - lo) * scale;
+    return static_cast<uint64_t>(cell > 0.0 ? std::min(cell, kMortonGridMax) : 0.0);
+}
+
+/**
+ * @brief Local index of a global vertex in a partition.
+ */
+inline int localVertex(const MeshPartition &partition, int global)
+{
+    return static_cast<int>(std::lower_bound(partition.global_vertices.begin(), partition.global_vertices.end(),
+                                             global) -
+                            partition.global_vertices.begin());
+}
+
+/**
+ * @brief State of the ranks, at the start of the shared mapping.
+ */
+struct ControlBlock
+{
+    std::atomic<int> arrived;
+    std::atomic<int> generation;
+    std::atomic<int> failed;
+    char message[kMaxMessageLength];
+};
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "process shared atomics must be lock free");
+
+/**
+ * @brief Record the first failure of a rank, so that the others stop at their next barrier.
+ */
+void recordFailure(ControlBlock &control, const char *message)
+{
+    int expected = 0;
+    if (control.failed.compare_exchange_strong(expected, 1))
+    {
+        std::strncpy(control.message, message, kMaxMessageLength - 1);
+        control.message[kMaxMessageLength - 1] = '\0';
+    }
+}
+
+/**
+ * @brief Halo exchange between forked ranks, through one mailbox per ordered rank pair.
+ */
+class SharedMemoryExchange : public HaloExchange
+{
+public:
+    SharedMemoryExchange(ControlBlock &control, int numRanks, int rank, char *mailboxes,
+                         const std::vector<size_t> &offsets, const std::vector<size_t> &capacities)
+        : control(control), num_ranks(numRanks), rank(rank), mailboxes(mailboxes), offsets(offsets),
+          capacities(capacities)
+    {
+    }
+
+    void exchange(const std::vector<HaloLink> &sendLinks, const std::vector<bunny_dataIO::Point3DMatrixType> &sendRows,
+                  const std::vector<HaloLink> &receiveLinks,
+                  std::vector<bunny_dataIO::Point3DMatrixType> &receiveRows) override
+    {
+        for (size_t i = 0; i < sendLinks.size(); i++)
+        {
+            std::memcpy(mailbox(rank, sendLinks[i].rank, sendRows[i].rows()), sendRows[i].data(),
+                        sendRows[i].size() * sizeof(double));
+        }
+        barrier();
+        for (size_t i = 0; i < receiveLinks.size(); i++)
+        {
+            std::memcpy(receiveRows[i].data(), mailbox(receiveLinks[i].rank, rank, receiveRows[i].rows()),
+                        receiveRows[i].size() * sizeof(double));
+        }
+        // mailboxes are rewritten by the next exchange
+        barrier();
+    }
+
+    /**
+     * @brief Wait for every rank, or throw when one of them failed.
+     */
+    void barrier()
+    {
+        const int generation = control.generation.load(std::memory_order_acquire);
+        if (control.arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == num_ranks)
+        {
+            control.arrived.store(0, std::memory_order_relaxed);
+            control.generation.fetch_add(1, std::memory_order_acq_rel);
+            return;
+        }
+        while (control.generation.load(std::memory_order_acquire) == generation)
+        {
+            if (control.failed.load(std::memory_order_acquire))
+            {
+                throw std::runtime_error("Partition Error: another rank failed");
+            }
+            sched_yield();
+        }
+    }
+
+private:
+    char *mailbox(int from, int to, Eigen::Index rows)
+    {
+        const size_t pair = static_cast<size_t>(from) * num_ranks + to;
+        if (static_cast<size_t>(rows) > capacities[pair])
+        {
+            throw std::length_error("Partition Error: halo message larger than its mailbox");
+        }
+        return mailboxes + offsets[pair];
+    }
+
+    ControlBlock &control;
+    int num_ranks;
+    int rank;
+    char *mailboxes;
+    const std::vector<size_t> &offsets;
+    const std::vector<size_t> &capacities;
+};
+
+/**
+ * @brief Anonymous shared mapping, inherited by the forked ranks and unmapped when going out of scope.
+ */
+struct SharedMapping
+{
+    explicit SharedMapping(size_t size) : size(size)
+    {
+        address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (address == MAP_FAILED)
+        {
+            throw std::runtime_error(std::string("Partition Error: cannot map shared memory: ") + std::strerror(errno));
+        }
+    }
+    ~SharedMapping() { munmap(address, size); }
+
+    SharedMapping(const SharedMapping &) = delete;
+    SharedMapping &operator=(const SharedMapping &) = delete;
+
+    void *address;
+    size_t size;
+};
+
+/**
+ * @brief Body of a forked rank: compute its partition and write its faces and owned vertices. Never returns.
+ */
+void runRank(const MeshPartition &partition, SharedMemoryExchange &exchange, ControlBlock &control,
+             unsigned threads, Eigen::Map<bunny_dataIO::Point3DMatrixType> &faceNormals,
+             Eigen::Map<bunny_dataIO::Point3DMatrixType> &verticesNormals)
+{
+    int status = EXIT_SUCCESS;
+    try
+    {
+        parallel::setNumThreads(threads);
+        bunny_dataIO::Point3DMatrixType localFaceNormals, localVerticesNormals;
+        computePartitionNormals(partition, exchange, localFaceNormals, localVerticesNormals);
+
+        for (size_t i = 0; i < partition.global_faces.size(); i++)
+        {
+            faceNormals.row(partition.global_faces[i]) = localFaceNormals.row(i);
+        }
+        // vertices owned by other ranks are written by their owner
+        std::vector<char> owned(partition.global_vertices.size(), 1);
+        for (const HaloLink &link : partition.contributions)
+        {
+            for (int v : link.vertices)
+            {
+                owned[v] = 0;
+            }
+        }
+        for (size_t v = 0; v < owned.size(); v++)
+        {
+            if (owned[v])
+            {
+                verticesNormals.row(partition.global_vertices[v]) = localVerticesNormals.row(v);
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        recordFailure(control, e.what());
+        status = EXIT_FAILURE;
+    }
+    // the forked copy of the caller must not run its exit handlers nor flush its streams
+    _exit(status);
+}
+} // namespace
+
+std::vector<MeshPartition> partitionMesh(const bunny_dataIO::Point3DMatrixType &vertices,
+                                         const bunny_dataIO::IndexMatrixType &faces, int numPartitions)
+{
+    const size_t num_faces = faces.rows();
+    const size_t num_vertices = vertices.rows();
+    if (numPartitions < 1)
+    {
+        throw std::invalid_argument("Partition Error: at least one partition is needed");
+    }
+    if (faces.size() > 0 && (faces.minCoeff() < 0 || static_cast<size_t>(faces.maxCoeff()) >= num_vertices))
+    {
+        throw std::out_of_range("Partition Error: face index out of vertices range");
+    }
+
+    // faces along the Morton curve of their centroids, ties broken by face index
+    bunny_dataIO::Point3DType lo = bunny_dataIO::Point3DType::Zero(), hi = bunny_dataIO::Point3DType::Zero();
+    if (num_vertices > 0)
+    {
+        lo = vertices.colwise().minCoeff();
+        hi = vertices.colwise().maxCoeff();
+    }
+    bunny_dataIO::Point3DType scale;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        scale(axis) = hi(axis) > lo(axis) ? kMortonGridMax / (hi(axis) - lo(axis)) : 0.0;
+    }
+    std::vector<std::pair<uint64_t, int>> curve(num_faces);
+    parallel::parallelFor(0, num_faces, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            bunny_dataIO::Point3DType centroid =
+                (vertices.row(faces(i, 0)) + vertices.row(faces(i, 1)) + vertices.row(faces(i, 2))) / 3.0;
+            uint64_t key = expandBits(gridCell(centroid(0), lo(0), scale(0))) |
+                           expandBits(gridCell(centroid(1), lo(1), scale(1))) << 1 |
+                           expandBits(gridCell(centroid(2), lo(2), scale(2))) << 2;
+            curve[i] = std::make_pair(key, static_cast<int>(i));
+        }
+    });
+    std::sort(curve.begin(), curve.end());
+
+    // contiguous ranges of the curve, renumbered locally through a global to local map per worker
+    std::vector<MeshPartition> partitions(numPartitions);
+    parallel::parallelFor(0, partitions.size(), [&](size_t begin, size_t end) {
+        std::vector<int> locals(num_vertices, -1);
+        for (size_t rank = begin; rank < end; rank++)
+        {
+            MeshPartition &partition = partitions[rank];
+            partition.rank = static_cast<int>(rank);
+            const size_t first = num_faces * rank / numPartitions;
+            const size_t last = num_faces * (rank + 1) / numPartitions;
+            partition.global_faces.resize(last - first);
+            for (size_t i = first; i < last; i++)
+            {
+                partition.global_faces[i - first] = curve[i].second;
+            }
+            // global face order inside the partition, the summation order of the serial algorithm
+            std::sort(partition.global_faces.begin(), partition.global_faces.end());
+
+            std::vector<int> &global_vertices = partition.global_vertices;
+            for (int face : partition.global_faces)
+            {
+                for (int k = 0; k < 3; k++)
+                {
+                    if (locals[faces(face, k)] < 0)
+                    {
+                        locals[faces(face, k)] = 0;
+                        global_vertices.push_back(faces(face, k));
+                    }
+                }
+            }
+            std::sort(global_vertices.begin(), global_vertices.end());
+            for (size_t v = 0; v < global_vertices.size(); v++)
+            {
+                locals[global_vertices[v]] = static_cast<int>(v);
+            }
+
+            partition.faces.resize(partition.global_faces.size(), 3);
+            for (size_t i = 0; i < partition.global_faces.size(); i++)
+            {
+                for (int k = 0; k < 3; k++)
+                {
+                    partition.faces(i, k) = locals[faces(partition.global_faces[i], k)];
+                }
+            }
+            partition.vertices.resize(global_vertices.size(), 3);
+            for (size_t v = 0; v < global_vertices.size(); v++)
+            {
+                partition.vertices.row(v) = vertices.row(global_vertices[v]);
+                locals[global_vertices[v]] = -1;
+            }
+        }
+    }, 1);
+    for (MeshPartition &partition : partitions)
+    {
+        partition.adjacency = buildVertexFaceAdjacency(partition.faces, partition.vertices.rows());
+    }
+
+    // the lowest rank referencing a vertex owns it
+    std::vector<int> owners(num_vertices, -1);
+    for (const MeshPartition &partition : partitions)
+    {
+        for (int global : partition.global_vertices)
+        {
+            if (owners[global] < 0)
+            {
+                owners[global] = partition.rank;
+            }
+        }
+    }
+    // ranks are visited in increasing order, so the boundary links of each owner are sorted by rank
+    for (MeshPartition &partition : partitions)
+    {
+        std::map<int, HaloLink> links;
+        for (size_t v = 0; v < partition.global_vertices.size(); v++)
+        {
+            int owner = owners[partition.global_vertices[v]];
+            if (owner != partition.rank)
+            {
+                HaloLink &link = links[owner];
+                link.rank = owner;
+                link.vertices.push_back(static_cast<int>(v));
+            }
+        }
+        for (auto &entry : links)
+        {
+            MeshPartition &owner = partitions[entry.first];
+            HaloLink &link = entry.second;
+            // faces around the shared vertices cross the link once, local face order being the global one
+            for (int v : link.vertices)
+            {
+                for (int corner = partition.adjacency.offsets[v]; corner < partition.adjacency.offsets[v + 1]; corner++)
+                {
+                    link.faces.push_back(partition.adjacency.corners[corner] / 3);
+                }
+            }
+            std::sort(link.faces.begin(), link.faces.end());
+            link.faces.erase(std::unique(link.faces.begin(), link.faces.end()), link.faces.end());
+
+            HaloLink boundary;
+            boundary.rank = partition.rank;
+            boundary.vertices.reserve(link.vertices.size());
+            for (int v : link.vertices)
+            {
+                boundary.vertices.push_back(localVertex(owner, partition.global_vertices[v]));
+            }
+            boundary.faces.reserve(link.faces.size());
+            for (int face : link.faces)
+            {
+                boundary.faces.push_back(partition.global_faces[face]);
+            }
+            owner.boundary.push_back(std::move(boundary));
+            partition.contributions.push_back(std::move(link));
+        }
+    }
+
+    // owners sum the local and received faces of their shared vertices in global face order
+    parallel::parallelFor(0, partitions.size(), [&](size_t begin, size_t end) {
+        for (size_t rank = begin; rank < end; rank++)
+        {
+            MeshPartition &owner = partitions[rank];
+            for (const HaloLink &link : owner.boundary)
+            {
+                owner.shared_vertices.insert(owner.shared_vertices.end(), link.vertices.begin(), link.vertices.end());
+            }
+            std::sort(owner.shared_vertices.begin(), owner.shared_vertices.end());
+            owner.shared_vertices.erase(std::unique(owner.shared_vertices.begin(), owner.shared_vertices.end()),
+                                        owner.shared_vertices.end());
+
+            // (global face, term) pairs of each shared vertex
+            std::vector<std::vector<std::pair<int, int>>> terms(owner.shared_vertices.size());
+            for (size_t k = 0; k < owner.shared_vertices.size(); k++)
+            {
+                const int v = owner.shared_vertices[k];
+                for (int corner = owner.adjacency.offsets[v]; corner < owner.adjacency.offsets[v + 1]; corner++)
+                {
+                    const int face = owner.adjacency.corners[corner] / 3;
+                    terms[k].push_back(std::make_pair(owner.global_faces[face], face));
+                }
+            }
+            int row = 0;
+            for (const HaloLink &link : owner.boundary)
+            {
+                const MeshPartition &sender = partitions[link.rank];
+                const HaloLink &sent = *std::find_if(sender.contributions.begin(), sender.contributions.end(),
+                                                     [&](const HaloLink &other) { return other.rank == owner.rank; });
+                for (size_t i = 0; i < link.vertices.size(); i++)
+                {
+                    const size_t k = std::lower_bound(owner.shared_vertices.begin(), owner.shared_vertices.end(),
+                                                      link.vertices[i]) -
+                                     owner.shared_vertices.begin();
+                    const int v = sent.vertices[i];
+                    for (int corner = sender.adjacency.offsets[v]; corner < sender.adjacency.offsets[v + 1]; corner++)
+                    {
+                        const int face = sender.adjacency.corners[corner] / 3;
+                        const int position = static_cast<int>(
+                            std::lower_bound(sent.faces.begin(), sent.faces.end(), face) - sent.faces.begin());
+                        terms[k].push_back(std::make_pair(sender.global_faces[face], -(1 + row + position)));
+                    }
+                }
+                row += static_cast<int>(link.faces.size());
+            }
+
+            owner.shared_terms_offsets.assign(1, 0);
+            for (std::vector<std::pair<int, int>> &vertexTerms : terms)
+            {
+                std::stable_sort(vertexTerms.begin(), vertexTerms.end(),
+                                 [](const std::pair<int, int> &a, const std::pair<int, int> &b) {
+                                     return a.first < b.first;
+                                 });
+                for (const std::pair<int, int> &term : vertexTerms)
+                {
+                    owner.shared_terms.push_back(term.second);
+                }
+                owner.shared_terms_offsets.push_back(static_cast<int>(owner.shared_terms.size()));
+            }
+        }
+    }, 1);
+    return partitions;
+}
+
+void computePartitionNormals(const MeshPartition &partition, HaloExchange &exchange,
+                             bunny_dataIO::Point3DMatrixType &faceNormals,
+                             bunny_dataIO::Point3DMatrixType &verticesNormals)
+{
+    const size_t num_faces = partition.faces.rows();
+    const size_t num_vertices = partition.vertices.rows();
+    if (partition.adjacency.offsets.size() != num_vertices + 1 || partition.adjacency.corners.size() != 3 * num_faces)
+    {
+        throw std::invalid_argument("Partition Error: vertex face adjacency does not match the partition");
+    }
+    faceNormals.resize(num_faces, 3);
+    verticesNormals.resize(num_vertices, 3);
+
+    // unnormalized face normals, same expression as computeMeshNormals()
+    parallel::parallelFor(0, num_faces, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            bunny_dataIO::Point3DType v0 = partition.vertices.row(partition.faces(i, 0));
+            bunny_dataIO::Point3DType v1 = partition.vertices.row(partition.faces(i, 1));
+            bunny_dataIO::Point3DType v2 = partition.vertices.row(partition.faces(i, 2));
+            faceNormals.row(i) = (v1 - v0).cross(v2 - v1);
+        }
+    });
+
+    // local faces are in global order, so the local sums follow the serial summation order
+    parallel::parallelFor(0, num_vertices, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; v++)
+        {
+            verticesNormals.row(v).setZero();
+            for (int corner = partition.adjacency.offsets[v]; corner < partition.adjacency.offsets[v + 1]; corner++)
+            {
+                verticesNormals.row(v) += faceNormals.row(partition.adjacency.corners[corner] / 3);
+            }
+        }
+    });
+
+    // face normals around the shared vertices go to their owners
+    std::vector<bunny_dataIO::Point3DMatrixType> contributions(partition.contributions.size());
+    std::vector<bunny_dataIO::Point3DMatrixType> boundary(partition.boundary.size());
+    for (size_t i = 0; i < partition.contributions.size(); i++)
+    {
+        contributions[i].resize(partition.contributions[i].faces.size(), 3);
+        for (size_t k = 0; k < partition.contributions[i].faces.size(); k++)
+        {
+            contributions[i].row(k) = faceNormals.row(partition.contributions[i].faces[k]);
+        }
+    }
+    size_t numReceived = 0;
+    for (size_t i = 0; i < partition.boundary.size(); i++)
+    {
+        boundary[i].resize(partition.boundary[i].faces.size(), 3);
+        numReceived += partition.boundary[i].faces.size();
+    }
+    exchange.exchange(partition.contributions, contributions, partition.boundary, boundary);
+
+    // which sum them with their local faces, in the serial order
+    bunny_dataIO::Point3DMatrixType received(numReceived, 3);
+    numReceived = 0;
+    for (const bunny_dataIO::Point3DMatrixType &rows : boundary)
+    {
+        received.middleRows(numReceived, rows.rows()) = rows;
+        numReceived += rows.rows();
+    }
+    for (size_t k = 0; k < partition.shared_vertices.size(); k++)
+    {
+        const int v = partition.shared_vertices[k];
+        verticesNormals.row(v).setZero();
+        for (int term = partition.shared_terms_offsets[k]; term < partition.shared_terms_offsets[k + 1]; term++)
+        {
+            const int source = partition.shared_terms[term];
+            if (source >= 0)
+            {
+                verticesNormals.row(v) += faceNormals.row(source);
+            }
+            else
+            {
+                verticesNormals.row(v) += received.row(-source - 1);
+            }
+        }
+    }
+
+    parallel::parallelFor(0, num_vertices, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; v++)
+        {
+            verticesNormals.row(v) /= verticesNormals.row(v).norm();
+        }
+    });
+
+    // owners send the normalized vertex normals back
+    for (size_t i = 0; i < partition.boundary.size(); i++)
+    {
+        boundary[i].resize(partition.boundary[i].vertices.size(), 3);
+        for (size_t k = 0; k < partition.boundary[i].vertices.size(); k++)
+        {
+            boundary[i].row(k) = verticesNormals.row(partition.boundary[i].vertices[k]);
+        }
+    }
+    for (size_t i = 0; i < partition.contributions.size(); i++)
+    {
+        contributions[i].resize(partition.contributions[i].vertices.size(), 3);
+    }
+    exchange.exchange(partition.boundary, boundary, partition.contributions, contributions);
+    for (size_t i = 0; i < partition.contributions.size(); i++)
+    {
+        for (size_t k = 0; k < partition.contributions[i].vertices.size(); k++)
+        {
+            verticesNormals.row(partition.contributions[i].vertices[k]) = contributions[i].row(k);
+        }
+    }
+
+    parallel::parallelFor(0, num_faces, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            bunny_dataIO::Point3DType faceNormal = faceNormals.row(i);
+            faceNormal.normalize();
+            faceNormals.row(i) = faceNormal;
+        }
+    });
+}
+
+void computePartitionedNormals(const std::vector<MeshPartition> &partitions, size_t num_vertices, size_t num_faces,
+                               bunny_dataIO::Point3DMatrixType &faceNormals,
+                               bunny_dataIO::Point3DMatrixType &verticesNormals)
+{
+    const int numRanks = static_cast<int>(partitions.size());
+    if (numRanks < 1)
+    {
+        throw std::invalid_argument("Partition Error: at least one partition is needed");
+    }
+
+    // a mailbox (from, to) carries the face normals sent to the owner, or the vertex normals sent by the owner
+    std::vector<size_t> capacities(partitions.size() * partitions.size(), 0);
+    for (const MeshPartition &partition : partitions)
+    {
+        for (const HaloLink &link : partition.contributions)
+        {
+            capacities[partition.rank * numRanks + link.rank] += link.faces.size();
+        }
+        for (const HaloLink &link : partition.boundary)
+        {
+            capacities[partition.rank * numRanks + link.rank] += link.vertices.size();
+        }
+    }
+
+    const size_t faceNormalsOffset = alignUp(sizeof(ControlBlock));
+    const size_t verticesNormalsOffset = alignUp(faceNormalsOffset + 3 * sizeof(double) * num_faces);
+    size_t mailboxesSize = 0;
+    std::vector<size_t> offsets(capacities.size());
+    for (size_t pair = 0; pair < capacities.size(); pair++)
+    {
+        offsets[pair] = mailboxesSize;
+        mailboxesSize = alignUp(mailboxesSize + 3 * sizeof(double) * capacities[pair]);
+    }
+    const size_t mailboxesOffset = alignUp(verticesNormalsOffset + 3 * sizeof(double) * num_vertices);
+    SharedMapping mapping(mailboxesOffset + mailboxesSize);
+
+    char *base = static_cast<char *>(mapping.address);
+    ControlBlock &control = *new (base) ControlBlock();
+    control.arrived.store(0);
+    control.generation.store(0);
+    control.failed.store(0);
+    Eigen::Map<bunny_dataIO::Point3DMatrixType> sharedFaceNormals(
+        reinterpret_cast<double *>(base + faceNormalsOffset), num_faces, 3);
+    Eigen::Map<bunny_dataIO::Point3DMatrixType> sharedVerticesNormals(
+        reinterpret_cast<double *>(base + verticesNormalsOffset), num_vertices, 3);
+    sharedVerticesNormals.setZero();
+
+    const unsigned threads = std::max(1u, parallel::numThreads() / static_cast<unsigned>(numRanks));
+    std::vector<pid_t> ranks;
+    std::string forkError;
+    for (const MeshPartition &partition : partitions)
+    {
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            SharedMemoryExchange exchange(control, numRanks, partition.rank, base + mailboxesOffset, offsets,
+                                          capacities);
+            runRank(partition, exchange, control, threads, sharedFaceNormals, sharedVerticesNormals);
+        }
+        if (pid < 0)
+        {
+            // the forked ranks give up at their first barrier
+            forkError = std::string("cannot fork a rank: ") + std::strerror(errno);
+            recordFailure(control, forkError.c_str());
+            break;
+        }
+        ranks.push_back(pid);
+    }
+
+    // ranks are polled in turn and reaped in the order they end, leaving the other children of the process to their
+    // owner: a rank killed by a signal never reaches its catch block, so its failure is recorded here, and the ranks
+    // waiting for it at a barrier give up
+    bool failed = !forkError.empty();
+    std::vector<pid_t> running = ranks;
+    while (!running.empty())
+    {
+        bool reaped = false;
+        for (size_t i = 0; i < running.size();)
+        {
+            int status = 0;
+            const pid_t pid = waitpid(running[i], &status, WNOHANG);
+            if (pid == 0 || (pid < 0 && errno == EINTR))
+            {
+                i++;
+                continue;
+            }
+            // a pid reaped by someone else (ECHILD) has lost its status, a failure it caught is still recorded
+            if (pid > 0 && WIFSIGNALED(status))
+            {
+                const size_t rank = std::find(ranks.begin(), ranks.end(), pid) - ranks.begin();
+                const std::string message =
+                    "rank " + std::to_string(rank) + " killed by signal " + std::to_string(WTERMSIG(status));
+                recordFailure(control, message.c_str());
+                failed = true;
+            }
+            else if (pid > 0 && (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS))
+            {
+                recordFailure(control, "terminated abnormally");
+                failed = true;
+            }
+            running.erase(running.begin() + i);
+            reaped = true;
+        }
+        if (!reaped && !running.empty())
+        {
+            const timespec pause = {0, kWaitPollNanoseconds};
+            nanosleep(&pause, nullptr);
+        }
+    }
+    failed = failed || control.failed.load();
+    if (failed)
+    {
+        std::string message = control.failed.load() ? control.message : "terminated abnormally";
+        throw std::runtime_error("Partition Error: rank failed (" + message + ")");
+    }
+
+    faceNormals = sharedFaceNormals;
+    verticesNormals = sharedVerticesNormals;
+    // vertices referenced by no face are still zero, normalized to the same not a number as computeMeshNormals()
+    parallel::parallelFor(0, num_vertices, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; v++)
+        {
+            if (verticesNormals.row(v).isZero(0.0))
+            {
+                verticesNormals.row(v) /= verticesNormals.row(v).norm();
+            }
+        }
+    });
+}
+
+} // namespace distributed
+} // namespace bunny_mesh
@@ -0,0 +1,104 @@
+/**
+ * @file SharedMesh.cc
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Source file of SharedMesh.h header file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "bunny_mesh/SharedMesh.h"
+#include "bunny_mesh/Mesh.h"
+
+#include <stdexcept>
+
+namespace bunny_mesh
+{
+SharedMesh::SharedMesh(const bunny_dataIO::Point3DMatrixType &vertices, const bunny_dataIO::IndexMatrixType &faces)
+{
+    std::shared_ptr<GeometrySnapshot> geometry = std::make_shared<GeometrySnapshot>();
+    geometry->faces = std::make_shared<const bunny_dataIO::IndexMatrixType>(faces);
+    geometry->vertices = std::make_shared<const bunny_dataIO::Point3DMatrixType>(vertices);
+    geometry->orientation = bunny_dataIO::Point3DType(0, 0, 1);
+    geometry->version = 0;
+    current_geometry = geometry;
+}
+
+std::shared_ptr<const GeometrySnapshot> SharedMesh::geometry() const
+{
+    return std::atomic_load(&current_geometry);
+}
+
+std::shared_ptr<const NormalsSnapshot> SharedMesh::normals() const
+{
+    return std::atomic_load(&current_normals);
+}
+
+uint64_t SharedMesh::publish(std::shared_ptr<const bunny_dataIO::Point3DMatrixType> vertices,
+                             const bunny_dataIO::Point3DType &orientation)
+{
+    std::shared_ptr<const GeometrySnapshot> previous = std::atomic_load(&current_geometry);
+    std::shared_ptr<GeometrySnapshot> geometry = std::make_shared<GeometrySnapshot>();
+    geometry->faces = previous->faces;
+    geometry->vertices = vertices;
+    geometry->orientation = orientation.normalized();
+    geometry->version = previous->version + 1;
+    std::atomic_store(&current_geometry, std::shared_ptr<const GeometrySnapshot>(geometry));
+    return geometry->version;
+}
+
+uint64_t SharedMesh::setVertices(const bunny_dataIO::Point3DMatrixType &vertices)
+{
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    std::shared_ptr<const GeometrySnapshot> previous = std::atomic_load(&current_geometry);
+    if (vertices.rows() != previous->vertices->rows())
+    {
+        throw std::invalid_argument("Shared Mesh Error: number of vertices changed");
+    }
+    return publish(std::make_shared<const bunny_dataIO::Point3DMatrixType>(vertices), previous->orientation);
+}
+
+uint64_t SharedMesh::setOrientation(const bunny_dataIO::Point3DType &orientation)
+{
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    std::shared_ptr<const GeometrySnapshot> previous = std::atomic_load(&current_geometry);
+    return publish(previous->vertices, orientation);
+}
+
+/**
+ * @brief Compute the normals of the latest geometry and publish them.
+ *
+ * The computation reads the immutable geometry snapshot only, so it runs while readers keep using the previous
+ * normals. If the latest normals already match the latest geometry they are returned without recomputing.
+ */
+std::shared_ptr<const NormalsSnapshot> SharedMesh::recompute()
+{
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    std::shared_ptr<const GeometrySnapshot> geometry = std::atomic_load(&current_geometry);
+    std::shared_ptr<const NormalsSnapshot> latest = std::atomic_load(&current_normals);
+    if (latest && latest->geometry == geometry)
+    {
+        return latest;
+    }
+
+    std::shared_ptr<NormalsSnapshot> normals = std::make_shared<NormalsSnapshot>();
+    normals->geometry = geometry;
+    normals->face_normals.resize(geometry->faces->rows(), 3);
+    normals->vertices_normals.resize(geometry->vertices->rows(), 3);
+    if (geometry->orientation == bunny_dataIO::Point3DType(0, 0, 1))
+    {
+        computeMeshNormals(*geometry->vertices, *geometry->faces, normals->face_normals, normals->vertices_normals);
+    }
+    else
+    {
+        bunny_dataIO::Point3DMatrixType verticesWorld = *geometry->vertices * orientationRotation(geometry->orientation);
+        computeMeshNormals(verticesWorld, *geometry->faces, normals->face_normals, normals->vertices_normals);
+    }
+
+    std::shared_ptr<const NormalsSnapshot> published(normals);
+    std::atomic_store(&current_normals, published);
+    return published;
+}
+
+} // namespace bunny_mesh
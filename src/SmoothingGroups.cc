@@ -0,0 +1,169 @@
+/**
+ * @file SmoothingGroups.cc
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Source file of SmoothingGroups.h header file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "bunny_mesh/SmoothingGroups.h"
+#include "bunny_mesh/Topology.h"
+#include "bunny_mesh/parallel.h"
+
+#include <cmath>
+#include <math.h>
+
+namespace bunny_mesh
+{
+namespace
+{
+// union-find root with path halving
+inline int findRoot(std::vector<int> &parent, int i)
+{
+    while (parent[i] != i)
+    {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+// true if two faces incident to a vertex share one of their two other vertices, i.e. an edge through the vertex
+inline bool shareEdge(const bunny_dataIO::IndexMatrixType &faces, int cornerA, int cornerB)
+{
+    const int faceA = cornerA / 3, faceB = cornerB / 3;
+    const int a1 = faces(faceA, (cornerA + 1) % 3), a2 = faces(faceA, (cornerA + 2) % 3);
+    const int b1 = faces(faceB, (cornerB + 1) % 3), b2 = faces(faceB, (cornerB + 2) % 3);
+    return a1 == b1 || a1 == b2 || a2 == b1 || a2 == b2;
+}
+} // namespace
+
+/**
+ * @brief Compute the crease aware normals of a mesh, in world coordinates.
+ *
+ * The work is done in three parallel passes:
+ *      1. unnormalized and normalized face normals;
+ *      2. per vertex clustering of the incident faces, storing the local group of each corner and the number of groups;
+ *      3. after a prefix sum over the group counts, per vertex accumulation of the group normals.
+ * Vertices without incident faces keep a single split vertex with a zero normal.
+ */
+SmoothingGroups computeSmoothingGroups(TriangleMesh &mesh, double creaseAngle)
+{
+    const bunny_dataIO::IndexMatrixType faces = mesh.getFaces();
+    const bunny_dataIO::Point3DMatrixType vertices = mesh.getVertices();
+    const bunny_dataIO::Point3DMatrixType verticesWorld = mesh.getVerticesIntoWorld();
+    const size_t num_faces = faces.rows();
+    const size_t num_vertices = vertices.rows();
+    const double cosCrease = std::cos(creaseAngle);
+    // without creases every incident face is smoothed, even across non-manifold fans or degenerate faces
+    const bool smoothAll = creaseAngle >= M_PI;
+
+    // 1. face normals
+    bunny_dataIO::Point3DMatrixType crossProducts(num_faces, 3);
+    bunny_dataIO::Point3DMatrixType unitNormals(num_faces, 3);
+    parallel::parallelFor(0, num_faces, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            bunny_dataIO::Point3DType v0 = verticesWorld.row(faces(i, 0));
+            bunny_dataIO::Point3DType v1 = verticesWorld.row(faces(i, 1));
+            bunny_dataIO::Point3DType v2 = verticesWorld.row(faces(i, 2));
+            bunny_dataIO::Point3DType faceNormal = (v1 - v0).cross(v2 - v1);
+            crossProducts.row(i) = faceNormal;
+            unitNormals.row(i) = faceNormal.normalized();
+        }
+    });
+
+    // 2. clustering of the incident faces of each vertex
+    const VertexFaceAdjacency adjacency = buildVertexFaceAdjacency(faces, num_vertices);
+    std::vector<int> cornerGroup(3 * num_faces);
+    std::vector<int> groupOffsets(num_vertices + 1);
+    parallel::parallelFor(0, num_vertices, [&](size_t begin, size_t end) {
+        std::vector<int> parent, label;
+        for (size_t v = begin; v < end; v++)
+        {
+            const int first = adjacency.offsets[v];
+            const int valence = adjacency.offsets[v + 1] - first;
+            parent.resize(valence);
+            for (int i = 0; i < valence; i++)
+            {
+                parent[i] = i;
+            }
+            for (int i = 0; i < valence; i++)
+            {
+                const int cornerI = adjacency.corners[first + i];
+                for (int j = i + 1; j < valence; j++)
+                {
+                    const int cornerJ = adjacency.corners[first + j];
+                    if (smoothAll || (unitNormals.row(cornerI / 3).dot(unitNormals.row(cornerJ / 3)) >= cosCrease &&
+                                      shareEdge(faces, cornerI, cornerJ)))
+                    {
+                        parent[findRoot(parent, j)] = findRoot(parent, i);
+                    }
+                }
+            }
+            // groups are numbered in the order of their first face
+            label.assign(valence, -1);
+            int numGroups = 0;
+            for (int i = 0; i < valence; i++)
+            {
+                int root = findRoot(parent, i);
+                if (label[root] < 0)
+                {
+                    label[root] = numGroups++;
+                }
+                cornerGroup[adjacency.corners[first + i]] = label[root];
+            }
+            groupOffsets[v] = valence > 0 ? numGroups : 1;
+        }
+    });
+
+    // exclusive prefix sum of the group counts
+    int num_split = 0;
+    for (size_t v = 0; v < num_vertices; v++)
+    {
+        int count = groupOffsets[v];
+        groupOffsets[v] = num_split;
+        num_split += count;
+    }
+    groupOffsets[num_vertices] = num_split;
+
+    // 3. group normals
+    SmoothingGroups groups;
+    groups.corner_normals.resize(3 * num_faces, 3);
+    groups.split_faces.resize(num_faces, 3);
+    groups.split_vertices.resize(num_split, 3);
+    groups.split_normals = bunny_dataIO::Point3DMatrixType::Zero(num_split, 3);
+    groups.split_source.resize(num_split);
+    parallel::parallelFor(0, num_vertices, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; v++)
+        {
+            const int firstSplit = groupOffsets[v];
+            for (int s = firstSplit; s < groupOffsets[v + 1]; s++)
+            {
+                groups.split_vertices.row(s) = vertices.row(v);
+                groups.split_source[s] = static_cast<int>(v);
+            }
+            for (int i = adjacency.offsets[v]; i < adjacency.offsets[v + 1]; i++)
+            {
+                const int corner = adjacency.corners[i];
+                groups.split_normals.row(firstSplit + cornerGroup[corner]) += crossProducts.row(corner / 3);
+            }
+            for (int s = firstSplit; s < groupOffsets[v + 1]; s++)
+            {
+                groups.split_normals.row(s).normalize();
+            }
+            for (int i = adjacency.offsets[v]; i < adjacency.offsets[v + 1]; i++)
+            {
+                const int corner = adjacency.corners[i];
+                const int split = firstSplit + cornerGroup[corner];
+                groups.split_faces(corner / 3, corner % 3) = split;
+                groups.corner_normals.row(corner) = groups.split_normals.row(split);
+            }
+        }
+    });
+    return groups;
+}
+
+} // namespace bunny_mesh
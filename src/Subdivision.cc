@@ -0,0 +1,412 @@
+/**
+ * @file Subdivision.cc
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Source file of Subdivision.h header file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "bunny_mesh/Subdivision.h"
+#include "bunny_mesh/parallel.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace bunny_mesh
+{
+namespace
+{
+// Minimal number of rows per chunk of the parallel passes
+const size_t kMinRowsPerChunk = 4096;
+
+/**
+ * @brief Position of an edge in a face, the edge k joining its corners k and k + 1.
+ */
+inline int edgeSlot(const EdgeTable &edges, int face, int edge)
+{
+    return edges.face_edges(face, 0) == edge ? 0 : (edges.face_edges(face, 1) == edge ? 1 : 2);
+}
+
+/**
+ * @brief Whether a face has an edge.
+ */
+inline bool hasEdge(const EdgeTable &edges, int face, int edge)
+{
+    return edges.face_edges(face, 0) == edge || edges.face_edges(face, 1) == edge || edges.face_edges(face, 2) == edge;
+}
+
+/**
+ * @brief Position of a vertex in a face.
+ */
+inline int cornerSlot(const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces, int face, int vertex)
+{
+    return faces(face, 0) == vertex ? 0 : (faces(face, 1) == vertex ? 1 : 2);
+}
+
+/**
+ * @brief Loop weight of the neighbours of an interior vertex of the given valence.
+ */
+inline double loopBeta(int valence)
+{
+    const double c = 0.375 + 0.25 * std::cos(2.0 * M_PI / valence);
+    return (0.625 - c * c) / valence;
+}
+
+/**
+ * @brief Loop position of a parent vertex, from the edges around it.
+ */
+bunny_dataIO::Point3DType loopVertex(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &vertices,
+                                     const EdgeTable &edges, const VertexFaceAdjacency &adjacency, int vertex,
+                                     std::vector<int> &ring)
+{
+    // each face of the vertex holds two of its edges, interior edges are met twice
+    ring.clear();
+    for (int c = adjacency.offsets[vertex]; c < adjacency.offsets[vertex + 1]; c++)
+    {
+        const int face = adjacency.corners[c] / 3, k = adjacency.corners[c] % 3;
+        ring.push_back(edges.face_edges(face, k));
+        ring.push_back(edges.face_edges(face, (k + 2) % 3));
+    }
+    std::sort(ring.begin(), ring.end());
+    ring.erase(std::unique(ring.begin(), ring.end()), ring.end());
+
+    const bunny_dataIO::Point3DType position = vertices.row(vertex);
+    bunny_dataIO::Point3DType neighbours = bunny_dataIO::Point3DType::Zero();
+    bunny_dataIO::Point3DType creases = bunny_dataIO::Point3DType::Zero();
+    int numCreases = 0;
+    for (int edge : ring)
+    {
+        const int other = edges.ends(edge, 0) == vertex ? edges.ends(edge, 1) : edges.ends(edge, 0);
+        neighbours += vertices.row(other);
+        if (edges.valence(edge) != 2)
+        {
+            creases += vertices.row(other);
+            numCreases++;
+        }
+    }
+    const int valence = static_cast<int>(ring.size());
+    if (valence == 0 || (numCreases != 0 && numCreases != 2))
+    {
+        // isolated or corner vertex
+        return position;
+    }
+    if (numCreases == 2)
+    {
+        return 0.75 * position + 0.125 * creases;
+    }
+    const double beta = loopBeta(valence);
+    return (1.0 - valence * beta) * position + beta * neighbours;
+}
+
+/**
+ * @brief Loop position of the vertex of an edge, from its ends and the vertices facing it.
+ */
+bunny_dataIO::Point3DType loopEdgeVertex(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &vertices,
+                                         const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces,
+                                         const EdgeTable &edges, int edge)
+{
+    const bunny_dataIO::Point3DType ends = vertices.row(edges.ends(edge, 0)) + vertices.row(edges.ends(edge, 1));
+    if (edges.valence(edge) != 2)
+    {
+        return 0.5 * ends;
+    }
+    bunny_dataIO::Point3DType opposites = bunny_dataIO::Point3DType::Zero();
+    for (int i = edges.offsets[edge]; i < edges.offsets[edge + 1]; i++)
+    {
+        const int face = edges.faces[i];
+        opposites += vertices.row(faces(face, (edgeSlot(edges, face, edge) + 2) % 3));
+    }
+    return 0.375 * ends + 0.125 * opposites;
+}
+
+void checkTopology(const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces, const EdgeTable &edges)
+{
+    if (edges.face_edges.rows() != faces.rows() || edges.offsets.size() != edges.size() + 1)
+    {
+        throw std::invalid_argument("Subdivision Error: edge table does not match the faces");
+    }
+}
+} // namespace
+
+void subdivideVertices(SubdivisionScheme scheme, const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &vertices,
+                       const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces, const EdgeTable &edges,
+                       const VertexFaceAdjacency &adjacency, size_t begin, size_t end, double *out)
+{
+    const size_t num_vertices = vertices.rows();
+    std::vector<int> ring;
+    for (size_t v = begin; v < end; v++, out += 3)
+    {
+        bunny_dataIO::Point3DType position;
+        if (v < num_vertices)
+        {
+            position = scheme == SubdivisionScheme::Loop
+                           ? loopVertex(vertices, edges, adjacency, static_cast<int>(v), ring)
+                           : bunny_dataIO::Point3DType(vertices.row(v));
+        }
+        else
+        {
+            const int edge = static_cast<int>(v - num_vertices);
+            position = scheme == SubdivisionScheme::Loop
+                           ? loopEdgeVertex(vertices, faces, edges, edge)
+                           : bunny_dataIO::Point3DType(
+                                 0.5 * (vertices.row(edges.ends(edge, 0)) + vertices.row(edges.ends(edge, 1))));
+        }
+        out[0] = position(0);
+        out[1] = position(1);
+        out[2] = position(2);
+    }
+}
+
+void subdivideFaces(const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces, const EdgeTable &edges,
+                    size_t num_vertices, size_t begin, size_t end, int *out)
+{
+    const int first = static_cast<int>(num_vertices);
+    for (size_t t = begin; t < end; t++, out += 3)
+    {
+        const size_t f = t / 4;
+        const int a = faces(f, 0), b = faces(f, 1), c = faces(f, 2);
+        const int ab = first + edges.face_edges(f, 0), bc = first + edges.face_edges(f, 1),
+                  ca = first + edges.face_edges(f, 2);
+        switch (t % 4)
+        {
+        case 0:
+            out[0] = a, out[1] = ab, out[2] = ca;
+            break;
+        case 1:
+            out[0] = ab, out[1] = b, out[2] = bc;
+            break;
+        case 2:
+            out[0] = ca, out[1] = bc, out[2] = c;
+            break;
+        default:
+            out[0] = ab, out[1] = bc, out[2] = ca;
+            break;
+        }
+    }
+}
+
+EdgeTable subdivideEdgeTable(const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces, const EdgeTable &edges,
+                             size_t num_vertices)
+{
+    checkTopology(faces, edges);
+    const size_t num_faces = faces.rows();
+    const size_t num_edges = edges.size();
+    const size_t parentSides = edges.offsets[num_edges];
+    if (num_vertices + num_edges > static_cast<size_t>(INT_MAX) || 12 * num_faces > static_cast<size_t>(INT_MAX))
+    {
+        throw std::invalid_argument("Subdivision Error: subdivided mesh exceeds the index range");
+    }
+    const int first = static_cast<int>(num_vertices);
+    const int interior = static_cast<int>(2 * num_edges);
+
+    // the center edge k of a face joins the vertices of its edges k and k + 1, and is shared by every face over the
+    // same three vertices: the first of them owns it, the others point to its slot
+    std::vector<int> owner(3 * num_faces);
+    std::vector<int> centerOffsets(3 * num_faces + 1), centerSides(3 * num_faces + 1);
+    centerOffsets[0] = centerSides[0] = 0;
+    parallel::parallelFor(0, num_faces, [&](size_t begin, size_t end) {
+        for (size_t f = begin; f < end; f++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                const int e0 = edges.face_edges(f, k), e1 = edges.face_edges(f, (k + 1) % 3);
+                int twins = 0, firstTwin = -1;
+                for (int i = edges.offsets[e0]; i < edges.offsets[e0 + 1]; i++)
+                {
+                    if (hasEdge(edges, edges.faces[i], e1))
+                    {
+                        firstTwin = twins++ == 0 ? edges.faces[i] : firstTwin;
+                    }
+                }
+                const size_t slot = 3 * f + k;
+                owner[slot] = 3 * firstTwin + (cornerSlot(faces, firstTwin, faces(f, (k + 1) % 3)) + 2) % 3;
+                const bool owned = owner[slot] == static_cast<int>(slot);
+                centerOffsets[slot + 1] = owned ? 1 : 0;
+                centerSides[slot + 1] = owned ? 2 * twins : 0;
+            }
+        }
+    }, kMinRowsPerChunk);
+    std::partial_sum(centerOffsets.begin(), centerOffsets.end(), centerOffsets.begin());
+    std::partial_sum(centerSides.begin(), centerSides.end(), centerSides.begin());
+
+    EdgeTable table;
+    table.ends.resize(2 * num_edges + centerOffsets.back(), 2);
+    table.offsets.resize(table.ends.rows() + 1);
+    table.faces.resize(2 * parentSides + centerSides.back());
+
+    // halves of the parent edges, with the corner faces of their end in each parent face
+    parallel::parallelFor(0, num_edges, [&](size_t begin, size_t end) {
+        for (size_t e = begin; e < end; e++)
+        {
+            const int middle = first + static_cast<int>(e);
+            const int offset = edges.offsets[e], valence = edges.offsets[e + 1] - offset;
+            for (int side = 0; side < 2; side++)
+            {
+                const size_t half = 2 * e + side;
+                const int end_vertex = edges.ends(e, side);
+                table.ends(half, 0) = end_vertex;
+                table.ends(half, 1) = middle;
+                table.offsets[half] = 2 * offset + side * valence;
+                for (int i = 0; i < valence; i++)
+                {
+                    const int face = edges.faces[offset + i];
+                    table.faces[2 * offset + side * valence + i] = 4 * face + cornerSlot(faces, face, end_vertex);
+                }
+            }
+        }
+    }, kMinRowsPerChunk);
+
+    // edges of the center faces, and the edges of the subdivided faces
+    table.face_edges.resize(4 * num_faces, 3);
+    parallel::parallelFor(0, num_faces, [&](size_t begin, size_t end) {
+        for (size_t f = begin; f < end; f++)
+        {
+            int halves[3][2], centers[3];
+            for (int k = 0; k < 3; k++)
+            {
+                const int e = edges.face_edges(f, k), next = edges.face_edges(f, (k + 1) % 3);
+                const size_t slot = 3 * f + k;
+                centers[k] = interior + centerOffsets[owner[slot]];
+                if (owner[slot] == static_cast<int>(slot))
+                {
+                    const int m0 = first + e, m1 = first + next;
+                    table.ends(centers[k], 0) = std::min(m0, m1);
+                    table.ends(centers[k], 1) = std::max(m0, m1);
+                    int side = static_cast<int>(2 * parentSides) + centerSides[slot];
+                    table.offsets[centers[k]] = side;
+                    // in each twin face, the corner face of the corner shared by both edges, then the center face
+                    for (int i = edges.offsets[e]; i < edges.offsets[e + 1]; i++)
+                    {
+                        const int twin = edges.faces[i];
+                        if (hasEdge(edges, twin, next))
+                        {
+                            table.faces[side++] = 4 * twin + cornerSlot(faces, twin, faces(f, (k + 1) % 3));
+                            table.faces[side++] = 4 * twin + 3;
+                        }
+                    }
+                }
+
+                // halves of the edge k from its corner k and from its corner k + 1
+                const bool lowFirst = edges.ends(e, 0) == faces(f, k);
+                halves[k][0] = 2 * e + (lowFirst ? 0 : 1);
+                halves[k][1] = 2 * e + (lowFirst ? 1 : 0);
+            }
+            table.face_edges.row(4 * f) << halves[0][0], centers[2], halves[2][1];
+            table.face_edges.row(4 * f + 1) << halves[0][1], halves[1][0], centers[0];
+            table.face_edges.row(4 * f + 2) << centers[1], halves[1][1], halves[2][0];
+            table.face_edges.row(4 * f + 3) << centers[0], centers[1], centers[2];
+        }
+    }, kMinRowsPerChunk);
+    table.offsets.back() = static_cast<int>(table.faces.size());
+    return table;
+}
+
+VertexFaceAdjacency subdivideVertexFaceAdjacency(const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces,
+                                                 const EdgeTable &edges, const VertexFaceAdjacency &adjacency)
+{
+    checkTopology(faces, edges);
+    const size_t num_vertices = adjacency.offsets.size() - 1;
+    const size_t num_edges = edges.size();
+    const int parentCorners = adjacency.offsets[num_vertices];
+    if (static_cast<size_t>(parentCorners) != 3 * static_cast<size_t>(faces.rows()))
+    {
+        throw std::invalid_argument("Subdivision Error: vertex face adjacency does not match the faces");
+    }
+
+    VertexFaceAdjacency subdivided;
+    subdivided.offsets.resize(num_vertices + num_edges + 1);
+    subdivided.corners.resize(4 * static_cast<size_t>(parentCorners));
+
+    // a parent vertex keeps one face per parent face: the corner face of its corner, at the same position
+    parallel::parallelFor(0, num_vertices, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; v++)
+        {
+            subdivided.offsets[v] = adjacency.offsets[v];
+            for (int c = adjacency.offsets[v]; c < adjacency.offsets[v + 1]; c++)
+            {
+                const int face = adjacency.corners[c] / 3, k = adjacency.corners[c] % 3;
+                subdivided.corners[c] = 3 * (4 * face + k) + k;
+            }
+        }
+    }, kMinRowsPerChunk);
+
+    // the vertex of an edge k of a parent face is in the corner faces of its corners k and k + 1, at positions
+    // k + 1 and k, and in the center face at position k
+    parallel::parallelFor(0, num_edges, [&](size_t begin, size_t end) {
+        for (size_t e = begin; e < end; e++)
+        {
+            int corner = parentCorners + 3 * edges.offsets[e];
+            subdivided.offsets[num_vertices + e] = corner;
+            for (int i = edges.offsets[e]; i < edges.offsets[e + 1]; i++)
+            {
+                const int face = edges.faces[i];
+                const int k = edgeSlot(edges, face, static_cast<int>(e));
+                const int next = (k + 1) % 3;
+                const int lower = std::min(k, next), upper = std::max(k, next);
+                subdivided.corners[corner++] = 3 * (4 * face + lower) + (lower == k ? next : k);
+                subdivided.corners[corner++] = 3 * (4 * face + upper) + (upper == k ? next : k);
+                subdivided.corners[corner++] = 3 * (4 * face + 3) + k;
+            }
+        }
+    }, kMinRowsPerChunk);
+    subdivided.offsets.back() = static_cast<int>(subdivided.corners.size());
+    return subdivided;
+}
+
+void propagateMidpointNormals(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &vertices,
+                              const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces, const EdgeTable &edges,
+                              const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &faceNormals,
+                              const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &verticesNormals,
+                              Eigen::Ref<bunny_dataIO::Point3DMatrixType> subdividedFaceNormals,
+                              Eigen::Ref<bunny_dataIO::Point3DMatrixType> subdividedVerticesNormals)
+{
+    checkTopology(faces, edges);
+    const size_t num_faces = faces.rows();
+    const size_t num_vertices = vertices.rows();
+    const size_t num_edges = edges.size();
+    if (faceNormals.rows() != faces.rows() || verticesNormals.rows() != vertices.rows() ||
+        static_cast<size_t>(subdividedFaceNormals.rows()) != 4 * num_faces ||
+        static_cast<size_t>(subdividedVerticesNormals.rows()) != num_vertices + num_edges)
+    {
+        throw std::invalid_argument("Subdivision Error: normals buffers do not match the mesh size");
+    }
+
+    // subdivided faces keep the normal of their parent, whose twice area weights it around its edges
+    Eigen::VectorXd doubleAreas(num_faces);
+    parallel::parallelFor(0, num_faces, [&](size_t begin, size_t end) {
+        for (size_t f = begin; f < end; f++)
+        {
+            const bunny_dataIO::Point3DType v0 = vertices.row(faces(f, 0)), v1 = vertices.row(faces(f, 1)),
+                                            v2 = vertices.row(faces(f, 2));
+            doubleAreas(f) = (v1 - v0).cross(v2 - v1).norm();
+            for (size_t child = 4 * f; child < 4 * f + 4; child++)
+            {
+                subdividedFaceNormals.row(child) = faceNormals.row(f);
+            }
+        }
+    }, kMinRowsPerChunk);
+
+    parallel::parallelFor(0, num_vertices, [&](size_t begin, size_t end) {
+        subdividedVerticesNormals.middleRows(begin, end - begin) = verticesNormals.middleRows(begin, end - begin);
+    }, kMinRowsPerChunk);
+
+    parallel::parallelFor(0, num_edges, [&](size_t begin, size_t end) {
+        for (size_t e = begin; e < end; e++)
+        {
+            bunny_dataIO::Point3DType normal = bunny_dataIO::Point3DType::Zero();
+            for (int i = edges.offsets[e]; i < edges.offsets[e + 1]; i++)
+            {
+                normal += doubleAreas(edges.faces[i]) * faceNormals.row(edges.faces[i]);
+            }
+            subdividedVerticesNormals.row(num_vertices + e) = normal / normal.norm();
+        }
+    }, kMinRowsPerChunk);
+}
+
+} // namespace bunny_mesh
@@ -0,0 +1,267 @@
+/**
+ * @file Topology.cc
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Source file of Topology.h header file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "bunny_mesh/Topology.h"
+#include "bunny_mesh/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+namespace bunny_mesh
+{
+namespace
+{
+// Minimal number of faces per chunk of the parallel passes over the faces
+const size_t kMinFacesPerChunk = 16384;
+
+// Hash table slot not holding an edge yet
+const uint64_t kEmptySlot = ~static_cast<uint64_t>(0);
+
+/**
+ * @brief Key of an undirected edge: its lowest vertex in the high 32 bits, the other one in the low ones.
+ */
+inline uint64_t edgeKey(int a, int b)
+{
+    return static_cast<uint64_t>(std::min(a, b)) << 32 | static_cast<uint32_t>(std::max(a, b));
+}
+
+/**
+ * @brief Hash of an edge key, the murmur3 64 bits finalizer.
+ */
+inline uint64_t hashEdgeKey(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ull;
+    key ^= key >> 33;
+    return key;
+}
+} // namespace
+
+VertexFaceAdjacency buildVertexFaceAdjacency(const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces,
+                                             size_t num_vertices)
+{
+    const size_t num_faces = faces.rows();
+    const size_t numChunks = parallel::chunkCount(num_faces, 16384);
+
+    // per chunk histogram of the face corners
+    std::vector<std::vector<int>> counts(numChunks);
+    parallel::parallelForChunks(0, num_faces, numChunks, [&](size_t begin, size_t end, size_t chunk) {
+        std::vector<int> &count = counts[chunk];
+        count.assign(num_vertices, 0);
+        for (size_t i = begin; i < end; i++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                int vertex = faces(i, k);
+                if (vertex < 0 || static_cast<size_t>(vertex) >= num_vertices)
+                {
+                    throw std::out_of_range("Topology Error: face index out of vertices range");
+                }
+                count[vertex]++;
+            }
+        }
+    });
+    if (num_faces == 0)
+    {
+        counts.front().assign(num_vertices, 0);
+    }
+
+    // vertex offsets, and the chunk offsets inside each vertex replace the chunk counts
+    VertexFaceAdjacency adjacency;
+    adjacency.offsets.resize(num_vertices + 1);
+    int offset = 0;
+    for (size_t v = 0; v < num_vertices; v++)
+    {
+        adjacency.offsets[v] = offset;
+        for (size_t chunk = 0; chunk < numChunks; chunk++)
+        {
+            int count = counts[chunk][v];
+            counts[chunk][v] = offset;
+            offset += count;
+        }
+    }
+    adjacency.offsets[num_vertices] = offset;
+
+    adjacency.corners.resize(offset);
+    parallel::parallelForChunks(0, num_faces, numChunks, [&](size_t begin, size_t end, size_t chunk) {
+        std::vector<int> &cursor = counts[chunk];
+        for (size_t i = begin; i < end; i++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                adjacency.corners[cursor[faces(i, k)]++] = static_cast<int>(3 * i + k);
+            }
+        }
+    });
+    return adjacency;
+}
+
+EdgeTable buildEdgeTable(const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces, size_t num_vertices)
+{
+    const size_t num_faces = faces.rows();
+    const size_t num_corners = 3 * num_faces;
+    if (num_corners > static_cast<size_t>(INT_MAX))
+    {
+        throw std::invalid_argument("Topology Error: too many faces for an edge table");
+    }
+
+    // a mesh has at most 1.5 edges per face, so the table stays less than half full
+    size_t capacity = 16;
+    while (capacity < num_corners)
+    {
+        capacity *= 2;
+    }
+    const size_t mask = capacity - 1;
+    std::unique_ptr<std::atomic<uint64_t>[]> keys(new std::atomic<uint64_t>[capacity]);
+    std::unique_ptr<std::atomic<int>[]> firstCorners(new std::atomic<int>[capacity]);
+    parallel::parallelFor(0, capacity, [&](size_t begin, size_t end) {
+        for (size_t slot = begin; slot < end; slot++)
+        {
+            keys[slot].store(kEmptySlot, std::memory_order_relaxed);
+            firstCorners[slot].store(INT_MAX, std::memory_order_relaxed);
+        }
+    }, 1 << 16);
+
+    // insert the edge of every face corner, and keep the first corner of each edge
+    std::vector<uint32_t> cornerSlots(num_corners);
+    const size_t numChunks = parallel::chunkCount(num_faces, kMinFacesPerChunk);
+    parallel::parallelForChunks(0, num_faces, numChunks, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; i++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                const int a = faces(i, k), b = faces(i, (k + 1) % 3);
+                if (a < 0 || b < 0 || static_cast<size_t>(a) >= num_vertices || static_cast<size_t>(b) >= num_vertices)
+                {
+                    throw std::out_of_range("Topology Error: face index out of vertices range");
+                }
+                if (a == b)
+                {
+                    throw std::invalid_argument("Topology Error: face with a repeated vertex");
+                }
+                const uint64_t key = edgeKey(a, b);
+                size_t slot = hashEdgeKey(key) & mask;
+                while (true)
+                {
+                    uint64_t current = keys[slot].load(std::memory_order_relaxed);
+                    if (current == kEmptySlot &&
+                        keys[slot].compare_exchange_strong(current, key, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                    // current holds the key of the slot, whether it was already taken or just taken by another thread
+                    if (current == key)
+                    {
+                        break;
+                    }
+                    slot = (slot + 1) & mask;
+                }
+                const int corner = static_cast<int>(3 * i + k);
+                int first = firstCorners[slot].load(std::memory_order_relaxed);
+                while (corner < first &&
+                       !firstCorners[slot].compare_exchange_weak(first, corner, std::memory_order_relaxed))
+                {
+                }
+                cornerSlots[corner] = static_cast<uint32_t>(slot);
+            }
+        }
+    });
+
+    // number the edges in the order of their first corner: count them per chunk, then write their ends, the
+    // hash table slots then holding their edge index
+    std::vector<int> chunkEdges(numChunks + 1, 0);
+    parallel::parallelForChunks(0, num_faces, numChunks, [&](size_t begin, size_t end, size_t chunk) {
+        int count = 0;
+        for (size_t corner = 3 * begin; corner < 3 * end; corner++)
+        {
+            count += firstCorners[cornerSlots[corner]].load(std::memory_order_relaxed) == static_cast<int>(corner);
+        }
+        chunkEdges[chunk + 1] = count;
+    });
+    for (size_t chunk = 0; chunk < numChunks; chunk++)
+    {
+        chunkEdges[chunk + 1] += chunkEdges[chunk];
+    }
+
+    EdgeTable table;
+    const size_t num_edges = chunkEdges[numChunks];
+    table.ends.resize(num_edges, 2);
+    parallel::parallelForChunks(0, num_faces, numChunks, [&](size_t begin, size_t end, size_t chunk) {
+        int edge = chunkEdges[chunk];
+        for (size_t corner = 3 * begin; corner < 3 * end; corner++)
+        {
+            const uint32_t slot = cornerSlots[corner];
+            if (firstCorners[slot].load(std::memory_order_relaxed) == static_cast<int>(corner))
+            {
+                const int a = faces(corner / 3, corner % 3), b = faces(corner / 3, (corner + 1) % 3);
+                table.ends(edge, 0) = std::min(a, b);
+                table.ends(edge, 1) = std::max(a, b);
+                keys[slot].store(edge++, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    // faces of each edge: counted, placed, then sorted as threads place them in any order
+    table.face_edges.resize(num_faces, 3);
+    parallel::parallelFor(0, num_edges, [&](size_t begin, size_t end) {
+        for (size_t edge = begin; edge < end; edge++)
+        {
+            firstCorners[edge].store(0, std::memory_order_relaxed);
+        }
+    }, 1 << 16);
+    parallel::parallelFor(0, num_faces, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                const int edge = static_cast<int>(keys[cornerSlots[3 * i + k]].load(std::memory_order_relaxed));
+                table.face_edges(i, k) = edge;
+                firstCorners[edge].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }, kMinFacesPerChunk);
+
+    table.offsets.resize(num_edges + 1);
+    int offset = 0;
+    for (size_t edge = 0; edge < num_edges; edge++)
+    {
+        table.offsets[edge] = offset;
+        offset += firstCorners[edge].load(std::memory_order_relaxed);
+        firstCorners[edge].store(table.offsets[edge], std::memory_order_relaxed);
+    }
+    table.offsets[num_edges] = offset;
+
+    table.faces.resize(offset);
+    parallel::parallelFor(0, num_faces, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                table.faces[firstCorners[table.face_edges(i, k)].fetch_add(1, std::memory_order_relaxed)] =
+                    static_cast<int>(i);
+            }
+        }
+    }, kMinFacesPerChunk);
+    parallel::parallelFor(0, num_edges, [&](size_t begin, size_t end) {
+        for (size_t edge = begin; edge < end; edge++)
+        {
+            std::sort(table.faces.begin() + table.offsets[edge], table.faces.begin() + table.offsets[edge + 1]);
+        }
+    });
+    return table;
+}
+
+} // namespace bunny_mesh
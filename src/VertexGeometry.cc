@@ -0,0 +1,193 @@
+/**
+ * @file VertexGeometry.cc
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Source file of VertexGeometry.h header file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "bunny_mesh/VertexGeometry.h"
+#include "bunny_mesh/parallel.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace bunny_mesh
+{
+namespace
+{
+// Minimal number of faces per chunk: each chunk but the first costs a private accumulators buffer
+const size_t kMinFacesPerChunk = 16384;
+
+// Per vertex accumulators, one cache line per vertex: normal sum (3), cotangent Laplacian (3), angle sum, area
+using AccumulatorMatrixType = Eigen::Matrix<double, Eigen::Dynamic, 8, Eigen::RowMajor>;
+const int kNormal = 0;
+const int kLaplacian = 3;
+const int kAngle = 6;
+const int kArea = 7;
+
+/**
+ * @brief Accumulate the faces [begin, end) of a chunk.
+ */
+void accumulateFaces(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &verticesWorld,
+                     const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces, size_t begin, size_t end,
+                     bunny_dataIO::Point3DMatrixType &face_normals, AccumulatorMatrixType &accumulators)
+{
+    for (size_t i = begin; i < end; i++)
+    {
+        const int idx[3] = {faces(i, 0), faces(i, 1), faces(i, 2)};
+        const bunny_dataIO::Point3DType p[3] = {verticesWorld.row(idx[0]), verticesWorld.row(idx[1]),
+                                                verticesWorld.row(idx[2])};
+
+        // unnormalized face normal, same expression as computeMeshNormals()
+        const bunny_dataIO::Point3DType faceNormal = (p[1] - p[0]).cross(p[2] - p[1]);
+        // twice the face area, the length of the cross product of any two edges
+        const double crossNorm = faceNormal.norm();
+
+        // corner k: dot product of its two edges, cotangent and angle
+        double dots[3], cotangents[3];
+        for (int k = 0; k < 3; k++)
+        {
+            dots[k] = (p[(k + 1) % 3] - p[k]).dot(p[(k + 2) % 3] - p[k]);
+            cotangents[k] = crossNorm > 0.0 ? dots[k] / crossNorm : 0.0;
+        }
+        const bool obtuse = dots[0] < 0.0 || dots[1] < 0.0 || dots[2] < 0.0;
+        const double area = 0.5 * crossNorm;
+
+        for (int k = 0; k < 3; k++)
+        {
+            const int next = (k + 1) % 3, previous = (k + 2) % 3;
+            const bunny_dataIO::Point3DType toNext = p[next] - p[k];
+            const bunny_dataIO::Point3DType toPrevious = p[previous] - p[k];
+            auto accumulator = accumulators.row(idx[k]);
+
+            accumulator.segment<3>(kNormal) += faceNormal;
+            // each edge of the vertex is weighted by the cotangent of its opposite corner
+            accumulator.segment<3>(kLaplacian) += cotangents[previous] * toNext + cotangents[next] * toPrevious;
+            accumulator(kAngle) += std::atan2(crossNorm, dots[k]);
+
+            // mixed Voronoi area: Voronoi region for non obtuse faces, else a fixed share of the face
+            if (!obtuse)
+            {
+                accumulator(kArea) += 0.125 * (toNext.squaredNorm() * cotangents[previous] +
+                                               toPrevious.squaredNorm() * cotangents[next]);
+            }
+            else
+            {
+                accumulator(kArea) += dots[k] < 0.0 ? 0.5 * area : 0.25 * area;
+            }
+        }
+
+        face_normals.row(i) = faceNormal.normalized();
+    }
+}
+
+/**
+ * @brief Continuous orthonormal basis around a unit vector (Duff et al.), (tangent, bitangent, normal) right handed.
+ */
+inline void orthonormalBasis(const bunny_dataIO::Point3DType &normal, bunny_dataIO::Point3DType &tangent,
+                             bunny_dataIO::Point3DType &bitangent)
+{
+    const double sign = std::copysign(1.0, normal(2));
+    const double a = -1.0 / (sign + normal(2));
+    const double b = normal(0) * normal(1) * a;
+    tangent << 1.0 + sign * normal(0) * normal(0) * a, sign * b, -sign * normal(0);
+    bitangent << b, sign + normal(1) * normal(1) * a, -normal(1);
+}
+
+template <typename Matrix>
+inline void resizeRows(Matrix &matrix, Eigen::Index rows)
+{
+    if (matrix.rows() != rows)
+    {
+        matrix.resize(rows, matrix.cols());
+    }
+}
+
+inline void resizeVector(Eigen::VectorXd &vector, Eigen::Index size)
+{
+    if (vector.size() != size)
+    {
+        vector.resize(size);
+    }
+}
+} // namespace
+
+/**
+ * @brief Compute normals, tangent frames and curvatures of raw mesh arrays in a single traversal of the faces.
+ *
+ * The first chunk accumulates in the shared accumulators, the others in private ones summed during the
+ * parallel finalization of the vertices.
+ */
+void computeVertexGeometry(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &verticesWorld,
+                           const Eigen::Ref<const bunny_dataIO::IndexMatrixType> &faces, VertexGeometry &geometry)
+{
+    const size_t num_faces = faces.rows();
+    const size_t num_vertices = verticesWorld.rows();
+    if (faces.size() > 0 && (faces.minCoeff() < 0 || static_cast<size_t>(faces.maxCoeff()) >= num_vertices))
+    {
+        throw std::out_of_range("Vertex Geometry Error: face index out of vertices range");
+    }
+    resizeRows(geometry.face_normals, faces.rows());
+    resizeRows(geometry.vertices_normals, verticesWorld.rows());
+    resizeRows(geometry.tangents, verticesWorld.rows());
+    resizeRows(geometry.bitangents, verticesWorld.rows());
+    resizeVector(geometry.vertex_areas, verticesWorld.rows());
+    resizeVector(geometry.mean_curvature, verticesWorld.rows());
+    resizeVector(geometry.gaussian_curvature, verticesWorld.rows());
+
+    const size_t numChunks = parallel::chunkCount(num_faces, kMinFacesPerChunk);
+    std::vector<AccumulatorMatrixType> accumulators(numChunks);
+    parallel::parallelForChunks(0, num_faces, numChunks, [&](size_t begin, size_t end, size_t chunk) {
+        accumulators[chunk].setZero(num_vertices, 8);
+        accumulateFaces(verticesWorld, faces, begin, end, geometry.face_normals, accumulators[chunk]);
+    });
+    if (num_faces == 0)
+    {
+        accumulators.front().setZero(num_vertices, 8);
+    }
+
+    parallel::parallelFor(0, num_vertices, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; v++)
+        {
+            Eigen::Matrix<double, 1, 8> sum = accumulators[0].row(v);
+            for (size_t chunk = 1; chunk < numChunks; chunk++)
+            {
+                sum += accumulators[chunk].row(v);
+            }
+            // a vertex without faces is left as not a number, as rowwise().normalize() does
+            const bunny_dataIO::Point3DType normal = sum.segment<3>(kNormal) / sum.segment<3>(kNormal).norm();
+            const double area = sum(kArea);
+            geometry.vertices_normals.row(v) = normal;
+            geometry.vertex_areas(v) = area;
+            if (area > 0.0)
+            {
+                geometry.mean_curvature(v) = -sum.segment<3>(kLaplacian).dot(normal) / (4.0 * area);
+                geometry.gaussian_curvature(v) = (2.0 * M_PI - sum(kAngle)) / area;
+            }
+            else
+            {
+                geometry.mean_curvature(v) = std::numeric_limits<double>::quiet_NaN();
+                geometry.gaussian_curvature(v) = std::numeric_limits<double>::quiet_NaN();
+            }
+
+            bunny_dataIO::Point3DType tangent, bitangent;
+            orthonormalBasis(normal, tangent, bitangent);
+            geometry.tangents.row(v) = tangent;
+            geometry.bitangents.row(v) = bitangent;
+        }
+    });
+}
+
+VertexGeometry computeVertexGeometry(const TriangleMesh &mesh)
+{
+    VertexGeometry geometry;
+    computeVertexGeometry(mesh.getVerticesIntoWorld(), mesh.getFaces(), geometry);
+    return geometry;
+}
+
+} // namespace bunny_mesh
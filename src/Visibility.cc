@@ -0,0 +1,133 @@
+/**
+ * @file Visibility.cc
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Source file of Visibility.h header file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "bunny_mesh/Visibility.h"
+#include "bunny_mesh/parallel.h"
+
+#include <algorithm>
+#include <bitset>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace bunny_mesh
+{
+namespace
+{
+// Faces of a block: one 64 bytes line of each mask, and transposed normals (12 KB) that stay in the L1 cache
+const size_t kBlockFaces = 512;
+
+// Minimal number of faces per chunk
+const size_t kMinFacesPerChunk = 16384;
+
+/**
+ * @brief Front facing bits of up to 64 faces for one view direction, from transposed normals aligned on 16 bytes.
+ */
+inline uint64_t frontFacingWord(const double *x, const double *y, const double *z, size_t count,
+                                const bunny_dataIO::Point3DType &direction)
+{
+    uint64_t word = 0;
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128d dx = _mm_set1_pd(direction(0));
+    const __m128d dy = _mm_set1_pd(direction(1));
+    const __m128d dz = _mm_set1_pd(direction(2));
+    const __m128d zero = _mm_setzero_pd();
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128d xy = _mm_add_pd(_mm_mul_pd(_mm_load_pd(x + i), dx), _mm_mul_pd(_mm_load_pd(y + i), dy));
+        const __m128d dot = _mm_add_pd(xy, _mm_mul_pd(_mm_load_pd(z + i), dz));
+        // a comparison rather than the sign bit, so that -0 and not a number are back facing
+        word |= static_cast<uint64_t>(_mm_movemask_pd(_mm_cmplt_pd(dot, zero))) << i;
+    }
+#endif
+    for (; i < count; i++)
+    {
+        const double dot = x[i] * direction(0) + y[i] * direction(1) + z[i] * direction(2);
+        word |= static_cast<uint64_t>(dot < 0.0) << i;
+    }
+    return word;
+}
+} // namespace
+
+size_t VisibilityMasks::count(size_t view) const
+{
+    size_t front = 0;
+    for (size_t w = 0; w < words_per_view; w++)
+    {
+        front += std::bitset<64>(this->view(view)[w]).count();
+    }
+    return front;
+}
+
+/**
+ * @brief Classify the faces of a mesh as front or back facing for each of a batch of view directions.
+ *
+ * Blocks start on a word boundary, so that threads never share a word of the masks.
+ */
+void classifyFrontFaces(const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &faceNormals,
+                        const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &viewDirections,
+                        VisibilityMasks &masks)
+{
+    const size_t num_faces = faceNormals.rows();
+    const size_t num_views = viewDirections.rows();
+    masks.num_faces = num_faces;
+    masks.num_views = num_views;
+    masks.words_per_view = (num_faces + 63) / 64;
+    // every word is written below, the tail bits of the last one as zeros
+    masks.words.resize(num_views * masks.words_per_view);
+
+    const size_t numBlocks = (num_faces + kBlockFaces - 1) / kBlockFaces;
+    parallel::parallelFor(0, numBlocks, [&](size_t beginBlock, size_t endBlock) {
+        alignas(16) double x[kBlockFaces];
+        alignas(16) double y[kBlockFaces];
+        alignas(16) double z[kBlockFaces];
+        for (size_t block = beginBlock; block < endBlock; block++)
+        {
+            const size_t first = block * kBlockFaces;
+            const size_t count = std::min(kBlockFaces, num_faces - first);
+            for (size_t i = 0; i < count; i++)
+            {
+                x[i] = faceNormals(first + i, 0);
+                y[i] = faceNormals(first + i, 1);
+                z[i] = faceNormals(first + i, 2);
+            }
+            const size_t firstWord = first / 64;
+            const size_t numWords = (count + 63) / 64;
+            for (size_t view = 0; view < num_views; view++)
+            {
+                const bunny_dataIO::Point3DType direction = viewDirections.row(view);
+                uint64_t *words = masks.words.data() + view * masks.words_per_view + firstWord;
+                for (size_t w = 0; w < numWords; w++)
+                {
+                    words[w] = frontFacingWord(x + 64 * w, y + 64 * w, z + 64 * w,
+                                               std::min<size_t>(64, count - 64 * w), direction);
+                }
+            }
+        }
+    }, kMinFacesPerChunk / kBlockFaces);
+}
+
+VisibilityMasks classifyFrontFaces(const TriangleMesh &mesh,
+                                   const Eigen::Ref<const bunny_dataIO::Point3DMatrixType> &viewDirections)
+{
+    // stale or never computed normals would silently classify every face as back facing
+    if (!mesh.hasValidNormals())
+    {
+        throw std::invalid_argument("Visibility Error: the mesh normals are not computed for its current state");
+    }
+    VisibilityMasks masks;
+    classifyFrontFaces(mesh.faceNormals(), viewDirections, masks);
+    return masks;
+}
+
+} // namespace bunny_mesh
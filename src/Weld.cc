@@ -0,0 +1,318 @@
+/**
+ * @file Weld.cc
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Source file of Weld.h header file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "bunny_mesh/Weld.h"
+#include "bunny_mesh/parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace bunny_mesh
+{
+namespace
+{
+// Number of shards of the spatial hash, as a power of two
+const int kShardBits = 8;
+const size_t kNumShards = size_t(1) << kShardBits;
+// Size of the hash cells relatively to the tolerance
+const double kCellScale = 4.0;
+// Bound of the cell coordinates, so that neighbour cells do not overflow
+const double kMaxCell = 4611686018427387904.0; // 2^62
+
+// Integer coordinates of a hash cell
+struct CellKey
+{
+    int64_t x, y, z;
+
+    inline bool operator==(const CellKey &other) const { return x == other.x && y == other.y && z == other.z; }
+};
+
+// splitmix64 finalizer
+inline uint64_t mix(uint64_t h)
+{
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    return h;
+}
+
+inline uint64_t hashCell(const CellKey &key)
+{
+    return mix(static_cast<uint64_t>(key.x) ^ mix(static_cast<uint64_t>(key.y) ^ mix(static_cast<uint64_t>(key.z))));
+}
+
+// the shard uses the high bits of the hash, the shard table its low bits
+inline size_t shardOf(uint64_t hash) { return static_cast<size_t>(hash >> (64 - kShardBits)); }
+
+/**
+ * @brief Cell of a point. Exact mode uses the coordinates bit patterns, so only identical points share a cell.
+ */
+inline CellKey cellOf(const bunny_dataIO::Point3DMatrixType &vertices, size_t i, double invCell, bool exact)
+{
+    int64_t c[3];
+    for (int k = 0; k < 3; k++)
+    {
+        double value = vertices(i, k);
+        if (exact)
+        {
+            // -0.0 and 0.0 are the same position
+            value = value == 0.0 ? 0.0 : value;
+            std::memcpy(&c[k], &value, sizeof(value));
+        }
+        else
+        {
+            if (!std::isfinite(value))
+            {
+                throw std::invalid_argument("Weld Error: vertex coordinates must be finite to weld with a tolerance");
+            }
+            // far points share the border cells, their distance is still checked
+            c[k] = static_cast<int64_t>(std::max(-kMaxCell, std::min(kMaxCell, std::floor(value * invCell))));
+        }
+    }
+    return CellKey{c[0], c[1], c[2]};
+}
+
+/**
+ * @brief Open addressing table of one shard, from a cell to the chain of its vertices.
+ *
+ * Vertices of a cell are chained through a next array shared by every shard, in increasing index order.
+ */
+struct ShardTable
+{
+    std::vector<CellKey> keys;
+    std::vector<int> heads;
+    std::vector<int> tails;
+    size_t mask = 0;
+
+    // returns the first vertex of the cell, or -1 if the cell is empty
+    inline int find(const CellKey &key, uint64_t hash) const
+    {
+        if (keys.empty())
+        {
+            return -1;
+        }
+        for (size_t slot = hash & mask;; slot = (slot + 1) & mask)
+        {
+            if (heads[slot] < 0 || keys[slot] == key)
+            {
+                return heads[slot];
+            }
+        }
+    }
+};
+} // namespace
+
+/**
+ * @brief Merge vertices closer than a tolerance.
+ *
+ * Passes, all parallel except the cluster resolution which is a single linear scan:
+ *      1. cell and hash of each vertex;
+ *      2. counting sort of the vertices by shard, keeping their index order;
+ *      3. each shard inserts its vertices, in index order, in its table;
+ *      4. each vertex finds the smallest index vertex within the tolerance in its neighbour cells;
+ *      5. clusters are resolved in index order and compacted;
+ *      6. welded vertices are gathered and faces rewritten.
+ */
+WeldResult weldVertices(const bunny_dataIO::Point3DMatrixType &vertices, const bunny_dataIO::IndexMatrixType &faces,
+                        double tolerance)
+{
+    if (!(tolerance >= 0.0) || !std::isfinite(tolerance))
+    {
+        throw std::invalid_argument("Weld Error: tolerance must be positive");
+    }
+    const size_t num_vertices = vertices.rows();
+    const bool exact = tolerance == 0.0;
+    const double cellSize = kCellScale * tolerance;
+    const double invCell = exact ? 0.0 : 1.0 / cellSize;
+    if (!std::isfinite(invCell))
+    {
+        throw std::invalid_argument("Weld Error: tolerance too small");
+    }
+    const double tolerance2 = tolerance * tolerance;
+
+    // 1. cells and hashes
+    std::vector<CellKey> cells(num_vertices);
+    std::vector<uint64_t> hashes(num_vertices);
+    parallel::parallelFor(0, num_vertices, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            cells[i] = cellOf(vertices, i, invCell, exact);
+            hashes[i] = hashCell(cells[i]);
+        }
+    });
+
+    // 2. counting sort by shard
+    const size_t numChunks = parallel::chunkCount(num_vertices, 65536);
+    std::vector<std::vector<int>> counts(numChunks, std::vector<int>(kNumShards, 0));
+    parallel::parallelForChunks(0, num_vertices, numChunks, [&](size_t begin, size_t end, size_t chunk) {
+        for (size_t i = begin; i < end; i++)
+        {
+            counts[chunk][shardOf(hashes[i])]++;
+        }
+    });
+    std::vector<int> shardOffsets(kNumShards + 1);
+    int offset = 0;
+    for (size_t shard = 0; shard < kNumShards; shard++)
+    {
+        shardOffsets[shard] = offset;
+        for (size_t chunk = 0; chunk < numChunks; chunk++)
+        {
+            int count = counts[chunk][shard];
+            counts[chunk][shard] = offset;
+            offset += count;
+        }
+    }
+    shardOffsets[kNumShards] = offset;
+    std::vector<int> shardVertices(num_vertices);
+    parallel::parallelForChunks(0, num_vertices, numChunks, [&](size_t begin, size_t end, size_t chunk) {
+        for (size_t i = begin; i < end; i++)
+        {
+            shardVertices[counts[chunk][shardOf(hashes[i])]++] = static_cast<int>(i);
+        }
+    });
+
+    // 3. shard tables, each shard is owned by a single thread
+    std::vector<ShardTable> tables(kNumShards);
+    std::vector<int> next(num_vertices, -1);
+    parallel::parallelFor(0, kNumShards, [&](size_t shardBegin, size_t shardEnd) {
+        for (size_t shard = shardBegin; shard < shardEnd; shard++)
+        {
+            const int first = shardOffsets[shard];
+            const int last = shardOffsets[shard + 1];
+            if (first == last)
+            {
+                continue;
+            }
+            ShardTable &table = tables[shard];
+            size_t capacity = 2;
+            while (capacity < 2 * static_cast<size_t>(last - first))
+            {
+                capacity <<= 1;
+            }
+            table.mask = capacity - 1;
+            table.keys.resize(capacity);
+            table.heads.assign(capacity, -1);
+            table.tails.assign(capacity, -1);
+            for (int i = first; i < last; i++)
+            {
+                const int vertex = shardVertices[i];
+                size_t slot = hashes[vertex] & table.mask;
+                while (table.heads[slot] >= 0 && !(table.keys[slot] == cells[vertex]))
+                {
+                    slot = (slot + 1) & table.mask;
+                }
+                if (table.heads[slot] < 0)
+                {
+                    table.keys[slot] = cells[vertex];
+                    table.heads[slot] = vertex;
+                }
+                else
+                {
+                    next[table.tails[slot]] = vertex;
+                }
+                table.tails[slot] = vertex;
+            }
+        }
+    }, 1);
+
+    // 4. smallest index vertex within the tolerance, the vertex itself at worst.
+    // Cells are larger than the tolerance, so a neighbour cell is only visited when the vertex is close to its side.
+    std::vector<int> representative(num_vertices);
+    parallel::parallelFor(0, num_vertices, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            int lo[3] = {0, 0, 0}, hi[3] = {0, 0, 0};
+            if (!exact)
+            {
+                const int64_t c[3] = {cells[i].x, cells[i].y, cells[i].z};
+                for (int k = 0; k < 3; k++)
+                {
+                    // slack for the rounding of the cell computation
+                    const double value = vertices(i, k);
+                    const double reach = tolerance + 4.0 * std::numeric_limits<double>::epsilon() * (std::abs(value) + cellSize);
+                    lo[k] = value - reach < c[k] * cellSize ? -1 : 0;
+                    hi[k] = value + reach >= (c[k] + 1) * cellSize ? 1 : 0;
+                }
+            }
+            int best = static_cast<int>(i);
+            for (int dx = lo[0]; dx <= hi[0]; dx++)
+            {
+                for (int dy = lo[1]; dy <= hi[1]; dy++)
+                {
+                    for (int dz = lo[2]; dz <= hi[2]; dz++)
+                    {
+                        CellKey key{cells[i].x + dx, cells[i].y + dy, cells[i].z + dz};
+                        uint64_t hash = hashCell(key);
+                        // chains are sorted by index
+                        for (int j = tables[shardOf(hash)].find(key, hash); j >= 0 && j < best; j = next[j])
+                        {
+                            if (exact || (vertices.row(j) - vertices.row(i)).squaredNorm() <= tolerance2)
+                            {
+                                best = j;
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+            representative[i] = best;
+        }
+    });
+
+    // 5. clusters resolution: representatives always have a smaller index, so they are resolved first
+    WeldResult result;
+    result.remap.resize(num_vertices);
+    std::vector<int> firstOccurrence;
+    for (size_t i = 0; i < num_vertices; i++)
+    {
+        if (representative[i] == static_cast<int>(i))
+        {
+            result.remap[i] = static_cast<int>(firstOccurrence.size());
+            firstOccurrence.push_back(static_cast<int>(i));
+        }
+        else
+        {
+            result.remap[i] = result.remap[representative[i]];
+        }
+    }
+
+    // 6. output
+    result.vertices.resize(firstOccurrence.size(), 3);
+    parallel::parallelFor(0, firstOccurrence.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            result.vertices.row(i) = vertices.row(firstOccurrence[i]);
+        }
+    });
+    result.faces.resize(faces.rows(), 3);
+    parallel::parallelFor(0, faces.rows(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                int vertex = faces(i, k);
+                if (vertex < 0 || static_cast<size_t>(vertex) >= num_vertices)
+                {
+                    throw std::out_of_range("Weld Error: face index out of vertices range");
+                }
+                result.faces(i, k) = result.remap[vertex];
+            }
+        }
+    });
+    return result;
+}
+
+} // namespace bunny_mesh
@@ -0,0 +1,1584 @@
+/**
+ * @file mesh_io.cc
+ * @author Pedro Henrique S. Perrusi (pedro.perrusi@gmail.com)
+ * @brief Source file of mesh_io.h header file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "bunny_mesh/mesh_io.h"
+#include "bunny_mesh/Weld.h"
+#include "bunny_mesh/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bunny_dataIO
+{
+namespace
+{
+// Size of the buffers binary records are encoded into before being written
+const size_t kWriteBatchBytes = 1 << 20;
+// Minimal number of bytes of an OBJ chunk parsed by one thread
+const size_t kMinParseChunk = 1 << 20;
+// Size of a binary STL header and record
+const size_t kSTLHeaderSize = 84;
+const size_t kSTLRecordSize = 50;
+
+inline std::runtime_error systemError(const std::string &what)
+{
+    return std::runtime_error("Mesh IO Error: " + what + ": " + std::strerror(errno));
+}
+
+inline bool hostIsLittleEndian()
+{
+    const uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+inline std::string extensionOf(const std::string &filename)
+{
+    size_t dot = filename.find_last_of('.');
+    std::string extension = dot == std::string::npos ? "" : filename.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+    return extension;
+}
+
+/**
+ * @brief Read only memory mapping of a whole file.
+ */
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string &filename) : data(nullptr), size(0)
+    {
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw systemError("cannot open '" + filename + "'");
+        }
+        struct stat status;
+        if (fstat(fd, &status) < 0)
+        {
+            close(fd);
+            throw systemError("cannot stat '" + filename + "'");
+        }
+        size = static_cast<size_t>(status.st_size);
+        if (size > 0)
+        {
+            void *address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address == MAP_FAILED)
+            {
+                close(fd);
+                throw systemError("cannot map '" + filename + "'");
+            }
+            madvise(address, size, MADV_WILLNEED);
+            data = static_cast<const char *>(address);
+        }
+        close(fd);
+    }
+
+    ~MappedFile()
+    {
+        if (data)
+        {
+            munmap(const_cast<char *>(data), size);
+        }
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const char *data;
+    size_t size;
+};
+
+/**
+ * @brief Write size bytes at offset, retrying short and interrupted writes.
+ */
+void writeAllAt(int fd, const char *data, size_t size, uint64_t offset)
+{
+    while (size > 0)
+    {
+        ssize_t written = pwrite(fd, data, size, static_cast<off_t>(offset));
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw systemError("cannot write");
+        }
+        data += written;
+        size -= written;
+        offset += written;
+    }
+}
+
+/**
+ * @brief Read size bytes at offset, retrying short and interrupted reads.
+ */
+void readAllAt(int fd, char *data, size_t size, uint64_t offset)
+{
+    while (size > 0)
+    {
+        ssize_t read = pread(fd, data, size, static_cast<off_t>(offset));
+        if (read < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw systemError("cannot read");
+        }
+        if (read == 0)
+        {
+            throw std::invalid_argument("Mesh IO Error: truncated numpy file");
+        }
+        data += read;
+        size -= read;
+        offset += read;
+    }
+}
+
+inline size_t numpyScalarSize(NumpyType type) { return type == NumpyType::Float64 ? 8 : 4; }
+
+/**
+ * @brief Numpy type code of a scalar type, without its byte order.
+ */
+inline const char *numpyTypeCode(NumpyType type)
+{
+    return type == NumpyType::Float64 ? "f8" : (type == NumpyType::Int32 ? "i4" : "f4");
+}
+
+/**
+ * @brief Value of a key of the numpy header dictionary, up to the next comma outside of parentheses.
+ */
+std::string numpyHeaderValue(const std::string &header, const std::string &key)
+{
+    size_t begin = header.find("'" + key + "'");
+    if (begin == std::string::npos || (begin = header.find(':', begin)) == std::string::npos)
+    {
+        throw std::invalid_argument("Mesh IO Error: numpy header has no '" + key + "'");
+    }
+    size_t end = ++begin;
+    for (int depth = 0; end < header.size() && (depth > 0 || (header[end] != ',' && header[end] != '}')); end++)
+    {
+        depth += header[end] == '(' ? 1 : (header[end] == ')' ? -1 : 0);
+    }
+    std::string value = header.substr(begin, end - begin);
+    value.erase(0, value.find_first_not_of(" '\""));
+    value.erase(value.find_last_not_of(" '\"") + 1);
+    return value;
+}
+
+/**
+ * @brief Output file written at explicit offsets, so that several threads write their own part of it.
+ */
+class OutputFile
+{
+public:
+    explicit OutputFile(const std::string &filename)
+    {
+        fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+        {
+            throw systemError("cannot create '" + filename + "'");
+        }
+    }
+
+    ~OutputFile() { close(fd); }
+
+    OutputFile(const OutputFile &) = delete;
+    OutputFile &operator=(const OutputFile &) = delete;
+
+    void writeAt(const char *data, size_t size, uint64_t offset) const { writeAllAt(fd, data, size, offset); }
+
+private:
+    int fd;
+};
+
+/**
+ * @brief Encode count fixed size records in parallel and write them from offset.
+ *
+ * @tparam Encode : callable as encode(size_t record, char *destination), writing recordSize bytes.
+ */
+template <typename Encode>
+void writeRecords(const OutputFile &file, uint64_t offset, size_t count, size_t recordSize, Encode encode)
+{
+    const size_t batch = std::max<size_t>(1, kWriteBatchBytes / recordSize);
+    bunny_mesh::parallel::parallelFor(0, count, [&](size_t begin, size_t end) {
+        std::vector<char> buffer(std::min(batch, end - begin) * recordSize);
+        for (size_t first = begin; first < end; first += batch)
+        {
+            size_t last = std::min(end, first + batch);
+            for (size_t i = first; i < last; i++)
+            {
+                encode(i, buffer.data() + (i - first) * recordSize);
+            }
+            file.writeAt(buffer.data(), (last - first) * recordSize, offset + first * recordSize);
+        }
+    }, 4096);
+}
+
+inline void checkFaces(const IndexMatrixType &faces, size_t num_vertices)
+{
+    std::atomic<bool> valid(true);
+    bunny_mesh::parallel::parallelFor(0, faces.rows(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                if (faces(i, k) < 0 || static_cast<size_t>(faces(i, k)) >= num_vertices)
+                {
+                    valid = false;
+                }
+            }
+        }
+    });
+    if (!valid)
+    {
+        throw std::out_of_range("Mesh IO Error: face index out of vertices range");
+    }
+}
+
+inline void checkNormals(const Point3DMatrixType &normals, Eigen::Index rows)
+{
+    if (normals.rows() != 0 && normals.rows() != rows)
+    {
+        throw std::invalid_argument("Mesh IO Error: normals do not match the mesh size");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------------------------
+// PLY
+// ------------------------------------------------------------------------------------------------------------------
+
+enum class PlyType
+{
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Float32,
+    Float64
+};
+
+inline PlyType plyType(const std::string &name)
+{
+    if (name == "char" || name == "int8")
+        return PlyType::Int8;
+    if (name == "uchar" || name == "uint8")
+        return PlyType::UInt8;
+    if (name == "short" || name == "int16")
+        return PlyType::Int16;
+    if (name == "ushort" || name == "uint16")
+        return PlyType::UInt16;
+    if (name == "int" || name == "int32")
+        return PlyType::Int32;
+    if (name == "uint" || name == "uint32")
+        return PlyType::UInt32;
+    if (name == "float" || name == "float32")
+        return PlyType::Float32;
+    if (name == "double" || name == "float64")
+        return PlyType::Float64;
+    throw std::invalid_argument("Mesh IO Error: unknown PLY property type '" + name + "'");
+}
+
+inline size_t plyTypeSize(PlyType type)
+{
+    switch (type)
+    {
+    case PlyType::Int8:
+    case PlyType::UInt8:
+        return 1;
+    case PlyType::Int16:
+    case PlyType::UInt16:
+        return 2;
+    case PlyType::Int32:
+    case PlyType::UInt32:
+    case PlyType::Float32:
+        return 4;
+    default:
+        return 8;
+    }
+}
+
+template <typename T>
+inline T loadValue(const char *source, bool swap)
+{
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, source, sizeof(T));
+    if (swap)
+    {
+        std::reverse(bytes, bytes + sizeof(T));
+    }
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+template <typename Result>
+inline Result loadPly(const char *source, PlyType type, bool swap)
+{
+    switch (type)
+    {
+    case PlyType::Int8:
+        return static_cast<Result>(loadValue<int8_t>(source, swap));
+    case PlyType::UInt8:
+        return static_cast<Result>(loadValue<uint8_t>(source, swap));
+    case PlyType::Int16:
+        return static_cast<Result>(loadValue<int16_t>(source, swap));
+    case PlyType::UInt16:
+        return static_cast<Result>(loadValue<uint16_t>(source, swap));
+    case PlyType::Int32:
+        return static_cast<Result>(loadValue<int32_t>(source, swap));
+    case PlyType::UInt32:
+        return static_cast<Result>(loadValue<uint32_t>(source, swap));
+    case PlyType::Float32:
+        return static_cast<Result>(loadValue<float>(source, swap));
+    default:
+        return static_cast<Result>(loadValue<double>(source, swap));
+    }
+}
+
+struct PlyProperty
+{
+    std::string name;
+    PlyType type;
+    bool isList;
+    PlyType countType;
+};
+
+struct PlyElement
+{
+    std::string name;
+    size_t count;
+    std::vector<PlyProperty> properties;
+
+    bool hasList() const
+    {
+        return std::any_of(properties.begin(), properties.end(), [](const PlyProperty &p) { return p.isList; });
+    }
+
+    // size of a record, only meaningful without list properties
+    size_t stride() const
+    {
+        size_t size = 0;
+        for (const PlyProperty &property : properties)
+        {
+            size += plyTypeSize(property.type);
+        }
+        return size;
+    }
+};
+
+/**
+ * @brief Parse the PLY header, returns the offset of the binary body.
+ */
+size_t parsePlyHeader(const MappedFile &file, std::vector<PlyElement> &elements, bool &swap)
+{
+    const char *end = static_cast<const char *>(memmem(file.data, file.size, "end_header", 10));
+    if (file.size < 4 || std::strncmp(file.data, "ply", 3) != 0 || !end)
+    {
+        throw std::invalid_argument("Mesh IO Error: not a PLY file");
+    }
+    const char *body = static_cast<const char *>(std::memchr(end, '\n', file.data + file.size - end));
+    if (!body)
+    {
+        throw std::invalid_argument("Mesh IO Error: truncated PLY header");
+    }
+    std::istringstream header(std::string(file.data, end));
+    std::string line;
+    bool formatFound = false;
+    while (std::getline(header, line))
+    {
+        std::istringstream words(line);
+        std::string keyword;
+        words >> keyword;
+        if (keyword == "format")
+        {
+            std::string format;
+            words >> format;
+            if (format == "binary_little_endian")
+            {
+                swap = !hostIsLittleEndian();
+            }
+            else if (format == "binary_big_endian")
+            {
+                swap = hostIsLittleEndian();
+            }
+            else
+            {
+                throw std::invalid_argument("Mesh IO Error: only binary PLY files are supported");
+            }
+            formatFound = true;
+        }
+        else if (keyword == "element")
+        {
+            PlyElement element;
+            words >> element.name >> element.count;
+            elements.push_back(element);
+        }
+        else if (keyword == "property")
+        {
+            if (elements.empty())
+            {
+                throw std::invalid_argument("Mesh IO Error: PLY property outside of an element");
+            }
+            PlyProperty property;
+            std::string type;
+            words >> type;
+            property.isList = type == "list";
+            if (property.isList)
+            {
+                std::string countType;
+                words >> countType >> type;
+                property.countType = plyType(countType);
+            }
+            property.type = plyType(type);
+            words >> property.name;
+            elements.back().properties.push_back(property);
+        }
+    }
+    if (!formatFound)
+    {
+        throw std::invalid_argument("Mesh IO Error: PLY format is missing");
+    }
+    return body + 1 - file.data;
+}
+
+// offset in a record of a scalar property, or -1
+inline long propertyOffset(const PlyElement &element, const std::string &name, PlyType &type)
+{
+    size_t offset = 0;
+    for (const PlyProperty &property : element.properties)
+    {
+        if (property.name == name && !property.isList)
+        {
+            type = property.type;
+            return static_cast<long>(offset);
+        }
+        offset += plyTypeSize(property.type);
+    }
+    return -1;
+}
+
+void readPlyVertices(const char *body, const PlyElement &element, bool swap, MeshData &mesh)
+{
+    static const char *names[6] = {"x", "y", "z", "nx", "ny", "nz"};
+    long offsets[6];
+    PlyType types[6];
+    for (int k = 0; k < 6; k++)
+    {
+        offsets[k] = propertyOffset(element, names[k], types[k]);
+    }
+    if (offsets[0] < 0 || offsets[1] < 0 || offsets[2] < 0)
+    {
+        throw std::invalid_argument("Mesh IO Error: PLY vertices have no x, y, z properties");
+    }
+    const bool hasNormals = offsets[3] >= 0 && offsets[4] >= 0 && offsets[5] >= 0;
+    const size_t stride = element.stride();
+    mesh.vertices.resize(element.count, 3);
+    if (hasNormals)
+    {
+        mesh.vertices_normals.resize(element.count, 3);
+    }
+    bunny_mesh::parallel::parallelFor(0, element.count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            const char *record = body + i * stride;
+            for (int k = 0; k < 3; k++)
+            {
+                mesh.vertices(i, k) = loadPly<double>(record + offsets[k], types[k], swap);
+            }
+            if (hasNormals)
+            {
+                for (int k = 0; k < 3; k++)
+                {
+                    mesh.vertices_normals(i, k) = loadPly<double>(record + offsets[3 + k], types[3 + k], swap);
+                }
+            }
+        }
+    });
+}
+
+inline bool isIndexList(const PlyProperty &property)
+{
+    return property.isList && (property.name == "vertex_indices" || property.name == "vertex_index");
+}
+
+/**
+ * @brief Decode faces whose records all have the same size, which is the case when they are all triangles.
+ *
+ * @param elementEnd : end of the element records, set when faces are decoded.
+ * @return bool : false if a face is not a triangle or the file is too short, nothing is decoded then.
+ */
+bool readPlyTriangles(const char *body, const char *fileEnd, const PlyElement &element, bool swap, MeshData &mesh,
+                      const char *&elementEnd)
+{
+    size_t listOffset = 0, stride = 0;
+    const PlyProperty *list = nullptr;
+    for (const PlyProperty &property : element.properties)
+    {
+        if (property.isList)
+        {
+            if (list || !isIndexList(property))
+            {
+                return false;
+            }
+            list = &property;
+            listOffset = stride;
+            stride += plyTypeSize(property.countType) + 3 * plyTypeSize(property.type);
+        }
+        else
+        {
+            stride += plyTypeSize(property.type);
+        }
+    }
+    if (!list || static_cast<size_t>(fileEnd - body) / stride < element.count)
+    {
+        return false;
+    }
+    const size_t countSize = plyTypeSize(list->countType);
+    const size_t indexSize = plyTypeSize(list->type);
+    std::atomic<bool> triangles(true);
+    bunny_mesh::parallel::parallelFor(0, element.count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end && triangles; i++)
+        {
+            if (loadPly<long>(body + i * stride + listOffset, list->countType, swap) != 3)
+            {
+                triangles = false;
+            }
+        }
+    });
+    if (!triangles)
+    {
+        return false;
+    }
+    mesh.faces.resize(element.count, 3);
+    bunny_mesh::parallel::parallelFor(0, element.count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            const char *indexes = body + i * stride + listOffset + countSize;
+            for (int k = 0; k < 3; k++)
+            {
+                mesh.faces(i, k) = loadPly<int>(indexes + k * indexSize, list->type, swap);
+            }
+        }
+    });
+    elementEnd = body + element.count * stride;
+    return true;
+}
+
+/**
+ * @brief Walk the records of an element with list properties, returns the end of the element.
+ *
+ * Polygons of the vertex indexes list, if any, are split in triangle fans into triangles.
+ */
+const char *walkPlyElement(const char *body, const char *fileEnd, const PlyElement &element, bool swap,
+                           std::vector<int> *triangles)
+{
+    const char *p = body;
+    std::vector<int> polygon;
+    for (size_t i = 0; i < element.count; i++)
+    {
+        for (const PlyProperty &property : element.properties)
+        {
+            size_t size = plyTypeSize(property.isList ? property.countType : property.type);
+            if (p + size > fileEnd)
+            {
+                throw std::invalid_argument("Mesh IO Error: truncated PLY file");
+            }
+            if (!property.isList)
+            {
+                p += size;
+                continue;
+            }
+            long count = loadPly<long>(p, property.countType, swap);
+            p += size;
+            size_t itemSize = plyTypeSize(property.type);
+            if (count < 0 || static_cast<size_t>(fileEnd - p) / itemSize < static_cast<size_t>(count))
+            {
+                throw std::invalid_argument("Mesh IO Error: truncated PLY file");
+            }
+            if (triangles && isIndexList(property))
+            {
+                polygon.resize(count);
+                for (long k = 0; k < count; k++)
+                {
+                    polygon[k] = loadPly<int>(p + k * itemSize, property.type, swap);
+                }
+                for (long k = 2; k < count; k++)
+                {
+                    triangles->push_back(polygon[0]);
+                    triangles->push_back(polygon[k - 1]);
+                    triangles->push_back(polygon[k]);
+                }
+            }
+            p += count * itemSize;
+        }
+    }
+    return p;
+}
+
+// ------------------------------------------------------------------------------------------------------------------
+// OBJ
+// ------------------------------------------------------------------------------------------------------------------
+
+inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+// a statement ends at its line end or at a trailing comment
+inline bool isStatementEnd(const char *p, const char *end) { return p == end || *p == '\n' || *p == '#'; }
+
+inline const char *skipBlanks(const char *p, const char *end)
+{
+    while (p < end && isBlank(*p))
+    {
+        p++;
+    }
+    return p;
+}
+
+inline const char *nextLine(const char *p, const char *end)
+{
+    const char *newline = static_cast<const char *>(std::memchr(p, '\n', end - p));
+    return newline ? newline + 1 : end;
+}
+
+inline std::invalid_argument objError(const std::string &what)
+{
+    return std::invalid_argument("Mesh IO Error: invalid OBJ " + what);
+}
+
+/**
+ * @brief Parse a floating point number.
+ *
+ * Numbers with at most 19 significant digits, a mantissa exactly representable by a double and a small decimal
+ * exponent are converted by a single multiplication or division, which is correctly rounded since both operands
+ * are exact. Other numbers (long mantissas, large exponents, nan, inf) fall back to strtod().
+ */
+const char *parseDouble(const char *p, const char *end, double &value)
+{
+    static const double powers[23] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    const char *start = p;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+        negative = *p == '-';
+        p++;
+    }
+    uint64_t mantissa = 0;
+    int digits = 0, exponent = 0;
+    bool anyDigit = false;
+    for (; p < end && *p >= '0' && *p <= '9'; p++)
+    {
+        anyDigit = true;
+        if (mantissa != 0 || *p != '0')
+        {
+            mantissa = mantissa * 10 + (*p - '0');
+            digits++;
+        }
+        if (digits > 19)
+        {
+            break;
+        }
+    }
+    if (p < end && *p == '.' && digits <= 19)
+    {
+        for (p++; p < end && *p >= '0' && *p <= '9'; p++)
+        {
+            anyDigit = true;
+            if (mantissa != 0 || *p != '0')
+            {
+                mantissa = mantissa * 10 + (*p - '0');
+                digits++;
+            }
+            exponent--;
+            if (digits > 19)
+            {
+                break;
+            }
+        }
+    }
+    bool fast = anyDigit && digits <= 19;
+    if (fast && p < end && (*p == 'e' || *p == 'E'))
+    {
+        p++;
+        bool negativeExponent = false;
+        if (p < end && (*p == '-' || *p == '+'))
+        {
+            negativeExponent = *p == '-';
+            p++;
+        }
+        int explicitExponent = 0;
+        bool exponentDigit = false;
+        for (; p < end && *p >= '0' && *p <= '9'; p++)
+        {
+            exponentDigit = true;
+            explicitExponent = std::min(explicitExponent * 10 + (*p - '0'), 100000);
+        }
+        fast = exponentDigit;
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+    fast = fast && (isStatementEnd(p, end) || isBlank(*p));
+    if (fast && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22)
+    {
+        double result = static_cast<double>(mantissa);
+        result = exponent < 0 ? result / powers[-exponent] : result * powers[exponent];
+        value = negative ? -result : result;
+        return p;
+    }
+
+    // fallback on the null terminated copy of the token
+    char token[128];
+    size_t length = 0;
+    for (p = start; !isStatementEnd(p, end) && !isBlank(*p) && length + 1 < sizeof(token); p++)
+    {
+        token[length++] = *p;
+    }
+    token[length] = '\0';
+    char *parsedEnd = nullptr;
+    value = std::strtod(token, &parsedEnd);
+    if (parsedEnd != token + length || length == 0)
+    {
+        throw objError("number '" + std::string(token) + "'");
+    }
+    return p;
+}
+
+/**
+ * @brief Parse a signed index of a face corner.
+ */
+inline const char *parseIndexNumber(const char *p, const char *end, long &index)
+{
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+        negative = *p == '-';
+        p++;
+    }
+    if (p == end || *p < '0' || *p > '9')
+    {
+        throw objError("face index");
+    }
+    index = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; p++)
+    {
+        index = std::min(index * 10 + (*p - '0'), long(1) << 40);
+    }
+    index = negative ? -index : index;
+    return p;
+}
+
+/**
+ * @brief Parse the vertex and normal indexes of a face corner, v, v/vt, v//vn or v/vt/vn, skipping its texture
+ * index. The normal index is 0 when absent.
+ */
+inline const char *parseIndex(const char *p, const char *end, long &index, long &normalIndex)
+{
+    p = parseIndexNumber(p, end, index);
+    normalIndex = 0;
+    if (p < end && *p == '/')
+    {
+        p++;
+        while (!isStatementEnd(p, end) && !isBlank(*p) && *p != '/')
+        {
+            p++;
+        }
+        if (end - p >= 2 && *p == '/' && (std::isdigit(static_cast<unsigned char>(p[1])) || p[1] == '-' || p[1] == '+'))
+        {
+            p = parseIndexNumber(p + 1, end, normalIndex);
+        }
+    }
+    while (!isStatementEnd(p, end) && !isBlank(*p))
+    {
+        p++;
+    }
+    return p;
+}
+
+enum class ObjStatement
+{
+    Vertex,
+    Normal,
+    Face,
+    Other
+};
+
+inline ObjStatement objStatement(const char *&p, const char *end)
+{
+    p = skipBlanks(p, end);
+    if (end - p >= 2 && p[0] == 'v' && isBlank(p[1]))
+    {
+        p += 2;
+        return ObjStatement::Vertex;
+    }
+    if (end - p >= 3 && p[0] == 'v' && p[1] == 'n' && isBlank(p[2]))
+    {
+        p += 3;
+        return ObjStatement::Normal;
+    }
+    if (end - p >= 2 && p[0] == 'f' && isBlank(p[1]))
+    {
+        p += 2;
+        return ObjStatement::Face;
+    }
+    return ObjStatement::Other;
+}
+
+// statements counts of a chunk of lines, then their offsets in the outputs
+struct ObjCounts
+{
+    size_t vertices = 0;
+    size_t normals = 0;
+    size_t triangles = 0;
+};
+
+inline void appendDouble(std::string &out, double value)
+{
+    // shortest of 15, 16 or 17 significant digits reading back the same double
+    char buffer[32];
+    for (int precision = 15; precision <= 17; precision++)
+    {
+        std::snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+        if (precision == 17 || std::strtod(buffer, nullptr) == value)
+        {
+            break;
+        }
+    }
+    out += buffer;
+}
+
+inline void appendTriple(std::string &out, const char *keyword, const Point3DMatrixType &matrix, size_t row)
+{
+    out += keyword;
+    for (int k = 0; k < 3; k++)
+    {
+        out += ' ';
+        appendDouble(out, matrix(row, k));
+    }
+    out += '\n';
+}
+
+/**
+ * @brief Format rows in parallel, then append the chunks in order to the file.
+ *
+ * @tparam Format : callable as format(std::string &out, size_t row).
+ */
+template <typename Format>
+void writeLines(std::FILE *file, size_t rows, Format format)
+{
+    const size_t batch = 1 << 16;
+    for (size_t first = 0; first < rows; first += batch * bunny_mesh::parallel::numThreads())
+    {
+        size_t last = std::min(rows, first + batch * bunny_mesh::parallel::numThreads());
+        size_t numChunks = bunny_mesh::parallel::chunkCount(last - first, 4096);
+        std::vector<std::string> chunks(numChunks);
+        bunny_mesh::parallel::parallelForChunks(first, last, numChunks, [&](size_t begin, size_t end, size_t chunk) {
+            chunks[chunk].reserve((end - begin) * 64);
+            for (size_t i = begin; i < end; i++)
+            {
+                format(chunks[chunk], i);
+            }
+        });
+        for (const std::string &chunk : chunks)
+        {
+            if (std::fwrite(chunk.data(), 1, chunk.size(), file) != chunk.size())
+            {
+                throw systemError("cannot write");
+            }
+        }
+    }
+}
+} // namespace
+
+// ----------------------------------------------------------------------------------------------------------------------
+
+MeshData readPLY(const std::string &filename)
+{
+    MappedFile file(filename);
+    std::vector<PlyElement> elements;
+    bool swap = false;
+    const char *body = file.data + parsePlyHeader(file, elements, swap);
+    const char *fileEnd = file.data + file.size;
+
+    MeshData mesh;
+    bool facesFound = false;
+    for (const PlyElement &element : elements)
+    {
+        if (!element.hasList())
+        {
+            size_t stride = element.stride();
+            if (stride > 0 && static_cast<size_t>(fileEnd - body) / stride < element.count)
+            {
+                throw std::invalid_argument("Mesh IO Error: truncated PLY file");
+            }
+            if (element.name == "vertex")
+            {
+                readPlyVertices(body, element, swap, mesh);
+            }
+            body += stride * element.count;
+        }
+        else if (element.name == "face" && readPlyTriangles(body, fileEnd, element, swap, mesh, body))
+        {
+            facesFound = true;
+        }
+        else if (element.name == "face")
+        {
+            std::vector<int> triangles;
+            body = walkPlyElement(body, fileEnd, element, swap, &triangles);
+            mesh.faces = Eigen::Map<IndexMatrixType>(triangles.data(), triangles.size() / 3, 3);
+            facesFound = true;
+        }
+        else
+        {
+            body = walkPlyElement(body, fileEnd, element, swap, nullptr);
+        }
+    }
+    if (!facesFound)
+    {
+        throw std::invalid_argument("Mesh IO Error: PLY file has no faces");
+    }
+    checkFaces(mesh.faces, mesh.vertices.rows());
+    return mesh;
+}
+
+MeshData readSTL(const std::string &filename, bool weld)
+{
+    MappedFile file(filename);
+    if (file.size < kSTLHeaderSize)
+    {
+        throw std::invalid_argument("Mesh IO Error: not a binary STL file");
+    }
+    const uint32_t count = loadValue<uint32_t>(file.data + 80, !hostIsLittleEndian());
+    if (file.size != kSTLHeaderSize + kSTLRecordSize * static_cast<size_t>(count))
+    {
+        if (std::strncmp(file.data, "solid", 5) == 0)
+        {
+            throw std::invalid_argument("Mesh IO Error: ASCII STL files are not supported");
+        }
+        throw std::invalid_argument("Mesh IO Error: STL file size does not match its triangles count");
+    }
+    const bool swap = !hostIsLittleEndian();
+    MeshData soup;
+    soup.vertices.resize(3 * static_cast<size_t>(count), 3);
+    soup.faces.resize(count, 3);
+    soup.face_normals.resize(count, 3);
+    bunny_mesh::parallel::parallelFor(0, count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            const char *record = file.data + kSTLHeaderSize + i * kSTLRecordSize;
+            for (int k = 0; k < 3; k++)
+            {
+                soup.face_normals(i, k) = loadValue<float>(record + 4 * k, swap);
+            }
+            for (int corner = 0; corner < 3; corner++)
+            {
+                for (int k = 0; k < 3; k++)
+                {
+                    soup.vertices(3 * i + corner, k) = loadValue<float>(record + 12 * (corner + 1) + 4 * k, swap);
+                }
+                soup.faces(i, corner) = static_cast<int>(3 * i + corner);
+            }
+        }
+    });
+    if (!weld)
+    {
+        return soup;
+    }
+    bunny_mesh::WeldResult welded = bunny_mesh::weldVertices(soup.vertices, soup.faces, 0.0);
+    MeshData mesh;
+    mesh.vertices.swap(welded.vertices);
+    mesh.faces.swap(welded.faces);
+    mesh.face_normals.swap(soup.face_normals);
+    return mesh;
+}
+
+/**
+ * @brief Read an ASCII OBJ file.
+ *
+ * Two parallel passes over the same chunks of lines: the first counts the statements of each chunk, whose prefix
+ * sums give where each chunk writes, the second parses them directly into the output matrices.
+ */
+MeshData readOBJ(const std::string &filename)
+{
+    MappedFile file(filename);
+    const char *begin = file.data;
+    const char *end = file.data + file.size;
+
+    // chunks boundaries are moved to the next line start
+    const size_t numChunks = bunny_mesh::parallel::chunkCount(file.size, kMinParseChunk);
+    std::vector<const char *> bounds(numChunks + 1, end);
+    bounds[0] = begin;
+    for (size_t chunk = 1; chunk < numChunks; chunk++)
+    {
+        const char *bound = begin + file.size * chunk / numChunks;
+        bounds[chunk] = std::max(bounds[chunk - 1], bound == begin ? bound : nextLine(bound - 1, end));
+    }
+
+    // 1. counts
+    std::vector<ObjCounts> counts(numChunks + 1);
+    bunny_mesh::parallel::parallelForChunks(0, numChunks, numChunks, [&](size_t chunk, size_t, size_t) {
+        ObjCounts &count = counts[chunk + 1];
+        for (const char *line = bounds[chunk]; line < bounds[chunk + 1];)
+        {
+            const char *lineEnd = nextLine(line, end);
+            const char *p = line;
+            switch (objStatement(p, lineEnd))
+            {
+            case ObjStatement::Vertex:
+                count.vertices++;
+                break;
+            case ObjStatement::Normal:
+                count.normals++;
+                break;
+            case ObjStatement::Face:
+            {
+                size_t corners = 0;
+                for (p = skipBlanks(p, lineEnd); !isStatementEnd(p, lineEnd); p = skipBlanks(p, lineEnd))
+                {
+                    corners++;
+                    while (!isStatementEnd(p, lineEnd) && !isBlank(*p))
+                    {
+                        p++;
+                    }
+                }
+                if (corners < 3)
+                {
+                    throw objError("face with less than 3 vertices");
+                }
+                count.triangles += corners - 2;
+                break;
+            }
+            default:
+                break;
+            }
+            line = lineEnd;
+        }
+    });
+    for (size_t chunk = 1; chunk <= numChunks; chunk++)
+    {
+        counts[chunk].vertices += counts[chunk - 1].vertices;
+        counts[chunk].normals += counts[chunk - 1].normals;
+        counts[chunk].triangles += counts[chunk - 1].triangles;
+    }
+    const ObjCounts &total = counts[numChunks];
+
+    // 2. parsing, with the normal index of each vertex given by the faces corners, -1 while none
+    MeshData mesh;
+    mesh.vertices.resize(total.vertices, 3);
+    mesh.faces.resize(total.triangles, 3);
+    Point3DMatrixType normals(total.normals, 3);
+    std::unique_ptr<std::atomic<long>[]> vertexNormals;
+    std::atomic<bool> mappedNormals(false), splitNormals(false);
+    if (total.normals > 0)
+    {
+        vertexNormals.reset(new std::atomic<long>[total.vertices]);
+        bunny_mesh::parallel::parallelFor(0, total.vertices, [&](size_t begin, size_t end) {
+            for (size_t v = begin; v < end; v++)
+            {
+                vertexNormals[v].store(-1, std::memory_order_relaxed);
+            }
+        });
+    }
+    bunny_mesh::parallel::parallelForChunks(0, numChunks, numChunks, [&](size_t chunk, size_t, size_t) {
+        ObjCounts next = counts[chunk];
+        std::vector<long> polygon;
+        for (const char *line = bounds[chunk]; line < bounds[chunk + 1];)
+        {
+            const char *lineEnd = nextLine(line, end);
+            const char *p = line;
+            const ObjStatement statement = objStatement(p, lineEnd);
+            switch (statement)
+            {
+            case ObjStatement::Vertex:
+            case ObjStatement::Normal:
+            {
+                const bool vertex = statement == ObjStatement::Vertex;
+                double values[3];
+                for (int k = 0; k < 3; k++)
+                {
+                    p = skipBlanks(p, lineEnd);
+                    if (isStatementEnd(p, lineEnd))
+                    {
+                        throw objError(vertex ? "vertex" : "normal");
+                    }
+                    p = parseDouble(p, lineEnd, values[k]);
+                }
+                if (vertex)
+                {
+                    mesh.vertices.row(next.vertices++) << values[0], values[1], values[2];
+                }
+                else
+                {
+                    normals.row(next.normals++) << values[0], values[1], values[2];
+                }
+                break;
+            }
+            case ObjStatement::Face:
+            {
+                polygon.clear();
+                for (p = skipBlanks(p, lineEnd); !isStatementEnd(p, lineEnd); p = skipBlanks(p, lineEnd))
+                {
+                    long index, normalIndex;
+                    p = parseIndex(p, lineEnd, index, normalIndex);
+                    // relative indexes count back from the last vertex defined before the face
+                    index = index < 0 ? static_cast<long>(next.vertices) + index : index - 1;
+                    if (index < 0 || index >= static_cast<long>(total.vertices))
+                    {
+                        throw std::out_of_range("Mesh IO Error: face index out of vertices range");
+                    }
+                    polygon.push_back(index);
+                    // normal indexes of a file without normals are ignored
+                    if (normalIndex != 0 && total.normals > 0)
+                    {
+                        normalIndex = normalIndex < 0 ? static_cast<long>(next.normals) + normalIndex : normalIndex - 1;
+                        if (normalIndex < 0 || normalIndex >= static_cast<long>(total.normals))
+                        {
+                            throw std::out_of_range("Mesh IO Error: face normal index out of normals range");
+                        }
+                        long current = -1;
+                        if (!vertexNormals[index].compare_exchange_strong(current, normalIndex,
+                                                                           std::memory_order_relaxed) &&
+                            current != normalIndex)
+                        {
+                            splitNormals.store(true, std::memory_order_relaxed);
+                        }
+                        mappedNormals.store(true, std::memory_order_relaxed);
+                    }
+                }
+                for (size_t k = 2; k < polygon.size(); k++)
+                {
+                    mesh.faces.row(next.triangles++) << polygon[0], polygon[k - 1], polygon[k];
+                }
+                break;
+            }
+            default:
+                break;
+            }
+            line = lineEnd;
+        }
+    });
+
+    // normals split between the faces of a vertex have no single vertex normal
+    if (mappedNormals.load() && !splitNormals.load())
+    {
+        mesh.vertices_normals.resize(total.vertices, 3);
+        bunny_mesh::parallel::parallelFor(0, total.vertices, [&](size_t begin, size_t end) {
+            for (size_t v = begin; v < end; v++)
+            {
+                const long n = vertexNormals[v].load(std::memory_order_relaxed);
+                if (n >= 0)
+                {
+                    mesh.vertices_normals.row(v) = normals.row(n);
+                }
+                else
+                {
+                    mesh.vertices_normals.row(v).setConstant(std::numeric_limits<double>::quiet_NaN());
+                }
+            }
+        });
+    }
+    return mesh;
+}
+
+MeshData readMesh(const std::string &filename)
+{
+    const std::string extension = extensionOf(filename);
+    if (extension == "ply")
+    {
+        return readPLY(filename);
+    }
+    if (extension == "stl")
+    {
+        return readSTL(filename);
+    }
+    if (extension == "obj")
+    {
+        return readOBJ(filename);
+    }
+    throw std::invalid_argument("Mesh IO Error: unsupported mesh file extension '" + extension + "'");
+}
+
+void writePLY(const std::string &filename, const Point3DMatrixType &vertices, const IndexMatrixType &faces,
+              const Point3DMatrixType &verticesNormals)
+{
+    checkNormals(verticesNormals, vertices.rows());
+    const bool hasNormals = verticesNormals.rows() > 0;
+    std::ostringstream header;
+    header << "ply\n"
+           << "format " << (hostIsLittleEndian() ? "binary_little_endian" : "binary_big_endian") << " 1.0\n"
+           << "comment written by bunny_mesh_normals\n"
+           << "element vertex " << vertices.rows() << "\n"
+           << "property double x\nproperty double y\nproperty double z\n";
+    if (hasNormals)
+    {
+        header << "property double nx\nproperty double ny\nproperty double nz\n";
+    }
+    header << "element face " << faces.rows() << "\n"
+           << "property list uchar int vertex_indices\n"
+           << "end_header\n";
+    const std::string text = header.str();
+
+    OutputFile file(filename);
+    file.writeAt(text.data(), text.size(), 0);
+    const size_t vertexSize = (hasNormals ? 6 : 3) * sizeof(double);
+    writeRecords(file, text.size(), vertices.rows(), vertexSize, [&](size_t i, char *record) {
+        std::memcpy(record, vertices.row(i).data(), 3 * sizeof(double));
+        if (hasNormals)
+        {
+            std::memcpy(record + 3 * sizeof(double), verticesNormals.row(i).data(), 3 * sizeof(double));
+        }
+    });
+    const size_t faceSize = 1 + 3 * sizeof(int);
+    writeRecords(file, text.size() + vertexSize * vertices.rows(), faces.rows(), faceSize, [&](size_t i, char *record) {
+        record[0] = 3;
+        std::memcpy(record + 1, faces.row(i).data(), 3 * sizeof(int));
+    });
+}
+
+void writeSTL(const std::string &filename, const Point3DMatrixType &vertices, const IndexMatrixType &faces,
+              const Point3DMatrixType &faceNormals)
+{
+    checkNormals(faceNormals, faces.rows());
+    checkFaces(faces, vertices.rows());
+    const bool swap = !hostIsLittleEndian();
+    char header[kSTLHeaderSize];
+    std::memset(header, 0, sizeof(header));
+    std::strncpy(header, "binary STL written by bunny_mesh_normals", 80);
+    uint32_t count = static_cast<uint32_t>(faces.rows());
+    std::memcpy(header + 80, &count, 4);
+    if (swap)
+    {
+        std::reverse(header + 80, header + 84);
+    }
+
+    OutputFile file(filename);
+    file.writeAt(header, sizeof(header), 0);
+    writeRecords(file, kSTLHeaderSize, faces.rows(), kSTLRecordSize, [&](size_t i, char *record) {
+        Eigen::Matrix<float, 4, 3, Eigen::RowMajor> values;
+        for (int corner = 0; corner < 3; corner++)
+        {
+            values.row(corner + 1) = vertices.row(faces(i, corner)).cast<float>();
+        }
+        if (faceNormals.rows() > 0)
+        {
+            values.row(0) = faceNormals.row(i).cast<float>();
+        }
+        else
+        {
+            Eigen::RowVector3d normal = (vertices.row(faces(i, 1)) - vertices.row(faces(i, 0)))
+                                            .cross(vertices.row(faces(i, 2)) - vertices.row(faces(i, 0)));
+            double norm = normal.norm();
+            values.row(0) = (norm > 0.0 ? Eigen::RowVector3d(normal / norm) : Eigen::RowVector3d::Zero()).cast<float>();
+        }
+        std::memcpy(record, values.data(), 12 * sizeof(float));
+        if (swap)
+        {
+            for (int k = 0; k < 12; k++)
+            {
+                std::reverse(record + 4 * k, record + 4 * k + 4);
+            }
+        }
+        record[48] = record[49] = 0;
+    });
+}
+
+void writeOBJ(const std::string &filename, const Point3DMatrixType &vertices, const IndexMatrixType &faces,
+              const Point3DMatrixType &verticesNormals)
+{
+    checkNormals(verticesNormals, vertices.rows());
+    const bool hasNormals = verticesNormals.rows() > 0;
+    std::FILE *file = std::fopen(filename.c_str(), "wb");
+    if (!file)
+    {
+        throw systemError("cannot create '" + filename + "'");
+    }
+    try
+    {
+        std::fputs("# written by bunny_mesh_normals\n", file);
+        writeLines(file, vertices.rows(), [&](std::string &out, size_t i) { appendTriple(out, "v", vertices, i); });
+        if (hasNormals)
+        {
+            writeLines(file, verticesNormals.rows(),
+                       [&](std::string &out, size_t i) { appendTriple(out, "vn", verticesNormals, i); });
+        }
+        writeLines(file, faces.rows(), [&](std::string &out, size_t i) {
+            out += 'f';
+            for (int k = 0; k < 3; k++)
+            {
+                const std::string index = std::to_string(faces(i, k) + 1);
+                out += ' ';
+                out += index;
+                if (hasNormals)
+                {
+                    out += "//";
+                    out += index;
+                }
+            }
+            out += '\n';
+        });
+    }
+    catch (...)
+    {
+        std::fclose(file);
+        throw;
+    }
+    if (std::fclose(file) != 0)
+    {
+        throw systemError("cannot write '" + filename + "'");
+    }
+}
+
+void writeMesh(const std::string &filename, const Point3DMatrixType &vertices, const IndexMatrixType &faces,
+               const Point3DMatrixType &verticesNormals, const Point3DMatrixType &faceNormals)
+{
+    const std::string extension = extensionOf(filename);
+    if (extension == "ply")
+    {
+        writePLY(filename, vertices, faces, verticesNormals);
+    }
+    else if (extension == "stl")
+    {
+        writeSTL(filename, vertices, faces, faceNormals);
+    }
+    else if (extension == "obj")
+    {
+        writeOBJ(filename, vertices, faces, verticesNormals);
+    }
+    else
+    {
+        throw std::invalid_argument("Mesh IO Error: unsupported mesh file extension '" + extension + "'");
+    }
+}
+
+NumpyArrayWriter::NumpyArrayWriter(const std::string &filename, NumpyType type, size_t rows, size_t cols)
+    : type(type), numRows(rows), numCols(cols)
+{
+    create(filename, std::to_string(rows) + ", " + std::to_string(cols));
+}
+
+NumpyArrayWriter::NumpyArrayWriter(const std::string &filename, NumpyType type, size_t frames, size_t rows,
+                                   size_t cols)
+    : type(type), numRows(frames * rows), numCols(cols)
+{
+    create(filename, std::to_string(frames) + ", " + std::to_string(rows) + ", " + std::to_string(cols));
+}
+
+void NumpyArrayWriter::create(const std::string &filename, const std::string &shape)
+{
+    // format version 1.0: magic string, version, little endian header length, then the header dictionary padded
+    // with spaces and ended by a new line so that the data starts on a 64 bytes boundary
+    std::ostringstream dictionary;
+    dictionary << "{'descr': '" << (hostIsLittleEndian() ? '<' : '>') << numpyTypeCode(type)
+               << "', 'fortran_order': False, 'shape': (" << shape << "), }";
+    std::string header = dictionary.str();
+    const size_t preamble = 10;
+    header.append(63 - (preamble + header.size()) % 64, ' ');
+    header.push_back('\n');
+    if (header.size() > 0xffff)
+    {
+        throw std::invalid_argument("Mesh IO Error: numpy header too long");
+    }
+
+    std::string magic("\x93NUMPY\x01\x00", 8);
+    magic.push_back(static_cast<char>(header.size() & 0xff));
+    magic.push_back(static_cast<char>(header.size() >> 8));
+    header.insert(0, magic);
+    headerSize = header.size();
+
+    fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        throw systemError("cannot create '" + filename + "'");
+    }
+    try
+    {
+        writeAllAt(fd, header.data(), header.size(), 0);
+        // size the file up front, rows are then written in any order
+        if (ftruncate(fd, static_cast<off_t>(headerSize + numRows * numCols * numpyScalarSize(type))) < 0)
+        {
+            throw systemError("cannot resize '" + filename + "'");
+        }
+    }
+    catch (...)
+    {
+        close(fd);
+        throw;
+    }
+}
+
+NumpyArrayWriter::~NumpyArrayWriter() { close(fd); }
+
+void NumpyArrayWriter::writeRows(size_t firstRow, const double *data, size_t count) const
+{
+    writeBytes(firstRow, data, count, NumpyType::Float64);
+}
+
+void NumpyArrayWriter::writeRows(size_t firstRow, const int *data, size_t count) const
+{
+    writeBytes(firstRow, data, count, NumpyType::Int32);
+}
+
+void NumpyArrayWriter::writeRows(size_t firstRow, const float *data, size_t count) const
+{
+    writeBytes(firstRow, data, count, NumpyType::Float32);
+}
+
+void NumpyArrayWriter::writeBytes(size_t firstRow, const void *data, size_t count, NumpyType dataType) const
+{
+    if (dataType != type)
+    {
+        throw std::invalid_argument("Mesh IO Error: rows type does not match the numpy array type");
+    }
+    if (firstRow > numRows || count > numRows - firstRow)
+    {
+        throw std::out_of_range("Mesh IO Error: rows out of the numpy array range");
+    }
+    const size_t rowSize = numCols * numpyScalarSize(type);
+    writeAllAt(fd, static_cast<const char *>(data), count * rowSize, headerSize + firstRow * rowSize);
+}
+
+NumpyArrayReader::NumpyArrayReader(const std::string &filename)
+{
+    fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw systemError("cannot open '" + filename + "'");
+    }
+    try
+    {
+        // magic string, version, then the header length on 2 bytes for the version 1.0, on 4 bytes after
+        unsigned char preamble[12];
+        readAllAt(fd, reinterpret_cast<char *>(preamble), 10, 0);
+        if (std::memcmp(preamble, "\x93NUMPY", 6) != 0 || preamble[6] < 1 || preamble[6] > 3)
+        {
+            throw std::invalid_argument("Mesh IO Error: '" + filename + "' is not a numpy file");
+        }
+        size_t headerLength = preamble[8] | static_cast<size_t>(preamble[9]) << 8;
+        size_t preambleSize = 10;
+        if (preamble[6] > 1)
+        {
+            readAllAt(fd, reinterpret_cast<char *>(preamble) + 10, 2, 10);
+            headerLength |= static_cast<size_t>(preamble[10]) << 16 | static_cast<size_t>(preamble[11]) << 24;
+            preambleSize = 12;
+        }
+        std::string header(headerLength, '\0');
+        readAllAt(fd, &header[0], headerLength, preambleSize);
+        headerSize = preambleSize + headerLength;
+
+        const std::string descr = numpyHeaderValue(header, "descr");
+        const char order = hostIsLittleEndian() ? '<' : '>';
+        if (descr.size() != 3 || (descr[0] != order && descr[0] != '='))
+        {
+            throw std::invalid_argument("Mesh IO Error: numpy array is not in the host byte order");
+        }
+        const std::string code = descr.substr(1);
+        if (code == "f8")
+        {
+            arrayType = NumpyType::Float64;
+        }
+        else if (code == "i4")
+        {
+            arrayType = NumpyType::Int32;
+        }
+        else if (code == "f4")
+        {
+            arrayType = NumpyType::Float32;
+        }
+        else
+        {
+            throw std::invalid_argument("Mesh IO Error: unsupported numpy type '" + descr + "'");
+        }
+        if (numpyHeaderValue(header, "fortran_order") != "False")
+        {
+            throw std::invalid_argument("Mesh IO Error: numpy array is not in C order");
+        }
+        const std::string shape = numpyHeaderValue(header, "shape");
+        unsigned long frames = 1, rows = 0, cols = 0;
+        if (std::sscanf(shape.c_str(), "(%lu , %lu , %lu )", &frames, &rows, &cols) != 3)
+        {
+            frames = 1;
+            if (std::sscanf(shape.c_str(), "(%lu , %lu )", &rows, &cols) != 2)
+            {
+                throw std::invalid_argument("Mesh IO Error: numpy array is not two or three dimensional");
+            }
+        }
+        numFrames = frames;
+        numRows = frames * rows;
+        numCols = cols;
+
+        struct stat status;
+        if (fstat(fd, &status) < 0)
+        {
+            throw systemError("cannot stat '" + filename + "'");
+        }
+        if (static_cast<uint64_t>(status.st_size) < headerSize + numRows * numCols * numpyScalarSize(arrayType))
+        {
+            throw std::invalid_argument("Mesh IO Error: truncated numpy file");
+        }
+    }
+    catch (...)
+    {
+        close(fd);
+        throw;
+    }
+}
+
+NumpyArrayReader::~NumpyArrayReader() { close(fd); }
+
+void NumpyArrayReader::readRows(size_t firstRow, double *data, size_t count) const
+{
+    readBytes(firstRow, data, count, NumpyType::Float64);
+}
+
+void NumpyArrayReader::readRows(size_t firstRow, int *data, size_t count) const
+{
+    readBytes(firstRow, data, count, NumpyType::Int32);
+}
+
+void NumpyArrayReader::readRows(size_t firstRow, float *data, size_t count) const
+{
+    readBytes(firstRow, data, count, NumpyType::Float32);
+}
+
+void NumpyArrayReader::readBytes(size_t firstRow, void *data, size_t count, NumpyType dataType) const
+{
+    if (dataType != arrayType)
+    {
+        throw std::invalid_argument("Mesh IO Error: rows type does not match the numpy array type");
+    }
+    if (firstRow > numRows || count > numRows - firstRow)
+    {
+        throw std::out_of_range("Mesh IO Error: rows out of the numpy array range");
+    }
+    const size_t rowSize = numCols * numpyScalarSize(arrayType);
+    readAllAt(fd, static_cast<char *>(data), count * rowSize, headerSize + firstRow * rowSize);
+}
+
+} // namespace bunny_dataIO
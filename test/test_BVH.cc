@@ -0,0 +1,157 @@
+/**
+ * @file test_BVH.cc
+ * @brief Unitest module for the bunny_mesh/BVH.h file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "gtest/gtest.h"
+
+#include "bunny_mesh/data_io.h"
+#include "bunny_mesh/Mesh.h"
+#include "bunny_mesh/BVH.h"
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+using namespace bunny_mesh;
+
+namespace
+{
+/**
+ * @brief Distance from a point to a segment, clamping its projection on the segment line.
+ */
+double segmentDistance(const Eigen::Vector3d &p, const Eigen::Vector3d &a, const Eigen::Vector3d &b)
+{
+    const Eigen::Vector3d ab = b - a;
+    const double length2 = ab.squaredNorm();
+    const double t = length2 > 0.0 ? std::min(1.0, std::max(0.0, (p - a).dot(ab) / length2)) : 0.0;
+    return (a + t * ab - p).norm();
+}
+
+/**
+ * @brief Distance from a point to a triangle: to its projection on the plane when inside the triangle, else to the
+ * closest edge. Independent from the Voronoi regions of MeshBVH.
+ */
+double triangleDistance(const Eigen::Vector3d &p, const Eigen::Vector3d &a, const Eigen::Vector3d &b,
+                        const Eigen::Vector3d &c)
+{
+    const Eigen::Vector3d normal = (b - a).cross(c - a);
+    if (normal.squaredNorm() > 0.0)
+    {
+        const Eigen::Vector3d projection = p - (p - a).dot(normal) / normal.squaredNorm() * normal;
+        if ((b - a).cross(projection - a).dot(normal) >= 0.0 && (c - b).cross(projection - b).dot(normal) >= 0.0 &&
+            (a - c).cross(projection - c).dot(normal) >= 0.0)
+        {
+            return (p - projection).norm();
+        }
+    }
+    return std::min(segmentDistance(p, a, b), std::min(segmentDistance(p, b, c), segmentDistance(p, c, a)));
+}
+
+/**
+ * @brief Brute force closest face distance of each point, used as a reference.
+ */
+std::vector<double> bruteForceDistances(const bunny_dataIO::Point3DMatrixType &vertices,
+                                        const bunny_dataIO::IndexMatrixType &faces,
+                                        const bunny_dataIO::Point3DMatrixType &points)
+{
+    std::vector<double> best(points.rows(), std::numeric_limits<double>::infinity());
+    for (int i = 0; i < faces.rows(); i++)
+    {
+        const Eigen::Vector3d a = vertices.row(faces(i, 0)).transpose();
+        const Eigen::Vector3d b = vertices.row(faces(i, 1)).transpose();
+        const Eigen::Vector3d c = vertices.row(faces(i, 2)).transpose();
+        for (int j = 0; j < points.rows(); j++)
+        {
+            best[j] = std::min(best[j], triangleDistance(points.row(j).transpose(), a, b, c));
+        }
+    }
+    return best;
+}
+} // namespace
+
+TEST(BVH, SingleFaceQueries)
+{
+    bunny_dataIO::Point3DMatrixType vertices(3, 3);
+    vertices << 0.0, 0.0, 0.0,
+                1.0, 0.0, 0.0,
+                0.0, 1.0, 0.0;
+    bunny_dataIO::IndexMatrixType faces(1, 3);
+    faces << 0, 1, 2;
+    TriangleMesh mesh(vertices, faces);
+    mesh.ComputeNormals();
+    MeshBVH bvh(mesh);
+
+    // point above the face interior
+    MeshHit hit = bvh.closestPoint(bunny_dataIO::Point3DType(0.25, 0.25, 2.0));
+    ASSERT_EQ(0, hit.face);
+    ASSERT_NEAR(2.0, hit.distance, 1e-12);
+    ASSERT_TRUE(bunny_dataIO::Point3DType(0.5, 0.25, 0.25).isApprox(hit.barycentric));
+    ASSERT_TRUE(bunny_dataIO::Point3DType(0.0, 0.0, 1.0).isApprox(hit.normal));
+
+    // point closest to a vertex
+    hit = bvh.closestPoint(bunny_dataIO::Point3DType(2.0, -1.0, 0.0));
+    ASSERT_TRUE(bunny_dataIO::Point3DType(1.0, 0.0, 0.0).isApprox(hit.point));
+
+    // ray going down through the face
+    hit = bvh.intersect(bunny_dataIO::Point3DType(0.25, 0.25, 1.0), bunny_dataIO::Point3DType(0.0, 0.0, -1.0));
+    ASSERT_EQ(0, hit.face);
+    ASSERT_NEAR(1.0, hit.distance, 1e-12);
+    ASSERT_TRUE(bunny_dataIO::Point3DType(0.25, 0.25, 0.0).isApprox(hit.point));
+
+    // ray missing the face
+    hit = bvh.intersect(bunny_dataIO::Point3DType(2.0, 2.0, 1.0), bunny_dataIO::Point3DType(0.0, 0.0, -1.0));
+    ASSERT_FALSE(hit.valid());
+}
+
+TEST(BVH, BunnyMatchesBruteForce)
+{
+    bunny_dataIO::IndexMatrixType faces = bunny_dataIO::readIntNumPyArray("data/bunny_faces.npy");
+    bunny_dataIO::Point3DMatrixType vertices = bunny_dataIO::readFloatNumPyArray("data/bunny_vertices.npy");
+    TriangleMesh mesh(vertices, faces);
+    mesh.ComputeNormals();
+    MeshBVH bvh(mesh);
+
+    // a few query points around the bunny bounding box
+    Eigen::RowVector3d lo = vertices.colwise().minCoeff();
+    Eigen::RowVector3d hi = vertices.colwise().maxCoeff();
+    std::srand(7);
+    const int numQueries = 16;
+    bunny_dataIO::Point3DMatrixType points(numQueries, 3);
+    for (int i = 0; i < numQueries; i++)
+    {
+        Eigen::RowVector3d t = (Eigen::RowVector3d::Random() + Eigen::RowVector3d::Ones()) * 0.5;
+        points.row(i) = lo + t.cwiseProduct(hi - lo) * 1.2 - 0.1 * (hi - lo);
+    }
+    std::vector<MeshHit> hits = bvh.closestPoints(points);
+    std::vector<double> expected = bruteForceDistances(vertices, faces, points);
+    for (int i = 0; i < numQueries; i++)
+    {
+        ASSERT_TRUE(hits[i].valid());
+        ASSERT_NEAR(expected[i], hits[i].distance, 1e-12);
+        ASSERT_NEAR(1.0, hits[i].normal.norm(), 1e-9);
+    }
+
+    // rays shot from far away toward a face centroid must hit at, or before, that centroid
+    bunny_dataIO::Point3DMatrixType origins(numQueries, 3), directions(numQueries, 3);
+    for (int i = 0; i < numQueries; i++)
+    {
+        int face = i * 97 % faces.rows();
+        bunny_dataIO::Point3DType target =
+            (vertices.row(faces(face, 0)) + vertices.row(faces(face, 1)) + vertices.row(faces(face, 2))) / 3.0;
+        origins.row(i) = target + 10.0 * (hi - lo).norm() * mesh.getFaceNormals().row(face);
+        directions.row(i) = target - origins.row(i);
+    }
+    std::vector<MeshHit> rayHits = bvh.intersectRays(origins, directions);
+    for (int i = 0; i < numQueries; i++)
+    {
+        ASSERT_TRUE(rayHits[i].valid());
+        ASSERT_LE(rayHits[i].distance, 1.0 + 1e-9);
+    }
+}
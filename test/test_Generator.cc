@@ -0,0 +1,267 @@
+/**
+ * @file test_Generator.cc
+ * @brief Unitest module for the bunny_mesh/Generator.h file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "gtest/gtest.h"
+
+#include "bunny_mesh/data_io.h"
+#include "bunny_mesh/Generator.h"
+#include "bunny_mesh/parallel.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace bunny_dataIO;
+using namespace bunny_mesh::synthetic;
+
+namespace
+{
+/**
+ * @brief Number of faces of each directed edge: 1 for both directions of every edge of a closed oriented mesh.
+ */
+std::map<std::pair<int, int>, int> directedEdges(const IndexMatrixType &faces)
+{
+    std::map<std::pair<int, int>, int> edges;
+    for (Eigen::Index f = 0; f < faces.rows(); f++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            edges[std::make_pair(faces(f, k), faces(f, (k + 1) % 3))]++;
+        }
+    }
+    return edges;
+}
+
+void expectClosedAndOriented(const IndexMatrixType &faces)
+{
+    std::map<std::pair<int, int>, int> edges = directedEdges(faces);
+    for (const auto &edge : edges)
+    {
+        ASSERT_EQ(edge.second, 1);
+        ASSERT_EQ(edges.count(std::make_pair(edge.first.second, edge.first.first)), 1u);
+    }
+}
+
+/**
+ * @brief Generate a mesh by blocks of an uneven size, on a single thread.
+ */
+void generateByBlocks(const MeshGenerator &generator, size_t block, Point3DMatrixType &vertices,
+                      IndexMatrixType &faces)
+{
+    vertices.resize(generator.numVertices(), 3);
+    faces.resize(generator.numFaces(), 3);
+    for (size_t first = 0; first < generator.numVertices(); first += block)
+    {
+        generator.vertices(first, std::min(first + block, generator.numVertices()), vertices.data() + 3 * first);
+    }
+    for (size_t first = 0; first < generator.numFaces(); first += block)
+    {
+        generator.faces(first, std::min(first + block, generator.numFaces()), faces.data() + 3 * first);
+    }
+}
+
+void expectSameMesh(const Point3DMatrixType &vertices, const IndexMatrixType &faces,
+                    const Point3DMatrixType &otherVertices, const IndexMatrixType &otherFaces)
+{
+    ASSERT_EQ(vertices.rows(), otherVertices.rows());
+    ASSERT_EQ(faces.rows(), otherFaces.rows());
+    EXPECT_EQ(std::memcmp(vertices.data(), otherVertices.data(), vertices.size() * sizeof(double)), 0);
+    EXPECT_EQ(std::memcmp(faces.data(), otherFaces.data(), faces.size() * sizeof(int)), 0);
+}
+} // namespace
+
+TEST(Generator, IcosphereIsAClosedSphere)
+{
+    for (int frequency : {1, 2, 3, 4, 7})
+    {
+        IcosphereGenerator generator(frequency, 2.0);
+        ASSERT_EQ(generator.numVertices(), 10u * frequency * frequency + 2);
+        ASSERT_EQ(generator.numFaces(), 20u * frequency * frequency);
+        Point3DMatrixType vertices;
+        IndexMatrixType faces;
+        generateMesh(generator, vertices, faces);
+
+        EXPECT_GE(faces.minCoeff(), 0);
+        EXPECT_LT(faces.maxCoeff(), vertices.rows());
+        expectClosedAndOriented(faces);
+        for (Eigen::Index v = 0; v < vertices.rows(); v++)
+        {
+            EXPECT_NEAR(vertices.row(v).norm(), 2.0, 1e-12);
+        }
+        // every face turns outwards
+        for (Eigen::Index f = 0; f < faces.rows(); f++)
+        {
+            const Point3DType a = vertices.row(faces(f, 0)), b = vertices.row(faces(f, 1)), c = vertices.row(faces(f, 2));
+            EXPECT_GT((b - a).cross(c - a).dot(a + b + c), 0.0);
+        }
+    }
+    EXPECT_EQ(IcosphereGenerator::frequencyForFaces(20 * 64 * 64 + 100), 64);
+    EXPECT_EQ(IcosphereGenerator::frequencyForFaces(0), 1);
+    EXPECT_THROW(IcosphereGenerator(0), std::invalid_argument);
+    EXPECT_THROW(IcosphereGenerator(20000), std::invalid_argument);
+}
+
+TEST(Generator, TerrainIsASeededHeightField)
+{
+    TerrainGenerator generator(40, 25, 0.2, 6, 7);
+    ASSERT_EQ(generator.numVertices(), 41u * 26u);
+    ASSERT_EQ(generator.numFaces(), 2u * 40u * 25u);
+    Point3DMatrixType vertices;
+    IndexMatrixType faces;
+    generateMesh(generator, vertices, faces);
+
+    // the grid spans 1 along its longest side, faces turn up
+    EXPECT_DOUBLE_EQ(vertices.col(0).maxCoeff(), 1.0);
+    EXPECT_DOUBLE_EQ(vertices.col(1).maxCoeff(), 25.0 / 40.0);
+    EXPECT_LT(vertices.col(2).cwiseAbs().maxCoeff(), 0.4);
+    EXPECT_GT(vertices.col(2).maxCoeff() - vertices.col(2).minCoeff(), 0.01);
+    for (Eigen::Index f = 0; f < faces.rows(); f++)
+    {
+        const Point3DType a = vertices.row(faces(f, 0)), b = vertices.row(faces(f, 1)), c = vertices.row(faces(f, 2));
+        EXPECT_GT((b - a).cross(c - a)(2), 0.0);
+    }
+
+    Point3DMatrixType sameSeed, otherSeed;
+    generateMesh(TerrainGenerator(40, 25, 0.2, 6, 7), sameSeed, faces);
+    generateMesh(TerrainGenerator(40, 25, 0.2, 6, 8), otherSeed, faces);
+    EXPECT_TRUE(sameSeed == vertices);
+    EXPECT_FALSE(otherSeed == vertices);
+
+    EXPECT_EQ(TerrainGenerator::withFaces(2 * 300 * 300).numFaces(), 2u * 300u * 300u);
+    EXPECT_THROW(TerrainGenerator(0, 4), std::invalid_argument);
+    EXPECT_THROW(TerrainGenerator(100000, 100000), std::invalid_argument);
+}
+
+TEST(Generator, LoopSubdivision)
+{
+    // icosahedron: regular valence 5 vertices move to the same radius, edge vertices too
+    Point3DMatrixType vertices;
+    IndexMatrixType faces;
+    generateMesh(IcosphereGenerator(1), vertices, faces);
+    LoopSubdivisionGenerator icosahedron(vertices, faces, 1);
+    ASSERT_EQ(icosahedron.numVertices(), 12u + 30u);
+    ASSERT_EQ(icosahedron.numFaces(), 80u);
+    Point3DMatrixType subdividedVertices;
+    IndexMatrixType subdividedFaces;
+    generateMesh(icosahedron, subdividedVertices, subdividedFaces);
+    expectClosedAndOriented(subdividedFaces);
+    const double beta = (0.625 - std::pow(0.375 + 0.25 * std::cos(2.0 * M_PI / 5), 2)) / 5;
+    // neighbours of a corner of the unit icosahedron sum to 5 cos(edge angle) times the corner
+    const double neighbourSum = 5.0 / std::sqrt(5.0);
+    for (Eigen::Index v = 0; v < 12; v++)
+    {
+        EXPECT_NEAR(subdividedVertices.row(v).norm(), 1.0 - 5.0 * beta + beta * neighbourSum, 1e-12);
+    }
+    for (Eigen::Index v = 12; v < 42; v++)
+    {
+        EXPECT_NEAR(subdividedVertices.row(v).norm(), subdividedVertices.row(12).norm(), 1e-12);
+    }
+
+    // flat open grid: stays flat, creases keep the border on the border
+    generateMesh(TerrainGenerator(6, 4, 0.0), vertices, faces);
+    generateMesh(LoopSubdivisionGenerator(vertices, faces, 2), subdividedVertices, subdividedFaces);
+    ASSERT_EQ(subdividedFaces.rows(), 16 * faces.rows());
+    EXPECT_EQ(subdividedVertices.col(2).cwiseAbs().maxCoeff(), 0.0);
+    EXPECT_NEAR(subdividedVertices.col(0).minCoeff(), 0.0, 1e-15);
+    EXPECT_NEAR(subdividedVertices.col(0).maxCoeff(), 1.0, 1e-15);
+    EXPECT_NEAR(subdividedVertices.col(1).maxCoeff(), 4.0 / 6.0, 1e-15);
+
+    // non manifold edge: three faces around (0, 1) are creases, their vertices are corners and stay in place
+    Point3DMatrixType fan(5, 3);
+    fan << 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, -1, 0, 0, 0, 1;
+    IndexMatrixType fanFaces(3, 3);
+    fanFaces << 0, 1, 2, 1, 0, 3, 0, 1, 4;
+    generateMesh(LoopSubdivisionGenerator(fan, fanFaces, 1), subdividedVertices, subdividedFaces);
+    EXPECT_TRUE(subdividedVertices.row(0) == fan.row(0));
+    EXPECT_TRUE(subdividedVertices.row(1) == fan.row(1));
+
+    EXPECT_THROW(LoopSubdivisionGenerator(vertices, faces, 0), std::invalid_argument);
+    fanFaces(2, 2) = 1;
+    EXPECT_THROW(LoopSubdivisionGenerator(fan, fanFaces, 1), std::invalid_argument);
+}
+
+TEST(Generator, LoopSubdividedBunny)
+{
+    const IndexMatrixType faces = readIntNumPyArray("data/bunny_faces.npy");
+    const Point3DMatrixType vertices = readFloatNumPyArray("data/bunny_vertices.npy");
+    EXPECT_EQ(LoopSubdivisionGenerator::levelsForFaces(faces.rows(), 1000), 1);
+    EXPECT_EQ(LoopSubdivisionGenerator::levelsForFaces(faces.rows(), 1000000), 3);
+
+    // two levels at once subdivide the once subdivided bunny, whose edges were hashed instead of derived: faces
+    // are numbered the same, edge vertices are not
+    Point3DMatrixType once, twice, onceTwice;
+    IndexMatrixType onceFaces, twiceFaces, onceTwiceFaces;
+    generateMesh(LoopSubdivisionGenerator(vertices, faces, 1), once, onceFaces);
+    generateMesh(LoopSubdivisionGenerator(vertices, faces, 2), twice, twiceFaces);
+    generateMesh(LoopSubdivisionGenerator(once, onceFaces, 1), onceTwice, onceTwiceFaces);
+    ASSERT_EQ(twiceFaces.rows(), 16 * faces.rows());
+    ASSERT_EQ(twice.rows(), onceTwice.rows());
+    EXPECT_GE(twiceFaces.minCoeff(), 0);
+    EXPECT_LT(twiceFaces.maxCoeff(), twice.rows());
+    EXPECT_TRUE(twice.allFinite());
+    std::vector<int> match(twice.rows(), -1);
+    for (Eigen::Index f = 0; f < twiceFaces.rows(); f++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            const int v = twiceFaces(f, k), other = onceTwiceFaces(f, k);
+            ASSERT_TRUE(match[v] == -1 || match[v] == other);
+            match[v] = other;
+            EXPECT_LT((twice.row(v) - onceTwice.row(other)).norm(), 1e-12);
+        }
+    }
+}
+
+TEST(Generator, RowsOnlyDependOnTheirIndex)
+{
+    const IndexMatrixType faces = readIntNumPyArray("data/bunny_faces.npy");
+    const Point3DMatrixType vertices = readFloatNumPyArray("data/bunny_vertices.npy");
+    const IcosphereGenerator icosphere(23);
+    const TerrainGenerator terrain(57, 31);
+    const LoopSubdivisionGenerator bunny(vertices, faces, 1);
+    for (const MeshGenerator *generator : {static_cast<const MeshGenerator *>(&icosphere),
+                                           static_cast<const MeshGenerator *>(&terrain),
+                                           static_cast<const MeshGenerator *>(&bunny)})
+    {
+        Point3DMatrixType wholeVertices, blockVertices;
+        IndexMatrixType wholeFaces, blockFaces;
+        bunny_mesh::parallel::setNumThreads(3);
+        generateMesh(*generator, wholeVertices, wholeFaces);
+        bunny_mesh::parallel::setNumThreads(0);
+        generateByBlocks(*generator, 997, blockVertices, blockFaces);
+        expectSameMesh(wholeVertices, wholeFaces, blockVertices, blockFaces);
+    }
+}
+
+TEST(Generator, WriteNumpyStreamsTheMesh)
+{
+    const std::string verticesPath = "/tmp/bunny_generator_test." + std::to_string(getpid()) + ".vertices.npy";
+    const std::string facesPath = "/tmp/bunny_generator_test." + std::to_string(getpid()) + ".faces.npy";
+    const IcosphereGenerator generator(31);
+    Point3DMatrixType vertices;
+    IndexMatrixType faces;
+    generateMesh(generator, vertices, faces);
+
+    // small blocks over several threads, written out of order
+    bunny_mesh::parallel::setNumThreads(4);
+    writeNumpy(generator, verticesPath, facesPath, 1000);
+    bunny_mesh::parallel::setNumThreads(0);
+    expectSameMesh(vertices, faces, readFloatNumPyArray(verticesPath), readIntNumPyArray(facesPath));
+
+    EXPECT_THROW(writeNumpy(generator, verticesPath, facesPath, 0), std::invalid_argument);
+    EXPECT_THROW(writeNumpy(generator, "/nonexistent/vertices.npy", facesPath), std::runtime_error);
+    std::remove(verticesPath.c_str());
+    std::remove(facesPath.c_str());
+}
@@ -0,0 +1,198 @@
+/**
+ * @file test_MemoryBudget.cc
+ * @brief Unitest module for the bunny_mesh/MemoryBudget.h file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "gtest/gtest.h"
+
+#include "bunny_mesh/MemoryBudget.h"
+#include "bunny_mesh/Mesh.h"
+#include "bunny_mesh/data_io.h"
+#include "bunny_mesh/mesh_io.h"
+#include "bunny_mesh/parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace bunny_mesh::memory;
+using bunny_dataIO::IndexMatrixType;
+using bunny_dataIO::Point3DMatrixType;
+
+namespace
+{
+const MemoryStrategy kStrategies[] = {MemoryStrategy::Default, MemoryStrategy::InPlace, MemoryStrategy::Streaming,
+                                      MemoryStrategy::Chunked, MemoryStrategy::Float32};
+
+std::string outputPath(const std::string &name)
+{
+    return "/tmp/bunny_memory_test." + std::to_string(getpid()) + "." + name + ".npy";
+}
+
+template <typename Scalar>
+Eigen::Matrix<Scalar, Eigen::Dynamic, 3, Eigen::RowMajor> readNumpy(const std::string &path)
+{
+    bunny_dataIO::NumpyArrayReader reader(path);
+    Eigen::Matrix<Scalar, Eigen::Dynamic, 3, Eigen::RowMajor> matrix(reader.rows(), 3);
+    reader.readRows(0, matrix.data(), reader.rows());
+    return matrix;
+}
+
+// NaN normals of unreferenced vertices compare bitwise
+bool sameBits(const Point3DMatrixType &a, const Point3DMatrixType &b)
+{
+    return a.rows() == b.rows() && std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+}
+} // namespace
+
+TEST(MemoryBudget, StrategiesFollowTheBudget)
+{
+    // one million faces: every strategy needs less than the previous one
+    const size_t num_vertices = 500000, num_faces = 1000000;
+    for (size_t i = 1; i < sizeof(kStrategies) / sizeof(kStrategies[0]); i++)
+    {
+        EXPECT_LT(predictPeakBytes(kStrategies[i], num_vertices, num_faces),
+                  predictPeakBytes(kStrategies[i - 1], num_vertices, num_faces))
+            << strategyName(kStrategies[i]);
+    }
+    // the plain pipeline holds the faces twice, the vertices four times and the face normals twice
+    EXPECT_GE(predictPeakBytes(MemoryStrategy::Default, num_vertices, num_faces),
+              2 * 12 * num_faces + 4 * 24 * num_vertices + 2 * 24 * num_faces);
+    // the smallest one holds the vertices and their single precision normals, and a few megabytes of blocks
+    EXPECT_LT(predictPeakBytes(MemoryStrategy::Float32, num_vertices, num_faces), 36 * num_vertices + (4 << 20));
+
+    const size_t baseline = 8 << 20;
+    for (MemoryStrategy strategy : kStrategies)
+    {
+        const size_t budget = baseline + predictPeakBytes(strategy, num_vertices, num_faces);
+        EXPECT_EQ(chooseStrategy(budget, baseline, num_vertices, num_faces), strategy);
+        if (strategy != MemoryStrategy::Default)
+        {
+            EXPECT_EQ(chooseStrategy(budget + 1, baseline, num_vertices, num_faces), strategy);
+        }
+    }
+    EXPECT_EQ(chooseStrategy(SIZE_MAX, baseline, num_vertices, num_faces), MemoryStrategy::Default);
+    EXPECT_THROW(chooseStrategy(baseline + predictPeakBytes(MemoryStrategy::Float32, num_vertices, num_faces) - 1,
+                                baseline, num_vertices, num_faces),
+                 std::invalid_argument);
+}
+
+TEST(MemoryBudget, StrategiesComputeTheSameNormals)
+{
+    // faces repeated the other way round cancel out, leaving rounding noise for the normal of their vertices,
+    // which single precision does not reproduce: only the first of them is kept
+    const IndexMatrixType bunnyFaces = bunny_dataIO::readIntNumPyArray("data/bunny_faces.npy");
+    const Point3DMatrixType vertices = bunny_dataIO::readFloatNumPyArray("data/bunny_vertices.npy");
+    std::set<std::vector<int>> seen;
+    std::vector<int> kept;
+    for (Eigen::Index f = 0; f < bunnyFaces.rows(); f++)
+    {
+        std::vector<int> corners(bunnyFaces.row(f).data(), bunnyFaces.row(f).data() + 3);
+        std::sort(corners.begin(), corners.end());
+        if (seen.insert(corners).second)
+        {
+            kept.insert(kept.end(), bunnyFaces.row(f).data(), bunnyFaces.row(f).data() + 3);
+        }
+    }
+    const IndexMatrixType faces = Eigen::Map<const IndexMatrixType>(kept.data(), kept.size() / 3, 3);
+    const std::string facesPath = outputPath("input");
+    bunny_dataIO::NumpyArrayWriter(facesPath, bunny_dataIO::NumpyType::Int32, faces.rows(), 3)
+        .writeRows(0, faces.data(), faces.rows());
+
+    bunny_mesh::parallel::setNumThreads(1);
+    bunny_mesh::TriangleMesh mesh(vertices, faces);
+    mesh.ComputeNormals();
+
+    const std::string faceNormalsPath = outputPath("faces"), verticesNormalsPath = outputPath("vertices");
+    for (MemoryStrategy strategy : kStrategies)
+    {
+        // streamed face normals are computed in parallel, and still summed in face order
+        bunny_mesh::parallel::setNumThreads(strategy == MemoryStrategy::Default ? 1 : 3);
+        MemoryAccounting accounting;
+        computeNormalsFiles(strategy, facesPath, "data/bunny_vertices.npy", faceNormalsPath, verticesNormalsPath,
+                            accounting);
+        ASSERT_FALSE(accounting.stages().empty());
+        const bool resident = strategy == MemoryStrategy::Default || strategy == MemoryStrategy::InPlace;
+        EXPECT_EQ(accounting.stages().back().name, resident ? "write normals" : "vertex normals");
+
+        if (strategy == MemoryStrategy::Float32)
+        {
+            const Eigen::Matrix<float, Eigen::Dynamic, 3, Eigen::RowMajor> faceNormals =
+                readNumpy<float>(faceNormalsPath), verticesNormals = readNumpy<float>(verticesNormalsPath);
+            EXPECT_TRUE(faceNormals.cast<double>().isApprox(mesh.getFaceNormals(), 1e-6));
+            const Point3DMatrixType expected = mesh.getVerticeNormals();
+            ASSERT_EQ(verticesNormals.rows(), expected.rows());
+            for (Eigen::Index v = 0; v < expected.rows(); v++)
+            {
+                ASSERT_EQ(verticesNormals.row(v).allFinite(), expected.row(v).allFinite()) << v;
+                if (expected.row(v).allFinite())
+                {
+                    ASSERT_LT((verticesNormals.row(v).cast<double>() - expected.row(v)).norm(), 1e-5) << v;
+                }
+            }
+        }
+        else
+        {
+            EXPECT_TRUE(sameBits(readNumpy<double>(faceNormalsPath), mesh.getFaceNormals())) << strategyName(strategy);
+            EXPECT_TRUE(sameBits(readNumpy<double>(verticesNormalsPath), mesh.getVerticeNormals()))
+                << strategyName(strategy);
+        }
+    }
+    bunny_mesh::parallel::setNumThreads(0);
+    std::remove(facesPath.c_str());
+    std::remove(faceNormalsPath.c_str());
+    std::remove(verticesNormalsPath.c_str());
+
+    // inputs of the wrong type, or faces out of the vertices range
+    MemoryAccounting accounting;
+    EXPECT_THROW(computeNormalsFiles(MemoryStrategy::Chunked, "data/bunny_vertices.npy", "data/bunny_vertices.npy",
+                                     faceNormalsPath, verticesNormalsPath, accounting),
+                 std::invalid_argument);
+    const std::string shortVerticesPath = outputPath("short");
+    bunny_dataIO::NumpyArrayWriter(shortVerticesPath, bunny_dataIO::NumpyType::Float64, 10, 3)
+        .writeRows(0, vertices.data(), 10);
+    EXPECT_THROW(computeNormalsFiles(MemoryStrategy::Chunked, "data/bunny_faces.npy", shortVerticesPath,
+                                     faceNormalsPath, verticesNormalsPath, accounting),
+                 std::out_of_range);
+    std::remove(shortVerticesPath.c_str());
+    std::remove(faceNormalsPath.c_str());
+    std::remove(verticesNormalsPath.c_str());
+}
+
+TEST(MemoryBudget, AccountingRecordsEachStage)
+{
+    MemoryAccounting accounting;
+    std::vector<double> buffer(8 << 20, 1.0);
+    accounting.record("allocate");
+    buffer = std::vector<double>();
+    accounting.record("free");
+    ASSERT_EQ(accounting.stages().size(), 2u);
+    EXPECT_EQ(accounting.stages()[0].name, "allocate");
+    if (heapBytes() > 0)
+    {
+        EXPECT_GE(accounting.stages()[0].heap_change, static_cast<int64_t>(sizeof(double) << 23));
+        EXPECT_LE(accounting.stages()[1].heap_change, -static_cast<int64_t>(sizeof(double) << 23));
+    }
+    if (residentBytes() > 0)
+    {
+        // the buffer was resident at the end of its stage, and freed before the end of the next one
+        EXPECT_GE(accounting.stages()[0].resident, sizeof(double) << 23);
+        EXPECT_GE(accounting.peakResident(), accounting.stages()[0].resident);
+        EXPECT_LT(accounting.stages()[1].resident, accounting.stages()[0].resident);
+    }
+    std::ostringstream report;
+    accounting.print(report);
+    EXPECT_NE(report.str().find("allocate"), std::string::npos);
+}
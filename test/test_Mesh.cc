@@ -11,8 +11,11 @@
 
 #include "bunny_mesh/data_io.h"
 #include "bunny_mesh/Mesh.h"
+#include "bunny_mesh/parallel.h"
+#include "test_helpers.h"
 
 #include <Eigen/Dense>
+#include <cstring>
 #include <math.h>
 #include <iostream>
 
@@ -383,4 +386,165 @@ TEST(Mesh, verticesIntoWorld)
 //     // norm assertions:
 //     ASSERT_TRUE(expectedFaceNormals.isApprox(singleFaceMesh.getFaceNormals()));
 //     ASSERT_TRUE(expectedVerticeNormals.isApprox(singleFaceMesh.getVerticeNormals()));
-// }
\ No newline at end of file
+// }
+
+TEST(Mesh, SingleFaceAttributes)
+{
+    bunny_dataIO::Point3DMatrixType vertices(3, 3);
+    vertices << 0.0, 0.0, 1.0,
+                2.0, 0.0, 1.0,
+                0.0, 2.0, 1.0;
+    bunny_dataIO::IndexMatrixType faces(1, 3);
+    faces << 0, 1, 2;
+
+    TriangleMesh singleFaceMesh(vertices, faces);
+    FaceAttributes attributes;
+    singleFaceMesh.ComputeNormals<AllFaceAttributes>(attributes);
+
+    ASSERT_EQ(attributes.face_areas.size(), 1);
+    ASSERT_NEAR(attributes.face_areas(0), 2.0, precision);
+    ASSERT_NEAR(attributes.surface_area, 2.0, precision);
+    ASSERT_TRUE(bunny_dataIO::Point3DType(2.0 / 3.0, 2.0 / 3.0, 1.0).isApprox(attributes.face_centroids.row(0)));
+    ASSERT_TRUE(bunny_dataIO::Point3DType(0.0, 0.0, 1.0).isApprox(attributes.bounds_min));
+    ASSERT_TRUE(bunny_dataIO::Point3DType(2.0, 2.0, 1.0).isApprox(attributes.bounds_max));
+
+    // only the selected attributes are written
+    FaceAttributes areaOnly;
+    singleFaceMesh.ComputeNormals<SurfaceArea>(areaOnly);
+    ASSERT_NEAR(areaOnly.surface_area, 2.0, precision);
+    ASSERT_EQ(areaOnly.face_areas.size(), 0);
+    ASSERT_EQ(areaOnly.face_centroids.rows(), 0);
+}
+
+/**
+ * @brief Tests changing the number of threads, which is reset even when an assertion fails.
+ */
+class MeshThreads : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        parallel::setNumThreads(0);
+    }
+};
+
+TEST_F(MeshThreads, FusedAttributesMatchSeparatePasses)
+{
+    // several shifted bunnies, so that faces are split in several chunks
+    bunny_dataIO::Point3DMatrixType vertices;
+    bunny_dataIO::IndexMatrixType faces;
+    bunny_test::shiftedBunnies(8, 0.2, vertices, faces);
+
+    parallel::setNumThreads(4);
+    TriangleMesh mesh(vertices, faces);
+    FaceAttributes attributes;
+    mesh.ComputeNormals<AllFaceAttributes>(attributes);
+    bunny_dataIO::Point3DMatrixType fusedVerticesNormals = mesh.getVerticeNormals();
+    bunny_dataIO::Point3DMatrixType fusedFaceNormals = mesh.getFaceNormals();
+
+    // normals do not depend on the selected attributes
+    mesh.ComputeNormals();
+    ASSERT_TRUE(fusedFaceNormals == mesh.getFaceNormals());
+    ASSERT_TRUE((fusedVerticesNormals.array() == mesh.getVerticeNormals().array() ||
+                 fusedVerticesNormals.array().isNaN()).all());
+
+    // and match a single chunk run up to the summation order
+    parallel::setNumThreads(1);
+    TriangleMesh serial(vertices, faces);
+    serial.ComputeNormals();
+    ASSERT_TRUE(fusedFaceNormals == serial.getFaceNormals());
+    for (int i = 0; i < vertices.rows(); i++)
+    {
+        if (!std::isnan(serial.getVerticeNormals()(i, 0)))
+        {
+            ASSERT_TRUE(serial.getVerticeNormals().row(i).isApprox(fusedVerticesNormals.row(i), 1e-9));
+        }
+    }
+
+    // separate passes
+    double surfaceArea = 0.0;
+    bunny_dataIO::Point3DType boundsMin = vertices.row(faces(0, 0)), boundsMax = boundsMin;
+    for (int i = 0; i < faces.rows(); i++)
+    {
+        bunny_dataIO::Point3DType v0 = vertices.row(faces(i, 0)), v1 = vertices.row(faces(i, 1)), v2 = vertices.row(faces(i, 2));
+        double area = 0.5 * (v1 - v0).cross(v2 - v0).norm();
+        ASSERT_NEAR(attributes.face_areas(i), area, 1e-15);
+        ASSERT_TRUE(((v0 + v1 + v2) / 3.0).isApprox(attributes.face_centroids.row(i)));
+        surfaceArea += area;
+        boundsMin = boundsMin.cwiseMin(v0).cwiseMin(v1).cwiseMin(v2);
+        boundsMax = boundsMax.cwiseMax(v0).cwiseMax(v1).cwiseMax(v2);
+    }
+    ASSERT_NEAR(attributes.surface_area, surfaceArea, 1e-9 * surfaceArea);
+    ASSERT_TRUE(attributes.bounds_min == boundsMin);
+    ASSERT_TRUE(attributes.bounds_max == boundsMax);
+}
+
+TEST_F(MeshThreads, DeterministicNormalsIgnoreThreadCount)
+{
+    // overlapping shifted bunnies, sharing no vertex, large enough for the deterministic gather
+    bunny_dataIO::Point3DMatrixType vertices;
+    bunny_dataIO::IndexMatrixType faces;
+    bunny_test::shiftedBunnies(8, 0.01, vertices, faces);
+
+    // the fast path on a single thread is the serial algorithm
+    parallel::setNumThreads(1);
+    TriangleMesh serial(vertices, faces);
+    FaceAttributes serialAttributes;
+    serial.ComputeNormals<AllFaceAttributes>(serialAttributes);
+
+    // NaN normals of unreferenced vertices compare bitwise
+    auto sameBits = [](const bunny_dataIO::Point3DMatrixType &a, const bunny_dataIO::Point3DMatrixType &b) {
+        return a.rows() == b.rows() && std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+    };
+
+    TriangleMesh mesh(vertices, faces);
+    mesh.setDeterministic(true);
+    ASSERT_TRUE(mesh.isDeterministic());
+    double surfaceArea = 0.0;
+    for (unsigned threads : {1u, 2u, 3u, 4u, 8u})
+    {
+        parallel::setNumThreads(threads);
+        FaceAttributes attributes;
+        mesh.ComputeNormals<AllFaceAttributes>(attributes);
+        ASSERT_TRUE(sameBits(mesh.getVerticeNormals(), serial.getVerticeNormals())) << threads << " threads";
+        ASSERT_TRUE(sameBits(mesh.getFaceNormals(), serial.getFaceNormals())) << threads << " threads";
+        ASSERT_TRUE(attributes.face_areas == serialAttributes.face_areas);
+        ASSERT_TRUE(attributes.face_centroids == serialAttributes.face_centroids);
+        ASSERT_TRUE(attributes.bounds_min == serialAttributes.bounds_min);
+        ASSERT_TRUE(attributes.bounds_max == serialAttributes.bounds_max);
+        // summed per fixed block of faces rather than in a single running sum
+        if (threads == 1)
+        {
+            surfaceArea = attributes.surface_area;
+        }
+        ASSERT_EQ(attributes.surface_area, surfaceArea);
+        ASSERT_NEAR(attributes.surface_area, serialAttributes.surface_area, 1e-12 * surfaceArea);
+
+        mesh.ComputeNormals();
+        ASSERT_TRUE(sameBits(mesh.getVerticeNormals(), serial.getVerticeNormals())) << threads << " threads";
+    }
+
+    // the cached adjacency follows the faces
+    bunny_dataIO::IndexMatrixType halfFaces = faces.topRows(faces.rows() / 2);
+    mesh.setFaces(halfFaces);
+    TriangleMesh half(vertices, halfFaces);
+    half.setDeterministic(true);
+    bunny_dataIO::Point3DMatrixType faceNormals(halfFaces.rows(), 3), verticesNormals(vertices.rows(), 3);
+    mesh.ComputeNormals(faceNormals, verticesNormals);
+    half.ComputeNormals();
+    ASSERT_TRUE(sameBits(verticesNormals, half.getVerticeNormals()));
+}
+
+TEST_F(MeshThreads, ScratchBuffersAreBounded)
+{
+    // a private (num_vertices, 3) buffer per chunk but the first, fewer chunks when the buffers are large
+    parallel::setNumThreads(16);
+    const size_t small = computeMeshNormalsScratchBytes(100000, 1000000);
+    const size_t large = computeMeshNormalsScratchBytes(1000000, 10000000);
+    const size_t huge = computeMeshNormalsScratchBytes(100000000, 100000000);
+    EXPECT_EQ(small, 15u * 100000 * 3 * sizeof(double));
+    EXPECT_LE(large, size_t(128) << 20);
+    EXPECT_EQ(large % (1000000 * 3 * sizeof(double)), 0u);
+    EXPECT_GT(large, 0u);
+    EXPECT_EQ(huge, 0u);
+}
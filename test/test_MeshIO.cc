@@ -0,0 +1,350 @@
+/**
+ * @file test_MeshIO.cc
+ * @brief Unitest module for the bunny_mesh/mesh_io.h file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "gtest/gtest.h"
+
+#include "bunny_mesh/data_io.h"
+#include "bunny_mesh/Mesh.h"
+#include "bunny_mesh/mesh_io.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include <unistd.h>
+
+using namespace bunny_dataIO;
+
+/**
+ * @brief Temporary file path unique to the test process.
+ */
+std::string temporaryPath(const std::string &extension)
+{
+    return "/tmp/bunny_mesh_test." + std::to_string(getpid()) + "." + extension;
+}
+
+/**
+ * @brief Bitwise comparison, so that NaN normals of unreferenced vertices compare equal.
+ */
+template <typename Matrix>
+bool sameBits(const Matrix &a, const Matrix &b)
+{
+    return a.rows() == b.rows() && std::memcmp(a.data(), b.data(), a.size() * sizeof(typename Matrix::Scalar)) == 0;
+}
+
+class MeshIOBunny : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        faces = readIntNumPyArray("data/bunny_faces.npy");
+        vertices = readFloatNumPyArray("data/bunny_vertices.npy");
+        bunny_mesh::TriangleMesh mesh(vertices, faces);
+        mesh.ComputeNormals();
+        vertices_normals = mesh.getVerticeNormals();
+        face_normals = mesh.getFaceNormals();
+    }
+
+    IndexMatrixType faces;
+    Point3DMatrixType vertices;
+    Point3DMatrixType vertices_normals;
+    Point3DMatrixType face_normals;
+};
+
+TEST_F(MeshIOBunny, PLYRoundTrip)
+{
+    const std::string path = temporaryPath("ply");
+    writePLY(path, vertices, faces, vertices_normals);
+    MeshData mesh = readMesh(path);
+    std::remove(path.c_str());
+
+    EXPECT_TRUE(sameBits(mesh.vertices, vertices));
+    EXPECT_TRUE(sameBits(mesh.faces, faces));
+    EXPECT_TRUE(sameBits(mesh.vertices_normals, vertices_normals));
+    EXPECT_EQ(mesh.face_normals.rows(), 0);
+}
+
+TEST_F(MeshIOBunny, OBJRoundTrip)
+{
+    const std::string path = temporaryPath("obj");
+    writeOBJ(path, vertices, faces, vertices_normals);
+    MeshData mesh = readMesh(path);
+    std::remove(path.c_str());
+
+    EXPECT_TRUE(sameBits(mesh.vertices, vertices));
+    EXPECT_TRUE(sameBits(mesh.faces, faces));
+    ASSERT_EQ(mesh.vertices_normals.rows(), vertices_normals.rows());
+    for (int i = 0; i < vertices_normals.rows(); i++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            if (std::isnan(vertices_normals(i, k)))
+            {
+                EXPECT_TRUE(std::isnan(mesh.vertices_normals(i, k)));
+            }
+            else
+            {
+                EXPECT_EQ(mesh.vertices_normals(i, k), vertices_normals(i, k));
+            }
+        }
+    }
+}
+
+TEST_F(MeshIOBunny, STLRoundTripIsWelded)
+{
+    const std::string path = temporaryPath("stl");
+    writeSTL(path, vertices, faces, face_normals);
+    MeshData soup = readSTL(path, false);
+    MeshData mesh = readSTL(path);
+    std::remove(path.c_str());
+
+    ASSERT_EQ(soup.vertices.rows(), 3 * faces.rows());
+    ASSERT_EQ(mesh.faces.rows(), faces.rows());
+    EXPECT_TRUE(mesh.face_normals.isApprox(face_normals, 1e-6));
+
+    // welding restores one vertex per referenced bunny vertex
+    std::vector<bool> referenced(vertices.rows(), false);
+    for (int i = 0; i < faces.size(); i++)
+    {
+        referenced[faces.data()[i]] = true;
+    }
+    EXPECT_EQ(mesh.vertices.rows(), std::count(referenced.begin(), referenced.end(), true));
+    for (int i = 0; i < faces.rows(); i++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            EXPECT_EQ(mesh.vertices.row(mesh.faces(i, k)), vertices.row(faces(i, k)).cast<float>().cast<double>());
+        }
+    }
+}
+
+TEST(MeshIO, OBJStatements)
+{
+    const std::string path = temporaryPath("obj");
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "# comment\r\n"
+             << "mtllib bunny.mtl\n"
+             << "v 0 0 0 # origin\r\n"
+             << "v 1.5e0 0 -0.0\n"
+             << "  v\t1 1 0 1.0\n"
+             << "vt 0.5 0.5\n"
+             << "v 0 1E-1 0.12345678901234567890\n"
+             << "g quad\n"
+             << "f 1/1 2/1/1 3//1 4\n"
+             << "f 1 2 3 # quad half\n"
+             << "f 1 3 4/1/1# other half, # 5 6\r\n"
+             << "f -4 -3 -1\n"
+             << "v 0 0 0#c";
+    }
+    MeshData mesh = readOBJ(path);
+    std::remove(path.c_str());
+
+    ASSERT_EQ(mesh.vertices.rows(), 5);
+    EXPECT_EQ(mesh.vertices(1, 0), 1.5);
+    EXPECT_TRUE(std::signbit(mesh.vertices(1, 2)));
+    EXPECT_EQ(mesh.vertices(3, 1), 0.1);
+    EXPECT_EQ(mesh.vertices(3, 2), 0.12345678901234567890);
+    EXPECT_TRUE(mesh.vertices.row(4).isZero());
+    EXPECT_EQ(mesh.vertices_normals.rows(), 0);
+
+    // trailing comments are not face vertices
+    IndexMatrixType expected(5, 3);
+    expected << 0, 1, 2,
+                0, 2, 3,
+                0, 1, 2,
+                0, 2, 3,
+                0, 1, 3;
+    EXPECT_EQ(mesh.faces, expected);
+}
+
+TEST(MeshIO, OBJNormalIndexes)
+{
+    const std::string path = temporaryPath("obj");
+    auto readText = [&path](const std::string &text) {
+        {
+            std::ofstream file(path, std::ios::binary);
+            file << text;
+        }
+        MeshData mesh = readOBJ(path);
+        std::remove(path.c_str());
+        return mesh;
+    };
+    const std::string vertices = "v 0 0 0\nv 1 0 0\nv 0 1 0\nv 1 1 0\nv 2 2 2\n"
+                                 "vn 0 0 -1\nvn 0 0 1\nvn 1 0 0\nvn 0 1 0\nvn 1 1 1\n";
+
+    // normals follow the face indexes, not the order of the vn statements, the last vertex is in no face
+    MeshData mesh = readText(vertices + "f 1//4 2/1/3 3//2\nf 2//3 4//1 -3//-4\n");
+    Point3DMatrixType expected(4, 3);
+    expected << 0.0, 1.0, 0.0,
+                1.0, 0.0, 0.0,
+                0.0, 0.0, 1.0,
+                0.0, 0.0, -1.0;
+    ASSERT_EQ(mesh.vertices_normals.rows(), 5);
+    EXPECT_EQ(mesh.vertices_normals.topRows(4), expected);
+    EXPECT_TRUE(std::isnan(mesh.vertices_normals(4, 0)));
+
+    // a vertex with a normal per face has no vertex normal, nor do faces without normal indexes
+    EXPECT_EQ(readText(vertices + "f 1//1 2//1 3//1\nf 2//2 4//2 3//2\n").vertices_normals.rows(), 0);
+    EXPECT_EQ(readText(vertices + "f 1 2 3\nf 2 4 3\n").vertices_normals.rows(), 0);
+    EXPECT_THROW(readText(vertices + "f 1//1 2//2 3//6\n"), std::out_of_range);
+}
+
+TEST(MeshIO, PLYPolygonsAndExtraProperties)
+{
+    // big endian file with float vertices, an extra color property and a quad
+    std::string body;
+    auto appendBigEndian = [&body](const void *value, size_t size) {
+        const char *bytes = static_cast<const char *>(value);
+        for (size_t k = 0; k < size; k++)
+        {
+            body += bytes[size - 1 - k];
+        }
+    };
+    const float positions[4][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}};
+    for (int i = 0; i < 4; i++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            appendBigEndian(&positions[i][k], 4);
+        }
+        body += static_cast<char>(255);
+    }
+    body += static_cast<char>(4);
+    for (int index = 0; index < 4; index++)
+    {
+        appendBigEndian(&index, 4);
+    }
+
+    const std::string path = temporaryPath("ply");
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "ply\nformat binary_big_endian 1.0\ncomment test\n"
+             << "element vertex 4\nproperty float x\nproperty float y\nproperty float z\nproperty uchar red\n"
+             << "element face 1\nproperty list uchar int vertex_indices\nend_header\n"
+             << body;
+    }
+    MeshData mesh = readPLY(path);
+    std::remove(path.c_str());
+
+    ASSERT_EQ(mesh.vertices.rows(), 4);
+    EXPECT_EQ(mesh.vertices(2, 0), 1.0);
+    EXPECT_EQ(mesh.vertices(2, 1), 1.0);
+    IndexMatrixType expected(2, 3);
+    expected << 0, 1, 2,
+                0, 2, 3;
+    EXPECT_EQ(mesh.faces, expected);
+}
+
+TEST(MeshIO, InvalidFiles)
+{
+    const std::string path = temporaryPath("obj");
+    {
+        std::ofstream file(path);
+        file << "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 4\n";
+    }
+    EXPECT_THROW(readOBJ(path), std::out_of_range);
+    std::remove(path.c_str());
+
+    EXPECT_THROW(readMesh("data/bunny_faces.npy"), std::invalid_argument);
+    EXPECT_THROW(readPLY("data/missing.ply"), std::runtime_error);
+}
+
+TEST(MeshIO, NumpyArrayWriter)
+{
+    const std::string path = temporaryPath("npy");
+    {
+        NumpyArrayWriter writer(path, NumpyType::Int32, 4, 3);
+        const int last[6] = {6, 7, 8, 9, 10, 11};
+        const int first[6] = {0, 1, 2, 3, 4, 5};
+        writer.writeRows(2, last, 2);
+        writer.writeRows(0, first, 2);
+        const double wrongType[3] = {0, 0, 0};
+        EXPECT_THROW(writer.writeRows(0, wrongType, 1), std::invalid_argument);
+        EXPECT_THROW(writer.writeRows(3, first, 2), std::out_of_range);
+    }
+    IndexMatrixType expected(4, 3);
+    expected << 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11;
+    EXPECT_TRUE(readIntNumPyArray(path) == expected);
+
+    // the data of a numpy file starts on a 64 bytes boundary
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    ASSERT_NE(file, nullptr);
+    unsigned char preamble[10];
+    ASSERT_EQ(std::fread(preamble, 1, 10, file), 10u);
+    std::fclose(file);
+    EXPECT_EQ(std::memcmp(preamble, "\x93NUMPY\x01\x00", 8), 0);
+    EXPECT_EQ((10 + preamble[8] + 256 * preamble[9]) % 64, 0);
+    std::remove(path.c_str());
+}
+
+TEST(MeshIO, NumpyArrayReader)
+{
+    // numpy files written by cnpy are read into the matrices themselves, by blocks in any order
+    const IndexMatrixType faces = readIntNumPyArray("data/bunny_faces.npy");
+    NumpyArrayReader facesReader("data/bunny_faces.npy");
+    ASSERT_EQ(facesReader.type(), NumpyType::Int32);
+    ASSERT_EQ(facesReader.rows(), static_cast<size_t>(faces.rows()));
+    ASSERT_EQ(facesReader.cols(), 3u);
+    IndexMatrixType blocks(faces.rows(), 3);
+    const size_t half = faces.rows() / 2;
+    facesReader.readRows(half, blocks.data() + 3 * half, faces.rows() - half);
+    facesReader.readRows(0, blocks.data(), half);
+    EXPECT_TRUE(blocks == faces);
+    double wrongType[3];
+    EXPECT_THROW(facesReader.readRows(0, wrongType, 1), std::invalid_argument);
+    EXPECT_THROW(facesReader.readRows(faces.rows() - 1, blocks.data(), 2), std::out_of_range);
+
+    const Point3DMatrixType vertices = readFloatNumPyArray("data/bunny_vertices.npy");
+    NumpyArrayReader verticesReader("data/bunny_vertices.npy");
+    ASSERT_EQ(verticesReader.type(), NumpyType::Float64);
+    Point3DMatrixType readVertices(verticesReader.rows(), 3);
+    verticesReader.readRows(0, readVertices.data(), verticesReader.rows());
+    EXPECT_TRUE(readVertices == vertices);
+
+    // single precision arrays round trip through the writer
+    const std::string path = temporaryPath("npy");
+    const float values[6] = {0.5f, -1.0f, 2.25f, 3.0f, 1e-7f, -4.5f};
+    NumpyArrayWriter(path, NumpyType::Float32, 2, 3).writeRows(0, values, 2);
+    NumpyArrayReader floatReader(path);
+    ASSERT_EQ(floatReader.type(), NumpyType::Float32);
+    ASSERT_EQ(floatReader.rows(), 2u);
+    float readValues[6];
+    floatReader.readRows(0, readValues, 2);
+    EXPECT_EQ(std::memcmp(values, readValues, sizeof(values)), 0);
+
+    // three dimensional arrays are read frame after frame
+    {
+        const NumpyArrayWriter frames(path, NumpyType::Float32, 2, 1, 3);
+        ASSERT_EQ(frames.rows(), 2u);
+        frames.writeRows(1, values + 3, 1);
+        frames.writeRows(0, values, 1);
+    }
+    NumpyArrayReader framesReader(path);
+    ASSERT_EQ(framesReader.frames(), 2u);
+    ASSERT_EQ(framesReader.rows(), 2u);
+    ASSERT_EQ(framesReader.cols(), 3u);
+    framesReader.readRows(0, readValues, 2);
+    EXPECT_EQ(std::memcmp(values, readValues, sizeof(values)), 0);
+    EXPECT_EQ(floatReader.frames(), 1u);
+
+    // not numpy files, and truncated ones
+    EXPECT_THROW(NumpyArrayReader("data/missing.npy"), std::runtime_error);
+    std::ofstream(path, std::ios::binary) << "solid not a numpy file";
+    EXPECT_THROW(NumpyArrayReader reader(path), std::invalid_argument);
+    {
+        NumpyArrayWriter writer(path, NumpyType::Float64, 4, 3);
+    }
+    ASSERT_EQ(truncate(path.c_str(), 100), 0);
+    EXPECT_THROW(NumpyArrayReader reader(path), std::invalid_argument);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,223 @@
+/**
+ * @file test_MeshSequence.cc
+ * @brief Unitest module for the bunny_mesh/MeshSequence.h file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "gtest/gtest.h"
+
+#include "bunny_mesh/MeshSequence.h"
+#include "bunny_mesh/Mesh.h"
+#include "bunny_mesh/data_io.h"
+#include "bunny_mesh/mesh_io.h"
+#include "bunny_mesh/parallel.h"
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace bunny_mesh;
+using bunny_dataIO::IndexMatrixType;
+using bunny_dataIO::Point3DMatrixType;
+using bunny_dataIO::Point3DType;
+
+namespace
+{
+std::string outputPath(const std::string &name)
+{
+    return "/tmp/bunny_sequence_test." + std::to_string(getpid()) + "." + name + ".npy";
+}
+
+/**
+ * @brief Vertices of a frame of a made up animation, every vertex moving differently.
+ */
+Point3DMatrixType animatedFrame(const Point3DMatrixType &vertices, size_t frame)
+{
+    return vertices + 0.01 * frame * vertices.array().sin().matrix();
+}
+
+/**
+ * @brief Normals of a frame computed by a new TriangleMesh, on a single thread.
+ */
+FrameNormals meshNormals(const Point3DMatrixType &vertices, const IndexMatrixType &faces,
+                         const Point3DType &orientation)
+{
+    const unsigned threads = parallel::numThreads();
+    parallel::setNumThreads(1);
+    TriangleMesh mesh(vertices, faces);
+    mesh.setOrientation(orientation);
+    mesh.ComputeNormals();
+    parallel::setNumThreads(threads);
+    return FrameNormals{mesh.getFaceNormals(), mesh.getVerticeNormals()};
+}
+
+// NaN normals of unreferenced vertices compare bitwise
+bool sameBits(const Point3DMatrixType &a, const Point3DMatrixType &b)
+{
+    return a.rows() == b.rows() && std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+}
+
+bool sameNormals(const FrameNormals &a, const FrameNormals &b)
+{
+    return sameBits(a.face_normals, b.face_normals) && sameBits(a.vertices_normals, b.vertices_normals);
+}
+
+/**
+ * @brief Run a sequence of animated frames, keeping the normals given to the sink.
+ */
+std::vector<FrameNormals> runFrames(MeshSequence &sequence, const Point3DMatrixType &vertices, size_t numFrames)
+{
+    std::vector<FrameNormals> normals;
+    size_t nextSource = 0;
+    const SequenceStats stats = sequence.run(
+        numFrames,
+        [&](size_t frame, Eigen::Ref<Point3DMatrixType> frameVertices) {
+            EXPECT_EQ(frame, nextSource++);
+            frameVertices = animatedFrame(vertices, frame);
+        },
+        [&](size_t frame, const FrameNormals &frameNormals) {
+            EXPECT_EQ(frame, normals.size());
+            normals.push_back(frameNormals);
+        });
+    EXPECT_EQ(stats.frames, numFrames);
+    EXPECT_EQ(stats.frames_in_flight, sequence.framesInFlight());
+    EXPECT_EQ(nextSource, numFrames);
+    return normals;
+}
+} // namespace
+
+TEST(MeshSequence, FramesMatchANewMeshPerFrame)
+{
+    const IndexMatrixType faces = bunny_dataIO::readIntNumPyArray("data/bunny_faces.npy");
+    const Point3DMatrixType vertices = bunny_dataIO::readFloatNumPyArray("data/bunny_vertices.npy");
+    MeshSequence sequence(faces, vertices.rows());
+    ASSERT_EQ(sequence.numFaces(), static_cast<size_t>(faces.rows()));
+    EXPECT_TRUE(sequence.currentFrame().face_normals.isZero());
+
+    for (const Point3DType &orientation : {Point3DType(0, 0, 1), Point3DType(1, 0, 0)})
+    {
+        sequence.setOrientation(orientation);
+        const FrameNormals *previous = nullptr;
+        FrameNormals previousNormals;
+        for (size_t frame = 0; frame < 4; frame++)
+        {
+            const Point3DMatrixType frameVertices = animatedFrame(vertices, frame);
+            const FrameNormals &normals = sequence.computeFrame(frameVertices);
+            EXPECT_EQ(&normals, &sequence.currentFrame());
+            EXPECT_TRUE(sameNormals(normals, meshNormals(frameVertices, faces, orientation))) << "frame " << frame;
+
+            // the previous frame is kept in the other buffer
+            if (previous)
+            {
+                EXPECT_NE(previous, &normals);
+                EXPECT_TRUE(sameNormals(*previous, previousNormals));
+            }
+            previous = &normals;
+            previousNormals = normals;
+        }
+    }
+    EXPECT_THROW(sequence.computeFrame(vertices.topRows(10)), std::invalid_argument);
+    EXPECT_THROW(MeshSequence(faces, 10), std::out_of_range);
+}
+
+TEST(MeshSequence, RunIsIndependentOfTheThreads)
+{
+    const IndexMatrixType faces = bunny_dataIO::readIntNumPyArray("data/bunny_faces.npy");
+    const Point3DMatrixType vertices = bunny_dataIO::readFloatNumPyArray("data/bunny_vertices.npy");
+
+    // small meshes compute a frame per thread, larger ones each frame on every thread
+    TriangleMesh bunny(vertices, faces);
+    TriangleMesh subdivided = bunny.Subdivide(SubdivisionScheme::Midpoint);
+    const IndexMatrixType largeFaces = subdivided.getFaces();
+    const Point3DMatrixType largeVertices = subdivided.getVertices();
+
+    const size_t numFrames = 7;
+    for (bool large : {false, true})
+    {
+        const IndexMatrixType &meshFaces = large ? largeFaces : faces;
+        const Point3DMatrixType &meshVertices = large ? largeVertices : vertices;
+        MeshSequence sequence(meshFaces, meshVertices.rows());
+        sequence.setOrientation(Point3DType(0, 1, 0));
+        for (unsigned threads : {1u, 3u})
+        {
+            parallel::setNumThreads(threads);
+            EXPECT_EQ(sequence.framesInFlight(), large ? 1u : threads);
+            const std::vector<FrameNormals> normals = runFrames(sequence, meshVertices, numFrames);
+            ASSERT_EQ(normals.size(), numFrames);
+            for (size_t frame = 0; frame < numFrames; frame++)
+            {
+                EXPECT_TRUE(sameNormals(normals[frame], meshNormals(animatedFrame(meshVertices, frame), meshFaces,
+                                                                    sequence.getOrientation())))
+                    << "frame " << frame << ", " << threads << " threads";
+            }
+        }
+        // no frames, and errors of the source
+        EXPECT_TRUE(runFrames(sequence, meshVertices, 0).empty());
+        EXPECT_THROW(sequence.run(
+                         numFrames,
+                         [](size_t frame, Eigen::Ref<Point3DMatrixType>) {
+                             if (frame == 4)
+                             {
+                                 throw std::runtime_error("no frame 4");
+                             }
+                         },
+                         [](size_t, const FrameNormals &) {}),
+                     std::runtime_error);
+    }
+    parallel::setNumThreads(0);
+}
+
+TEST(MeshSequence, SequenceFiles)
+{
+    const IndexMatrixType faces = bunny_dataIO::readIntNumPyArray("data/bunny_faces.npy");
+    const Point3DMatrixType vertices = bunny_dataIO::readFloatNumPyArray("data/bunny_vertices.npy");
+    const size_t numFrames = 5, num_vertices = vertices.rows(), num_faces = faces.rows();
+    const std::string facesPath = outputPath("faces"), framesPath = outputPath("frames");
+    const std::string faceNormalsPath = outputPath("face_normals"), verticesNormalsPath = outputPath("vertex_normals");
+    bunny_dataIO::NumpyArrayWriter(facesPath, bunny_dataIO::NumpyType::Int32, num_faces, 3)
+        .writeRows(0, faces.data(), num_faces);
+    {
+        const bunny_dataIO::NumpyArrayWriter frames(framesPath, bunny_dataIO::NumpyType::Float64, numFrames,
+                                                    num_vertices, 3);
+        for (size_t frame = 0; frame < numFrames; frame++)
+        {
+            const Point3DMatrixType frameVertices = animatedFrame(vertices, frame);
+            frames.writeRows(frame * num_vertices, frameVertices.data(), num_vertices);
+        }
+    }
+
+    const SequenceStats stats = computeSequenceFiles(facesPath, framesPath, faceNormalsPath, verticesNormalsPath);
+    EXPECT_EQ(stats.frames, numFrames);
+    EXPECT_GT(stats.fps(), 0.0);
+
+    const bunny_dataIO::NumpyArrayReader faceNormals(faceNormalsPath), verticesNormals(verticesNormalsPath);
+    ASSERT_EQ(faceNormals.frames(), numFrames);
+    ASSERT_EQ(faceNormals.rows(), numFrames * num_faces);
+    ASSERT_EQ(verticesNormals.frames(), numFrames);
+    ASSERT_EQ(verticesNormals.rows(), numFrames * num_vertices);
+    for (size_t frame = 0; frame < numFrames; frame++)
+    {
+        FrameNormals normals{Point3DMatrixType(num_faces, 3), Point3DMatrixType(num_vertices, 3)};
+        faceNormals.readRows(frame * num_faces, normals.face_normals.data(), num_faces);
+        verticesNormals.readRows(frame * num_vertices, normals.vertices_normals.data(), num_vertices);
+        EXPECT_TRUE(sameNormals(normals, meshNormals(animatedFrame(vertices, frame), faces, Point3DType(0, 0, 1))))
+            << "frame " << frame;
+    }
+
+    // frames must be float64 vertices, faces int32 ones
+    EXPECT_THROW(computeSequenceFiles(framesPath, framesPath, faceNormalsPath, verticesNormalsPath),
+                 std::invalid_argument);
+    EXPECT_THROW(computeSequenceFiles(facesPath, facesPath, faceNormalsPath, verticesNormalsPath),
+                 std::invalid_argument);
+    for (const std::string &path : {facesPath, framesPath, faceNormalsPath, verticesNormalsPath})
+    {
+        std::remove(path.c_str());
+    }
+}
@@ -0,0 +1,135 @@
+/**
+ * @file test_NormalsService.cc
+ * @brief Unitest module for the bunny_mesh/NormalsService.h file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "gtest/gtest.h"
+
+#include "bunny_mesh/data_io.h"
+#include "bunny_mesh/Mesh.h"
+#include "bunny_mesh/NormalsService.h"
+
+#include <Eigen/Dense>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace bunny_mesh;
+
+TEST(NormalsService, ComputeThroughSharedMemory)
+{
+    const std::string socketPath = "/tmp/bunny_mesh_test." + std::to_string(getpid()) + ".sock";
+    const std::string facesPath = "data/bunny_faces.npy";
+    const std::string verticesPath = "data/bunny_vertices.npy";
+    service::NormalsServer server(socketPath);
+    std::thread serverThread([&server]() { server.run(); });
+
+    {
+        service::NormalsClient client(socketPath);
+        service::SharedSegment &segment = client.load(1, facesPath, verticesPath);
+
+        // reference mesh computed in process
+        bunny_dataIO::IndexMatrixType faces = bunny_dataIO::readIntNumPyArray(facesPath);
+        bunny_dataIO::Point3DMatrixType vertices = bunny_dataIO::readFloatNumPyArray(verticesPath);
+        ASSERT_EQ(faces.rows(), static_cast<long>(segment.header().num_faces));
+        ASSERT_EQ(vertices.rows(), static_cast<long>(segment.header().num_vertices));
+        TriangleMesh reference(vertices, faces);
+
+        // default orientation
+        client.compute(1, bunny_dataIO::Point3DType(0, 0, 1));
+        reference.ComputeNormals();
+        ASSERT_TRUE(reference.getFaceNormals().isApprox(segment.faceNormals()));
+
+        // move a block of vertices and change the orientation
+        const int first = 100, count = 500;
+        segment.vertices().middleRows(first, count).array() *= 1.5;
+        bunny_dataIO::Point3DMatrixType moved = vertices;
+        moved.middleRows(first, count).array() *= 1.5;
+        client.compute(1, bunny_dataIO::Point3DType(0, 1, 0), first, count);
+        TriangleMesh movedReference(moved, faces);
+        movedReference.setOrientation(bunny_dataIO::Point3DType(0, 1, 0));
+        movedReference.ComputeNormals();
+        ASSERT_TRUE(movedReference.getFaceNormals().isApprox(segment.faceNormals()));
+
+        // errors are reported without stopping the server
+        ASSERT_THROW(client.compute(2, bunny_dataIO::Point3DType(0, 0, 1)), std::runtime_error);
+
+        client.unload(1);
+        client.shutdown();
+    }
+    serverThread.join();
+}
+
+TEST(NormalsService, MalformedRequestsAndHeaders)
+{
+    const std::string socketPath = "/tmp/bunny_mesh_test." + std::to_string(getpid()) + ".sock";
+    const std::string facesPath = "data/bunny_faces.npy";
+    const std::string verticesPath = "data/bunny_vertices.npy";
+    service::NormalsServer server(socketPath);
+    std::thread serverThread([&server]() { server.run(); });
+
+    {
+        service::NormalsClient client(socketPath);
+        service::SharedSegment &segment = client.load(1, facesPath, verticesPath);
+        const bunny_dataIO::Point3DType orientation(0, 0, 1);
+
+        // an offset whose sum with the count wraps around
+        EXPECT_THROW(client.compute(1, orientation, UINT64_MAX - 10, 100), std::runtime_error);
+        EXPECT_THROW(client.compute(1, orientation, 1, UINT64_MAX), std::runtime_error);
+        EXPECT_THROW(client.compute(1, orientation, segment.header().num_vertices, 1), std::runtime_error);
+
+        // orientations that would make every normal not a number
+        EXPECT_THROW(client.compute(1, bunny_dataIO::Point3DType(0, 0, 0), 0, 0), std::runtime_error);
+        EXPECT_THROW(client.compute(1, bunny_dataIO::Point3DType(0, NAN, 1), 0, 0), std::runtime_error);
+        EXPECT_THROW(client.compute(1, bunny_dataIO::Point3DType(0, INFINITY, 1), 0, 0), std::runtime_error);
+
+        // faces indexing past the vertices are rejected at load
+        bunny_dataIO::IndexMatrixType badFaces = bunny_dataIO::readIntNumPyArray(facesPath);
+        const std::string badFacesPath = "/tmp/bunny_mesh_test." + std::to_string(getpid()) + ".faces.npy";
+        for (int index : {-1, int(segment.header().num_vertices)})
+        {
+            badFaces(7, 1) = index;
+            bunny_dataIO::saveIntMatrixToNumpyArray(badFacesPath, badFaces);
+            EXPECT_THROW(client.load(2, badFacesPath, verticesPath), std::runtime_error);
+        }
+        std::remove(badFacesPath.c_str());
+
+        // a header rewritten by the client after registration is ignored by the server
+        const int fd = shm_open(segment.getName().c_str(), O_RDWR, 0);
+        ASSERT_GE(fd, 0);
+        void *address = mmap(nullptr, sizeof(service::SegmentHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        ASSERT_NE(address, MAP_FAILED);
+        service::SegmentHeader *shared = static_cast<service::SegmentHeader *>(address);
+        shared->num_vertices = UINT64_MAX / 2;
+        shared->face_normals_offset = UINT64_MAX - 64;
+        shared->size = UINT64_MAX;
+        munmap(address, sizeof(service::SegmentHeader));
+
+        segment.vertices().array() *= 2.0;
+        client.compute(1, orientation, 0, segment.header().num_vertices);
+        bunny_dataIO::IndexMatrixType faces = bunny_dataIO::readIntNumPyArray(facesPath);
+        bunny_dataIO::Point3DMatrixType vertices = bunny_dataIO::readFloatNumPyArray(verticesPath);
+        TriangleMesh reference(2.0 * vertices, faces);
+        reference.ComputeNormals();
+        EXPECT_TRUE(reference.getFaceNormals().isApprox(segment.faceNormals()));
+
+        // and a segment opened with it is rejected
+        EXPECT_THROW(service::SharedSegment opened(segment.getName()), std::invalid_argument);
+
+        client.unload(1);
+        client.shutdown();
+    }
+    serverThread.join();
+}
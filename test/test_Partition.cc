@@ -0,0 +1,199 @@
+/**
+ * @file test_Partition.cc
+ * @brief Unitest module for the bunny_mesh/Partition.h file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "gtest/gtest.h"
+
+#include "bunny_mesh/data_io.h"
+#include "bunny_mesh/Mesh.h"
+#include "bunny_mesh/parallel.h"
+#include "bunny_mesh/Partition.h"
+#include "test_helpers.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <pthread.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace bunny_mesh;
+
+namespace
+{
+// Fork after which the child kills itself, 0 for none
+int killedFork = 0;
+int forks = 0;
+
+void countFork() { forks++; }
+
+void killForkedChild()
+{
+    if (forks == killedFork)
+    {
+        raise(SIGKILL);
+    }
+}
+} // namespace
+
+class PartitionBunnies : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a row of touching bunnies, welded by no vertex, so partitions cut through bunnies
+        bunny_test::shiftedBunnies(3, 0.15, vertices, faces);
+
+        parallel::setNumThreads(1);
+        TriangleMesh mesh(vertices, faces);
+        mesh.ComputeNormals();
+        parallel::setNumThreads(0);
+        face_normals = mesh.getFaceNormals();
+        vertices_normals = mesh.getVerticeNormals();
+    }
+
+    bunny_dataIO::Point3DMatrixType vertices;
+    bunny_dataIO::IndexMatrixType faces;
+    bunny_dataIO::Point3DMatrixType face_normals;
+    bunny_dataIO::Point3DMatrixType vertices_normals;
+};
+
+TEST_F(PartitionBunnies, PartitionsCoverTheMesh)
+{
+    const int numPartitions = 4;
+    std::vector<distributed::MeshPartition> partitions = distributed::partitionMesh(vertices, faces, numPartitions);
+    ASSERT_EQ(partitions.size(), static_cast<size_t>(numPartitions));
+
+    std::vector<int> faceCount(faces.rows(), 0);
+    size_t haloSize = 0;
+    for (const distributed::MeshPartition &partition : partitions)
+    {
+        // balanced partitions, with their local faces mapping back to the global ones
+        ASSERT_LE(std::abs(static_cast<int>(partition.global_faces.size()) - faces.rows() / numPartitions), 1);
+        ASSERT_TRUE(std::is_sorted(partition.global_vertices.begin(), partition.global_vertices.end()));
+        for (size_t i = 0; i < partition.global_faces.size(); i++)
+        {
+            faceCount[partition.global_faces[i]]++;
+            for (int k = 0; k < 3; k++)
+            {
+                ASSERT_EQ(partition.global_vertices[partition.faces(i, k)], faces(partition.global_faces[i], k));
+            }
+        }
+        ASSERT_EQ(partition.adjacency.corners.size(), 3 * partition.global_faces.size());
+
+        // both ends of a link list the same global vertices
+        for (const distributed::HaloLink &link : partition.contributions)
+        {
+            ASSERT_LT(link.rank, partition.rank);
+            haloSize += link.vertices.size();
+            const distributed::MeshPartition &owner = partitions[link.rank];
+            auto boundary = std::find_if(owner.boundary.begin(), owner.boundary.end(),
+                                         [&](const distributed::HaloLink &other) { return other.rank == partition.rank; });
+            ASSERT_TRUE(boundary != owner.boundary.end());
+            ASSERT_EQ(boundary->vertices.size(), link.vertices.size());
+            for (size_t k = 0; k < link.vertices.size(); k++)
+            {
+                ASSERT_EQ(partition.global_vertices[link.vertices[k]], owner.global_vertices[boundary->vertices[k]]);
+            }
+        }
+    }
+    ASSERT_TRUE(std::all_of(faceCount.begin(), faceCount.end(), [](int count) { return count == 1; }));
+    // spatially coherent partitions share a small fraction of their vertices
+    ASSERT_GT(haloSize, 0u);
+    ASSERT_LT(haloSize, static_cast<size_t>(vertices.rows() / 10));
+}
+
+TEST_F(PartitionBunnies, FailingRankStopsTheOthers)
+{
+    std::vector<distributed::MeshPartition> partitions = distributed::partitionMesh(vertices, faces, 3);
+    partitions[1].adjacency = VertexFaceAdjacency();
+    bunny_dataIO::Point3DMatrixType faceNormals, verticesNormals;
+    EXPECT_THROW(
+        distributed::computePartitionedNormals(partitions, vertices.rows(), faces.rows(), faceNormals, verticesNormals),
+        std::runtime_error);
+}
+
+TEST_F(PartitionBunnies, KilledRankStopsTheOthers)
+{
+    // the second rank dies at once, as if killed by the out of memory killer, with the others waiting for it
+    ASSERT_EQ(pthread_atfork(countFork, nullptr, killForkedChild), 0);
+    forks = 0;
+    killedFork = 2;
+    std::vector<distributed::MeshPartition> partitions = distributed::partitionMesh(vertices, faces, 3);
+    bunny_dataIO::Point3DMatrixType faceNormals, verticesNormals;
+    try
+    {
+        distributed::computePartitionedNormals(partitions, vertices.rows(), faces.rows(), faceNormals, verticesNormals);
+        ADD_FAILURE() << "expected std::runtime_error";
+    }
+    catch (const std::runtime_error &error)
+    {
+        EXPECT_NE(std::string(error.what()).find("rank 1 killed by signal"), std::string::npos) << error.what();
+    }
+    killedFork = 0;
+}
+
+TEST_F(PartitionBunnies, OtherChildrenAreLeftAlone)
+{
+    // a child of the caller ending while the ranks run keeps its exit status for its owner
+    const pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0)
+    {
+        _exit(42);
+    }
+    std::vector<distributed::MeshPartition> partitions = distributed::partitionMesh(vertices, faces, 3);
+    bunny_dataIO::Point3DMatrixType faceNormals, verticesNormals;
+    distributed::computePartitionedNormals(partitions, vertices.rows(), faces.rows(), faceNormals, verticesNormals);
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 42);
+}
+
+TEST_F(PartitionBunnies, MatchesComputeNormals)
+{
+    for (int numPartitions : {1, 2, 3, 5, 8})
+    {
+        std::vector<distributed::MeshPartition> partitions = distributed::partitionMesh(vertices, faces, numPartitions);
+        bunny_dataIO::Point3DMatrixType faceNormals, verticesNormals;
+        distributed::computePartitionedNormals(partitions, vertices.rows(), faces.rows(), faceNormals, verticesNormals);
+
+        // shared vertices sum their faces in the serial order too, so every normal matches bitwise
+        ASSERT_EQ(std::memcmp(faceNormals.data(), face_normals.data(), face_normals.size() * sizeof(double)), 0)
+            << numPartitions << " partitions";
+        ASSERT_EQ(std::memcmp(verticesNormals.data(), vertices_normals.data(), vertices_normals.size() * sizeof(double)),
+                  0)
+            << numPartitions << " partitions";
+    }
+}
+
+TEST(Partition, InvalidArguments)
+{
+    bunny_dataIO::Point3DMatrixType vertices(3, 3);
+    vertices << 0.0, 0.0, 0.0,
+                1.0, 0.0, 0.0,
+                0.0, 1.0, 0.0;
+    bunny_dataIO::IndexMatrixType faces(1, 3);
+    faces << 0, 1, 3;
+    EXPECT_THROW(distributed::partitionMesh(vertices, faces, 2), std::out_of_range);
+    faces << 0, 1, 2;
+    EXPECT_THROW(distributed::partitionMesh(vertices, faces, 0), std::invalid_argument);
+
+    // more partitions than faces leaves empty ranks, which still take part in the exchanges
+    std::vector<distributed::MeshPartition> partitions = distributed::partitionMesh(vertices, faces, 3);
+    bunny_dataIO::Point3DMatrixType faceNormals, verticesNormals;
+    distributed::computePartitionedNormals(partitions, vertices.rows(), faces.rows(), faceNormals, verticesNormals);
+    EXPECT_TRUE(faceNormals.row(0).isApprox(bunny_dataIO::Point3DType(0.0, 0.0, 1.0)));
+    EXPECT_TRUE(verticesNormals.row(2).isApprox(bunny_dataIO::Point3DType(0.0, 0.0, 1.0)));
+}
@@ -0,0 +1,99 @@
+/**
+ * @file test_SharedMesh.cc
+ * @brief Unitest module for the bunny_mesh/SharedMesh.h file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "gtest/gtest.h"
+
+#include "bunny_mesh/data_io.h"
+#include "bunny_mesh/Mesh.h"
+#include "bunny_mesh/SharedMesh.h"
+
+#include <Eigen/Dense>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace bunny_mesh;
+
+TEST(SharedMesh, VersionedSnapshots)
+{
+    bunny_dataIO::Point3DMatrixType vertices(3, 3);
+    vertices << 0.0, 0.0, 0.0,
+                1.0, 0.0, 0.0,
+                0.0, 1.0, 0.0;
+    bunny_dataIO::IndexMatrixType faces(1, 3);
+    faces << 0, 1, 2;
+    SharedMesh mesh(vertices, faces);
+
+    ASSERT_FALSE(mesh.normals());
+    std::shared_ptr<const NormalsSnapshot> first = mesh.recompute();
+    ASSERT_EQ(0u, first->geometry->version);
+    ASSERT_TRUE(bunny_dataIO::Point3DType(0, 0, 1).isApprox(first->face_normals.row(0)));
+
+    // a new orientation does not change the published normals until recompute
+    ASSERT_EQ(1u, mesh.setOrientation(bunny_dataIO::Point3DType(1, 0, 0)));
+    ASSERT_EQ(first, mesh.normals());
+    std::shared_ptr<const NormalsSnapshot> second = mesh.recompute();
+    ASSERT_EQ(1u, second->geometry->version);
+    // the previous snapshot is left untouched
+    ASSERT_TRUE(bunny_dataIO::Point3DType(0, 0, 1).isApprox(first->face_normals.row(0)));
+
+    // same result as a triangle mesh at the same orientation
+    TriangleMesh reference(vertices, faces);
+    reference.setOrientation(bunny_dataIO::Point3DType(1, 0, 0));
+    reference.ComputeNormals();
+    ASSERT_TRUE(reference.getFaceNormals().isApprox(second->face_normals));
+}
+
+TEST(SharedMesh, ReadersDuringRecompute)
+{
+    bunny_dataIO::IndexMatrixType faces = bunny_dataIO::readIntNumPyArray("data/bunny_faces.npy");
+    bunny_dataIO::Point3DMatrixType vertices = bunny_dataIO::readFloatNumPyArray("data/bunny_vertices.npy");
+    SharedMesh mesh(vertices, faces);
+    mesh.recompute();
+
+    // readers check each snapshot is consistent with its own geometry
+    std::atomic<bool> done(false);
+    std::atomic<int> inconsistent(0);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; r++)
+    {
+        readers.emplace_back([&]() {
+            while (!done.load())
+            {
+                std::shared_ptr<const NormalsSnapshot> normals = mesh.normals();
+                const GeometrySnapshot &geometry = *normals->geometry;
+                bunny_dataIO::Point3DType v0 = geometry.vertices->row((*geometry.faces)(0, 0));
+                bunny_dataIO::Point3DType v1 = geometry.vertices->row((*geometry.faces)(0, 1));
+                bunny_dataIO::Point3DType v2 = geometry.vertices->row((*geometry.faces)(0, 2));
+                bunny_dataIO::Point3DType expected =
+                    ((v1 - v0).cross(v2 - v1) * orientationRotation(geometry.orientation)).normalized();
+                if (!expected.isApprox(normals->face_normals.row(0)))
+                {
+                    inconsistent++;
+                }
+            }
+        });
+    }
+
+    const bunny_dataIO::Point3DType orientations[] = {bunny_dataIO::Point3DType(0, 1, 0),
+                                                      bunny_dataIO::Point3DType(1, 0, 0),
+                                                      bunny_dataIO::Point3DType(0, 0, 1)};
+    for (int i = 0; i < 12; i++)
+    {
+        mesh.setOrientation(orientations[i % 3]);
+        mesh.recompute();
+    }
+    done = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+    ASSERT_EQ(0, inconsistent.load());
+    ASSERT_EQ(12u, mesh.normals()->geometry->version);
+}
@@ -0,0 +1,90 @@
+/**
+ * @file test_SmoothingGroups.cc
+ * @brief Unitest module for the bunny_mesh/SmoothingGroups.h file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "gtest/gtest.h"
+
+#include "bunny_mesh/data_io.h"
+#include "bunny_mesh/Mesh.h"
+#include "bunny_mesh/SmoothingGroups.h"
+
+#include <Eigen/Dense>
+#include <math.h>
+
+using namespace bunny_mesh;
+
+namespace
+{
+/**
+ * @brief Unit cube with counter-clockwise faces seen from outside.
+ */
+TriangleMesh cubeMesh()
+{
+    bunny_dataIO::Point3DMatrixType vertices(8, 3);
+    vertices << 0, 0, 0,
+                1, 0, 0,
+                1, 1, 0,
+                0, 1, 0,
+                0, 0, 1,
+                1, 0, 1,
+                1, 1, 1,
+                0, 1, 1;
+    bunny_dataIO::IndexMatrixType faces(12, 3);
+    faces << 0, 2, 1,  0, 3, 2,  // bottom
+             4, 5, 6,  4, 6, 7,  // top
+             0, 1, 5,  0, 5, 4,  // front
+             2, 3, 7,  2, 7, 6,  // back
+             1, 2, 6,  1, 6, 5,  // right
+             3, 0, 4,  3, 4, 7;  // left
+    return TriangleMesh(vertices, faces);
+}
+} // namespace
+
+TEST(SmoothingGroups, CubeHardEdges)
+{
+    TriangleMesh cube = cubeMesh();
+    cube.ComputeNormals();
+    SmoothingGroups groups = computeSmoothingGroups(cube, M_PI / 6);
+
+    // each cube corner is split in its 3 incident sides
+    ASSERT_EQ(24, groups.split_vertices.rows());
+    ASSERT_EQ(24, groups.split_normals.rows());
+    ASSERT_EQ(36, groups.corner_normals.rows());
+
+    // every corner normal is its face normal
+    bunny_dataIO::Point3DMatrixType faceNormals = cube.getFaceNormals();
+    for (int corner = 0; corner < 36; corner++)
+    {
+        ASSERT_TRUE(faceNormals.row(corner / 3).isApprox(groups.corner_normals.row(corner)));
+        int split = groups.split_faces(corner / 3, corner % 3);
+        ASSERT_EQ(cube.getFaces()(corner / 3, corner % 3), groups.split_source[split]);
+    }
+}
+
+TEST(SmoothingGroups, NoCreaseMatchesVertexNormals)
+{
+    bunny_dataIO::IndexMatrixType faces = bunny_dataIO::readIntNumPyArray("data/bunny_faces.npy");
+    bunny_dataIO::Point3DMatrixType vertices = bunny_dataIO::readFloatNumPyArray("data/bunny_vertices.npy");
+    TriangleMesh mesh(vertices, faces);
+    mesh.ComputeNormals();
+    SmoothingGroups groups = computeSmoothingGroups(mesh, M_PI);
+
+    ASSERT_EQ(vertices.rows(), groups.split_vertices.rows());
+    ASSERT_TRUE(faces == groups.split_faces);
+    // vertices without faces have a not a number vertex normal, and a zero split normal
+    bunny_dataIO::Point3DMatrixType vertexNormals = mesh.getVerticeNormals();
+    for (int v = 0; v < vertices.rows(); v++)
+    {
+        if (vertexNormals.row(v).hasNaN())
+        {
+            ASSERT_TRUE(groups.split_normals.row(v).isZero());
+            continue;
+        }
+        ASSERT_TRUE(vertexNormals.row(v).isApprox(groups.split_normals.row(v)));
+    }
+}
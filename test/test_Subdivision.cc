@@ -0,0 +1,266 @@
+/**
+ * @file test_Subdivision.cc
+ * @brief Unitest module for the bunny_mesh/Subdivision.h file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "gtest/gtest.h"
+
+#include "bunny_mesh/data_io.h"
+#include "bunny_mesh/Mesh.h"
+#include "bunny_mesh/Subdivision.h"
+#include "bunny_mesh/Topology.h"
+#include "bunny_mesh/parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace bunny_mesh;
+using bunny_dataIO::IndexMatrixType;
+using bunny_dataIO::Point3DMatrixType;
+using bunny_dataIO::Point3DType;
+
+namespace
+{
+/**
+ * @brief Faces of the subdivided mesh, on a single thread.
+ */
+IndexMatrixType subdividedFaces(const IndexMatrixType &faces, const EdgeTable &edges, size_t num_vertices)
+{
+    IndexMatrixType subdivided(4 * faces.rows(), 3);
+    subdivideFaces(faces, edges, num_vertices, 0, subdivided.rows(), subdivided.data());
+    return subdivided;
+}
+
+/**
+ * @brief Faces around each edge, by edge ends, whatever the edge numbering.
+ */
+std::map<std::pair<int, int>, std::vector<int>> edgeFaces(const EdgeTable &edges)
+{
+    std::map<std::pair<int, int>, std::vector<int>> byEnds;
+    for (size_t e = 0; e < edges.size(); e++)
+    {
+        byEnds[std::make_pair(edges.ends(e, 0), edges.ends(e, 1))] =
+            std::vector<int>(edges.faces.begin() + edges.offsets[e], edges.faces.begin() + edges.offsets[e + 1]);
+    }
+    return byEnds;
+}
+
+void expectSameEdgeTable(const EdgeTable &edges, const EdgeTable &other)
+{
+    ASSERT_TRUE(edges.ends == other.ends);
+    ASSERT_TRUE(edges.face_edges == other.face_edges);
+    ASSERT_TRUE(edges.offsets == other.offsets);
+    ASSERT_TRUE(edges.faces == other.faces);
+}
+
+/**
+ * @brief Faces without the faces over the same vertices as a previous one.
+ */
+IndexMatrixType withoutRepeatedFaces(const IndexMatrixType &faces)
+{
+    std::set<std::vector<int>> seen;
+    std::vector<Eigen::Index> kept;
+    for (Eigen::Index f = 0; f < faces.rows(); f++)
+    {
+        std::vector<int> corners(faces.row(f).data(), faces.row(f).data() + 3);
+        std::sort(corners.begin(), corners.end());
+        if (seen.insert(corners).second)
+        {
+            kept.push_back(f);
+        }
+    }
+    IndexMatrixType unique(kept.size(), 3);
+    for (size_t i = 0; i < kept.size(); i++)
+    {
+        unique.row(i) = faces.row(kept[i]);
+    }
+    return unique;
+}
+
+// NaN normals of unreferenced vertices compare bitwise
+bool sameBits(const Point3DMatrixType &a, const Point3DMatrixType &b)
+{
+    return a.rows() == b.rows() && std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+}
+} // namespace
+
+TEST(Subdivision, EdgeTable)
+{
+    // two faces sharing the edge (1, 2), and a third one on the edge (2, 3) only
+    IndexMatrixType faces(3, 3);
+    faces << 0, 1, 2, 2, 1, 3, 3, 4, 2;
+    const EdgeTable edges = buildEdgeTable(faces, 5);
+    ASSERT_EQ(edges.size(), 7u);
+    for (Eigen::Index f = 0; f < faces.rows(); f++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            const int e = edges.face_edges(f, k);
+            const int a = faces(f, k), b = faces(f, (k + 1) % 3);
+            EXPECT_EQ(edges.ends(e, 0), std::min(a, b));
+            EXPECT_EQ(edges.ends(e, 1), std::max(a, b));
+        }
+    }
+    const int shared = edges.face_edges(0, 1);
+    ASSERT_EQ(edges.valence(shared), 2);
+    EXPECT_EQ(edges.faces[edges.offsets[shared]], 0);
+    EXPECT_EQ(edges.faces[edges.offsets[shared] + 1], 1);
+    EXPECT_EQ(edges.valence(edges.face_edges(0, 0)), 1);
+
+    // numbered by first corner, whatever the number of threads
+    const IndexMatrixType bunnyFaces = bunny_dataIO::readIntNumPyArray("data/bunny_faces.npy");
+    parallel::setNumThreads(1);
+    const EdgeTable serial = buildEdgeTable(bunnyFaces, bunnyFaces.maxCoeff() + 1);
+    for (unsigned threads : {2u, 3u, 8u})
+    {
+        parallel::setNumThreads(threads);
+        expectSameEdgeTable(buildEdgeTable(bunnyFaces, bunnyFaces.maxCoeff() + 1), serial);
+    }
+    parallel::setNumThreads(0);
+
+    IndexMatrixType repeated(1, 3);
+    repeated << 0, 1, 1;
+    EXPECT_THROW(buildEdgeTable(repeated, 2), std::invalid_argument);
+    EXPECT_THROW(buildEdgeTable(faces, 4), std::out_of_range);
+}
+
+TEST(Subdivision, EmptyFaces)
+{
+    // vertices referenced by no face
+    const IndexMatrixType faces(0, 3);
+    const VertexFaceAdjacency adjacency = buildVertexFaceAdjacency(faces, 5);
+    ASSERT_EQ(adjacency.offsets.size(), 6u);
+    for (int offset : adjacency.offsets)
+    {
+        EXPECT_EQ(offset, 0);
+    }
+    EXPECT_TRUE(adjacency.corners.empty());
+    EXPECT_EQ(buildEdgeTable(faces, 5).size(), 0u);
+}
+
+TEST(Subdivision, DerivedTopologyMatchesTheSubdividedFaces)
+{
+    // the bunny repeats a few faces over the same vertices, whose center edges are shared
+    const IndexMatrixType bunnyFaces = bunny_dataIO::readIntNumPyArray("data/bunny_faces.npy");
+    const size_t bunnyVertices = bunnyFaces.maxCoeff() + 1;
+
+    IndexMatrixType faces = bunnyFaces;
+    size_t num_vertices = bunnyVertices;
+    EdgeTable edges = buildEdgeTable(faces, num_vertices);
+    VertexFaceAdjacency adjacency = buildVertexFaceAdjacency(faces, num_vertices);
+    for (int level = 0; level < 2; level++)
+    {
+        const IndexMatrixType finerFaces = subdividedFaces(faces, edges, num_vertices);
+        const size_t finerVertices = num_vertices + edges.size();
+        const EdgeTable finerEdges = subdivideEdgeTable(faces, edges, num_vertices);
+        const VertexFaceAdjacency finerAdjacency = subdivideVertexFaceAdjacency(faces, edges, adjacency);
+
+        const VertexFaceAdjacency built = buildVertexFaceAdjacency(finerFaces, finerVertices);
+        ASSERT_TRUE(finerAdjacency.offsets == built.offsets);
+        ASSERT_TRUE(finerAdjacency.corners == built.corners);
+
+        // the same edges and faces around them, numbered differently
+        const EdgeTable hashed = buildEdgeTable(finerFaces, finerVertices);
+        ASSERT_EQ(finerEdges.size(), hashed.size());
+        ASSERT_TRUE(edgeFaces(finerEdges) == edgeFaces(hashed));
+        for (Eigen::Index f = 0; f < finerFaces.rows(); f++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                const int e = finerEdges.face_edges(f, k);
+                const int a = finerFaces(f, k), b = finerFaces(f, (k + 1) % 3);
+                ASSERT_EQ(finerEdges.ends(e, 0), std::min(a, b));
+                ASSERT_EQ(finerEdges.ends(e, 1), std::max(a, b));
+            }
+        }
+
+        faces = finerFaces;
+        num_vertices = finerVertices;
+        edges = finerEdges;
+        adjacency = finerAdjacency;
+    }
+    EXPECT_THROW(subdivideEdgeTable(faces.topRows(10), edges, num_vertices), std::invalid_argument);
+}
+
+TEST(Subdivision, MidpointNormalsArePropagated)
+{
+    // faces repeated the other way round cancel out, leaving rounding noise for the normal of their vertices
+    const IndexMatrixType faces = withoutRepeatedFaces(bunny_dataIO::readIntNumPyArray("data/bunny_faces.npy"));
+    const Point3DMatrixType vertices = bunny_dataIO::readFloatNumPyArray("data/bunny_vertices.npy");
+    TriangleMesh mesh(vertices, faces);
+    mesh.setOrientation(Point3DType(0, 1, 0));
+    TriangleMesh subdivided = mesh.Subdivide(SubdivisionScheme::Midpoint, 2);
+    ASSERT_EQ(subdivided.getFaces().rows(), 16 * faces.rows());
+    EXPECT_TRUE(subdivided.getOrientation() == mesh.getOrientation());
+
+    // the surface does not move: parent vertices stay, each face normal is the one of its ancestor
+    const Point3DMatrixType subdividedVertices = subdivided.getVertices();
+    EXPECT_TRUE(subdividedVertices.topRows(vertices.rows()) == vertices);
+    const Point3DMatrixType faceNormals = mesh.getFaceNormals(), subdividedFaceNormals = subdivided.getFaceNormals();
+    for (Eigen::Index f = 0; f < subdividedFaceNormals.rows(); f++)
+    {
+        ASSERT_TRUE(sameBits(subdividedFaceNormals.row(f), faceNormals.row(f / 16)));
+    }
+
+    // and vertices normals match a computation on the subdivided mesh
+    TriangleMesh recomputed(subdividedVertices, subdivided.getFaces());
+    recomputed.setOrientation(mesh.getOrientation());
+    recomputed.ComputeNormals();
+    const Point3DMatrixType expected = recomputed.getVerticeNormals(), normals = subdivided.getVerticeNormals();
+    ASSERT_EQ(normals.rows(), expected.rows());
+    for (Eigen::Index v = 0; v < normals.rows(); v++)
+    {
+        if (expected.row(v).allFinite())
+        {
+            ASSERT_LT((normals.row(v) - expected.row(v)).norm(), 1e-9) << "vertex " << v;
+        }
+    }
+}
+
+TEST(Subdivision, LoopNormalsMatchARecomputation)
+{
+    const IndexMatrixType faces = bunny_dataIO::readIntNumPyArray("data/bunny_faces.npy");
+    const Point3DMatrixType vertices = bunny_dataIO::readFloatNumPyArray("data/bunny_vertices.npy");
+    for (bool rotated : {false, true})
+    {
+        TriangleMesh mesh(vertices, faces);
+        if (rotated)
+        {
+            mesh.setOrientation(Point3DType(1, 0, 0));
+        }
+        parallel::setNumThreads(3);
+        TriangleMesh subdivided = mesh.Subdivide(SubdivisionScheme::Loop, 2);
+        ASSERT_EQ(subdivided.getFaces().rows(), 16 * faces.rows());
+        EXPECT_TRUE(subdivided.getVertices().allFinite());
+
+        // the serial computation on the subdivided mesh, bitwise
+        parallel::setNumThreads(1);
+        TriangleMesh recomputed(subdivided.getVertices(), subdivided.getFaces());
+        recomputed.setOrientation(mesh.getOrientation());
+        recomputed.ComputeNormals();
+        EXPECT_TRUE(sameBits(subdivided.getFaceNormals(), recomputed.getFaceNormals()));
+        EXPECT_TRUE(sameBits(subdivided.getVerticeNormals(), recomputed.getVerticeNormals()));
+    }
+    parallel::setNumThreads(0);
+
+    // levels at once subdivide the subdivided mesh
+    TriangleMesh mesh(vertices, faces);
+    TriangleMesh once = mesh.Subdivide(SubdivisionScheme::Loop);
+    TriangleMesh twice = mesh.Subdivide(SubdivisionScheme::Loop, 2);
+    TriangleMesh onceTwice = once.Subdivide(SubdivisionScheme::Loop);
+    EXPECT_TRUE(sameBits(twice.getVertices(), onceTwice.getVertices()));
+    EXPECT_TRUE(twice.getFaces() == onceTwice.getFaces());
+    EXPECT_TRUE(sameBits(twice.getVerticeNormals(), onceTwice.getVerticeNormals()));
+
+    EXPECT_THROW(mesh.Subdivide(SubdivisionScheme::Loop, 0), std::invalid_argument);
+}
@@ -0,0 +1,190 @@
+/**
+ * @file test_VertexGeometry.cc
+ * @brief Unitest module for the bunny_mesh/VertexGeometry.h file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "gtest/gtest.h"
+
+#include "bunny_mesh/data_io.h"
+#include "bunny_mesh/Mesh.h"
+#include "bunny_mesh/VertexGeometry.h"
+
+#include <Eigen/Dense>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+using namespace bunny_mesh;
+
+namespace
+{
+/**
+ * @brief Sphere of a given radius, from an octahedron whose faces are subdivided and projected on the sphere.
+ */
+void subdividedSphere(double radius, int levels, bunny_dataIO::Point3DMatrixType &vertices,
+                      bunny_dataIO::IndexMatrixType &faces)
+{
+    std::vector<bunny_dataIO::Point3DType> points = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+    std::vector<bunny_dataIO::Index3DType> triangles = {{0, 2, 4}, {2, 1, 4}, {1, 3, 4}, {3, 0, 4},
+                                                         {2, 0, 5}, {1, 2, 5}, {3, 1, 5}, {0, 3, 5}};
+    for (int level = 0; level < levels; level++)
+    {
+        std::map<std::pair<int, int>, int> midpoints;
+        auto midpoint = [&](int a, int b) {
+            std::pair<int, int> edge(std::min(a, b), std::max(a, b));
+            auto found = midpoints.find(edge);
+            if (found != midpoints.end())
+            {
+                return found->second;
+            }
+            points.push_back((0.5 * (points[a] + points[b])).normalized());
+            midpoints[edge] = static_cast<int>(points.size()) - 1;
+            return static_cast<int>(points.size()) - 1;
+        };
+        std::vector<bunny_dataIO::Index3DType> subdivided;
+        for (const bunny_dataIO::Index3DType &t : triangles)
+        {
+            int ab = midpoint(t(0), t(1)), bc = midpoint(t(1), t(2)), ca = midpoint(t(2), t(0));
+            subdivided.push_back(bunny_dataIO::Index3DType(t(0), ab, ca));
+            subdivided.push_back(bunny_dataIO::Index3DType(ab, t(1), bc));
+            subdivided.push_back(bunny_dataIO::Index3DType(ca, bc, t(2)));
+            subdivided.push_back(bunny_dataIO::Index3DType(ab, bc, ca));
+        }
+        triangles.swap(subdivided);
+    }
+    vertices.resize(points.size(), 3);
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        vertices.row(i) = radius * points[i].normalized();
+    }
+    faces.resize(triangles.size(), 3);
+    for (size_t i = 0; i < triangles.size(); i++)
+    {
+        faces.row(i) = triangles[i];
+    }
+}
+} // namespace
+
+TEST(VertexGeometry, SphereCurvatures)
+{
+    const double radius = 2.0;
+    bunny_dataIO::Point3DMatrixType vertices;
+    bunny_dataIO::IndexMatrixType faces;
+    subdividedSphere(radius, 5, vertices, faces);
+
+    TriangleMesh sphere(vertices, faces);
+    FaceAttributes attributes;
+    sphere.ComputeNormals<SurfaceArea>(attributes);
+    VertexGeometry geometry = computeVertexGeometry(sphere);
+
+    ASSERT_TRUE(geometry.face_normals.isApprox(sphere.getFaceNormals()));
+    ASSERT_TRUE(geometry.vertices_normals.isApprox(sphere.getVerticeNormals()));
+
+    // Gauss-Bonnet holds exactly for the angle defect of a closed surface
+    double totalCurvature = geometry.gaussian_curvature.cwiseProduct(geometry.vertex_areas).sum();
+    ASSERT_NEAR(totalCurvature, 4.0 * M_PI, 1e-9);
+    // mixed areas partition the surface
+    ASSERT_NEAR(geometry.vertex_areas.sum(), attributes.surface_area, 1e-9);
+    for (int v = 0; v < vertices.rows(); v++)
+    {
+        ASSERT_NEAR(geometry.mean_curvature(v), 1.0 / radius, 2e-2);
+        ASSERT_NEAR(geometry.gaussian_curvature(v), 1.0 / (radius * radius), 2e-2);
+    }
+}
+
+TEST(VertexGeometry, FlatGridAndFrames)
+{
+    // 5 x 5 grid on the z = 1 plane, with its diagonals alternating
+    const int size = 5;
+    bunny_dataIO::Point3DMatrixType vertices(size * size, 3);
+    for (int y = 0; y < size; y++)
+    {
+        for (int x = 0; x < size; x++)
+        {
+            vertices.row(y * size + x) << 0.5 * x, 0.3 * y + 0.05 * x, 1.0;
+        }
+    }
+    bunny_dataIO::IndexMatrixType faces(2 * (size - 1) * (size - 1), 3);
+    int face = 0;
+    for (int y = 0; y + 1 < size; y++)
+    {
+        for (int x = 0; x + 1 < size; x++)
+        {
+            int a = y * size + x, b = a + 1, c = a + size, d = c + 1;
+            if ((x + y) % 2 == 0)
+            {
+                faces.row(face++) << a, b, d;
+                faces.row(face++) << a, d, c;
+            }
+            else
+            {
+                faces.row(face++) << a, b, c;
+                faces.row(face++) << b, d, c;
+            }
+        }
+    }
+
+    VertexGeometry geometry;
+    computeVertexGeometry(vertices, faces, geometry);
+    for (int y = 1; y + 1 < size; y++)
+    {
+        for (int x = 1; x + 1 < size; x++)
+        {
+            int v = y * size + x;
+            ASSERT_NEAR(geometry.mean_curvature(v), 0.0, 1e-12);
+            ASSERT_NEAR(geometry.gaussian_curvature(v), 0.0, 1e-12);
+        }
+    }
+    // interior areas tile the plane: the total area is shared by all vertices
+    ASSERT_NEAR(geometry.vertex_areas.sum(), 0.5 * (size - 1) * 0.3 * (size - 1), 1e-12);
+
+    for (int v = 0; v < vertices.rows(); v++)
+    {
+        bunny_dataIO::Point3DType normal = geometry.vertices_normals.row(v);
+        bunny_dataIO::Point3DType tangent = geometry.tangents.row(v);
+        bunny_dataIO::Point3DType bitangent = geometry.bitangents.row(v);
+        ASSERT_NEAR(tangent.norm(), 1.0, 1e-12);
+        ASSERT_NEAR(bitangent.norm(), 1.0, 1e-12);
+        ASSERT_NEAR(tangent.dot(normal), 0.0, 1e-12);
+        ASSERT_TRUE(tangent.cross(bitangent).isApprox(normal));
+    }
+}
+
+TEST(VertexGeometry, BunnyFramesAreOrthonormal)
+{
+    bunny_dataIO::IndexMatrixType faces = bunny_dataIO::readIntNumPyArray("data/bunny_faces.npy");
+    bunny_dataIO::Point3DMatrixType vertices = bunny_dataIO::readFloatNumPyArray("data/bunny_vertices.npy");
+    TriangleMesh mesh(vertices, faces);
+    mesh.setOrientation(bunny_dataIO::Point3DType(0, 1, 1));
+    mesh.ComputeNormals();
+    VertexGeometry geometry = computeVertexGeometry(mesh);
+
+    ASSERT_TRUE(geometry.face_normals.isApprox(mesh.getFaceNormals()));
+    for (int v = 0; v < vertices.rows(); v++)
+    {
+        bunny_dataIO::Point3DType normal = mesh.getVerticeNormals().row(v);
+        if (geometry.vertex_areas(v) == 0.0)
+        {
+            // unreferenced vertices
+            ASSERT_TRUE(std::isnan(geometry.mean_curvature(v)));
+            ASSERT_TRUE(std::isnan(geometry.gaussian_curvature(v)));
+        }
+        if (std::isnan(normal(0)))
+        {
+            // unreferenced vertices, and a few vertices whose faces normals cancel out
+            ASSERT_TRUE(std::isnan(geometry.vertices_normals(v, 0)));
+            continue;
+        }
+        ASSERT_TRUE(normal.isApprox(geometry.vertices_normals.row(v), 1e-9));
+        bunny_dataIO::Point3DType tangent = geometry.tangents.row(v);
+        bunny_dataIO::Point3DType bitangent = geometry.bitangents.row(v);
+        ASSERT_NEAR(tangent.dot(normal), 0.0, 1e-9);
+        ASSERT_NEAR(bitangent.dot(tangent), 0.0, 1e-9);
+        ASSERT_TRUE(tangent.cross(bitangent).isApprox(geometry.vertices_normals.row(v), 1e-9));
+    }
+}
@@ -0,0 +1,136 @@
+/**
+ * @file test_Visibility.cc
+ * @brief Unitest module for the bunny_mesh/Visibility.h file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "gtest/gtest.h"
+
+#include "bunny_mesh/Visibility.h"
+#include "bunny_mesh/Mesh.h"
+#include "bunny_mesh/data_io.h"
+#include "bunny_mesh/parallel.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace bunny_mesh;
+using bunny_dataIO::IndexMatrixType;
+using bunny_dataIO::Point3DMatrixType;
+
+namespace
+{
+/**
+ * @brief View directions spread over the sphere, with the axes first.
+ */
+Point3DMatrixType viewDirections(size_t num_views)
+{
+    Point3DMatrixType directions(num_views, 3);
+    for (size_t view = 0; view < num_views; view++)
+    {
+        const double z = 1.0 - 2.0 * (view + 0.5) / num_views;
+        const double angle = 2.39996322972865332 * view;
+        directions.row(view) << std::sqrt(1.0 - z * z) * std::cos(angle), std::sqrt(1.0 - z * z) * std::sin(angle), z;
+    }
+    directions.topRows(std::min<size_t>(num_views, 3)) =
+        -Point3DMatrixType::Identity(3, 3).topRows(std::min<size_t>(num_views, 3));
+    return directions;
+}
+
+/**
+ * @brief The per face, per view loop the kernel replaces.
+ */
+void expectSameMasks(const VisibilityMasks &masks, const Point3DMatrixType &faceNormals,
+                     const Point3DMatrixType &directions)
+{
+    ASSERT_EQ(masks.num_faces, static_cast<size_t>(faceNormals.rows()));
+    ASSERT_EQ(masks.num_views, static_cast<size_t>(directions.rows()));
+    ASSERT_EQ(masks.words.size(), masks.num_views * ((masks.num_faces + 63) / 64));
+    for (Eigen::Index view = 0; view < directions.rows(); view++)
+    {
+        size_t front = 0;
+        for (Eigen::Index face = 0; face < faceNormals.rows(); face++)
+        {
+            const double dot = faceNormals(face, 0) * directions(view, 0) + faceNormals(face, 1) * directions(view, 1) +
+                               faceNormals(face, 2) * directions(view, 2);
+            ASSERT_EQ(masks.isFrontFacing(view, face), dot < 0.0) << "view " << view << ", face " << face;
+            front += dot < 0.0;
+        }
+        EXPECT_EQ(masks.count(view), front);
+        // bits past the last face
+        if (masks.num_faces % 64)
+        {
+            EXPECT_EQ(masks.view(view)[masks.words_per_view - 1] >> (masks.num_faces % 64), 0u);
+        }
+    }
+}
+} // namespace
+
+TEST(Visibility, MatchesThePerFaceLoop)
+{
+    const IndexMatrixType faces = bunny_dataIO::readIntNumPyArray("data/bunny_faces.npy");
+    const Point3DMatrixType vertices = bunny_dataIO::readFloatNumPyArray("data/bunny_vertices.npy");
+    TriangleMesh mesh(vertices, faces);
+    mesh.ComputeNormals();
+    const Point3DMatrixType faceNormals = mesh.getFaceNormals();
+
+    VisibilityMasks masks;
+    for (size_t num_views : {1u, 13u})
+    {
+        const Point3DMatrixType directions = viewDirections(num_views);
+        for (unsigned threads : {1u, 3u})
+        {
+            parallel::setNumThreads(threads);
+            classifyFrontFaces(faceNormals, directions, masks);
+            expectSameMasks(masks, faceNormals, directions);
+        }
+    }
+    parallel::setNumThreads(0);
+
+    // opposite views split the faces seen from the side
+    const Point3DMatrixType directions = viewDirections(2);
+    Point3DMatrixType opposite(2, 3);
+    opposite << directions.row(1), -directions.row(1);
+    masks = classifyFrontFaces(mesh, opposite);
+    for (size_t w = 0; w < masks.words_per_view; w++)
+    {
+        EXPECT_EQ(masks.view(0)[w] & masks.view(1)[w], 0u);
+    }
+
+    // the mesh overload needs up to date normals
+    TriangleMesh stale(vertices, faces);
+    EXPECT_THROW(classifyFrontFaces(stale, opposite), std::invalid_argument);
+    stale.ComputeNormals();
+    EXPECT_EQ(classifyFrontFaces(stale, opposite).words, masks.words);
+    stale.setOrientation(bunny_dataIO::Point3DType(1, 0, 0));
+    EXPECT_THROW(classifyFrontFaces(stale, opposite), std::invalid_argument);
+
+    // larger meshes, split in blocks and chunks of faces
+    TriangleMesh subdivided = mesh.Subdivide(SubdivisionScheme::Midpoint, 2);
+    parallel::setNumThreads(3);
+    classifyFrontFaces(subdivided.getFaceNormals(), viewDirections(5), masks);
+    parallel::setNumThreads(0);
+    expectSameMasks(masks, subdivided.getFaceNormals(), viewDirections(5));
+}
+
+TEST(Visibility, EdgeOnAndDegenerateFaces)
+{
+    // seen edge on, with a negative zero dot product, and without a normal
+    Point3DMatrixType faceNormals(5, 3);
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    faceNormals << 0, 0, -1, 0, 0, 1, 1, 0, 0, -0.0, 0, 0, nan, nan, nan;
+    Point3DMatrixType direction(1, 3);
+    direction << 0, 0, 1;
+    VisibilityMasks masks;
+    classifyFrontFaces(faceNormals, direction, masks);
+    ASSERT_EQ(masks.words_per_view, 1u);
+    EXPECT_EQ(masks.view(0)[0], 1u);
+
+    classifyFrontFaces(Point3DMatrixType(0, 3), direction, masks);
+    EXPECT_EQ(masks.words_per_view, 0u);
+    EXPECT_TRUE(masks.words.empty());
+}
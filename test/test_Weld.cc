@@ -0,0 +1,129 @@
+/**
+ * @file test_Weld.cc
+ * @brief Unitest module for the bunny_mesh/Weld.h file.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#include "gtest/gtest.h"
+
+#include "bunny_mesh/data_io.h"
+#include "bunny_mesh/Mesh.h"
+#include "bunny_mesh/Weld.h"
+
+#include <Eigen/Dense>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace bunny_mesh;
+
+namespace
+{
+/**
+ * @brief Splits a mesh into a triangle soup, each face having its own copy of its vertices.
+ */
+void triangleSoup(const bunny_dataIO::Point3DMatrixType &vertices, const bunny_dataIO::IndexMatrixType &faces,
+                  double jitter, bunny_dataIO::Point3DMatrixType &soupVertices, bunny_dataIO::IndexMatrixType &soupFaces)
+{
+    soupVertices.resize(3 * faces.rows(), 3);
+    soupFaces.resize(faces.rows(), 3);
+    for (int i = 0; i < faces.rows(); i++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            soupVertices.row(3 * i + k) = vertices.row(faces(i, k)) + jitter * Eigen::RowVector3d::Random();
+            soupFaces(i, k) = 3 * i + k;
+        }
+    }
+}
+} // namespace
+
+TEST(Weld, ExactDuplicates)
+{
+    bunny_dataIO::Point3DMatrixType vertices(6, 3);
+    vertices << 0.0, 0.0, 0.0,
+                1.0, 0.0, 0.0,
+                0.0, 1.0, 0.0,
+                1.0, 0.0, 0.0,  // duplicate of 1
+                -0.0, 0.0, 0.0, // duplicate of 0
+                1.0, 1.0, 0.0;
+    bunny_dataIO::IndexMatrixType faces(2, 3);
+    faces << 0, 1, 2,
+             3, 5, 2;
+    WeldResult weld = weldVertices(vertices, faces);
+
+    ASSERT_EQ(4, weld.vertices.rows());
+    std::vector<int> expectedRemap = {0, 1, 2, 1, 0, 3};
+    ASSERT_EQ(expectedRemap, weld.remap);
+    bunny_dataIO::IndexMatrixType expectedFaces(2, 3);
+    expectedFaces << 0, 1, 2,
+                     1, 3, 2;
+    ASSERT_TRUE(expectedFaces == weld.faces);
+}
+
+TEST(Weld, BunnySoupRestoresVertexNormals)
+{
+    bunny_dataIO::IndexMatrixType faces = bunny_dataIO::readIntNumPyArray("data/bunny_faces.npy");
+    bunny_dataIO::Point3DMatrixType vertices = bunny_dataIO::readFloatNumPyArray("data/bunny_vertices.npy");
+    TriangleMesh mesh(vertices, faces);
+    mesh.ComputeNormals();
+
+    // exact copies of the vertices are merged back
+    bunny_dataIO::Point3DMatrixType soupVertices;
+    bunny_dataIO::IndexMatrixType soupFaces;
+    triangleSoup(vertices, faces, 0.0, soupVertices, soupFaces);
+    WeldResult weld = weldVertices(soupVertices, soupFaces);
+
+    // slightly moved copies are merged back within the tolerance
+    std::srand(3);
+    bunny_dataIO::Point3DMatrixType jitteredVertices;
+    triangleSoup(vertices, faces, 1e-12, jitteredVertices, soupFaces);
+    WeldResult jitteredWeld = weldVertices(jitteredVertices, soupFaces, 1e-9);
+    ASSERT_EQ(weld.vertices.rows(), jitteredWeld.vertices.rows());
+    ASSERT_TRUE(weld.faces == jitteredWeld.faces);
+
+    TriangleMesh welded(weld.vertices, weld.faces);
+    welded.ComputeNormals();
+    bunny_dataIO::Point3DMatrixType expected = mesh.getVerticeNormals();
+    bunny_dataIO::Point3DMatrixType actual = welded.getVerticeNormals();
+    // faces are welded back in the same order, so normals are summed in the same order
+    for (int i = 0; i < faces.rows(); i++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            bunny_dataIO::Point3DType expectedNormal = expected.row(faces(i, k));
+            bunny_dataIO::Point3DType actualNormal = actual.row(weld.faces(i, k));
+            ASSERT_TRUE(expectedNormal == actualNormal || (expectedNormal.hasNaN() && actualNormal.hasNaN()));
+        }
+    }
+}
+
+TEST(Weld, NonFiniteAndFarCoordinates)
+{
+    // far points share the border cells without merging, close ones still merge
+    bunny_dataIO::Point3DMatrixType vertices(5, 3);
+    vertices << 1e300, 0.0, 0.0,
+                -1e300, 0.0, 0.0,
+                1e300, 1e299, 0.0,
+                1e300, 0.0, 0.0,
+                0.0, 0.0, 0.0;
+    bunny_dataIO::IndexMatrixType faces(1, 3);
+    faces << 0, 1, 4;
+    WeldResult weld = weldVertices(vertices, faces, 1e-6);
+    std::vector<int> expectedRemap = {0, 1, 2, 0, 3};
+    ASSERT_EQ(expectedRemap, weld.remap);
+
+    // positions without a cell, and tolerances without a cell size
+    vertices(2, 1) = std::numeric_limits<double>::infinity();
+    EXPECT_THROW(weldVertices(vertices, faces, 1e-6), std::invalid_argument);
+    vertices(2, 1) = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_THROW(weldVertices(vertices, faces, 1e-6), std::invalid_argument);
+    EXPECT_THROW(weldVertices(vertices.topRows(2), faces.topRows(0), std::numeric_limits<double>::quiet_NaN()),
+                 std::invalid_argument);
+    EXPECT_THROW(weldVertices(vertices.topRows(2), faces.topRows(0), std::numeric_limits<double>::denorm_min()),
+                 std::invalid_argument);
+    EXPECT_EQ(weldVertices(vertices, faces).vertices.rows(), 4);
+}
@@ -0,0 +1,38 @@
+/**
+ * @file test_helpers.h
+ * @brief Meshes shared by the unitest modules.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019 Pedro Henrique S. Perrusi
+ *
+ */
+#ifndef _BUNNY_MESH_TEST_HELPERS_
+#define _BUNNY_MESH_TEST_HELPERS_
+
+#include "bunny_mesh/data_io.h"
+
+namespace bunny_test
+{
+/**
+ * @brief Copies of the bunny shifted along x by a multiple of offset, sharing no vertex.
+ */
+inline void shiftedBunnies(int copies, double offset, bunny_dataIO::Point3DMatrixType &vertices,
+                           bunny_dataIO::IndexMatrixType &faces)
+{
+  const bunny_dataIO::IndexMatrixType bunnyFaces = bunny_dataIO::readIntNumPyArray("data/bunny_faces.npy");
+  const bunny_dataIO::Point3DMatrixType bunnyVertices = bunny_dataIO::readFloatNumPyArray("data/bunny_vertices.npy");
+
+  vertices.resize(copies * bunnyVertices.rows(), 3);
+  faces.resize(copies * bunnyFaces.rows(), 3);
+  for (int copy = 0; copy < copies; copy++)
+  {
+    vertices.middleRows(copy * bunnyVertices.rows(), bunnyVertices.rows()) =
+        bunnyVertices.rowwise() + bunny_dataIO::Point3DType(offset * copy, 0.0, 0.0);
+    faces.middleRows(copy * bunnyFaces.rows(), bunnyFaces.rows()) =
+        bunnyFaces.array() + copy * static_cast<int>(bunnyVertices.rows());
+  }
+}
+} // namespace bunny_test
+
+#endif // _BUNNY_MESH_TEST_HELPERS_